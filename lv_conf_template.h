@@ -89,6 +89,14 @@ typedef int16_t lv_coord_t;
 #  define LV_MEM_CUSTOM_FREE    free         /*Wrapper to free*/
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: Save the call site of every allocation to see which module owns the memory (see `lv_mem_trace_dump()`).
+ * The size of an allocation is limited to 16 MB. Not supported with `LV_ENABLE_GC`*/
+#define LV_MEM_TRACE       0
+#if LV_MEM_TRACE
+/* Max. number of separately traced call sites (<= 128)*/
+#  define LV_MEM_TRACE_SITE_MAX  64
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #define LV_ENABLE_GC 0
@@ -122,6 +130,16 @@ typedef int16_t lv_coord_t;
  * Time between `LV_EVENT_LONG_PRESSED_REPEAT */
 #define LV_INDEV_DEF_LONG_PRESS_REP_TIME  100
 
+/* Sort the clickable objects of the screens into a grid of N x N cells
+ * to find the pressed object faster on screens with a lot of objects.
+ * Moved and resized objects are updated in the index, other changes rebuild it on the next press. 0: disable*/
+#define LV_INDEV_HIT_INDEX_GRID           0
+
+/* Size of the sample queue of the input devices (power of 2). 0: disable
+ * The drivers can push timestamped samples with `lv_indev_push()` from interrupts or other threads
+ * instead of being polled by `read_cb`. Requires GCC compatible atomic builtins (`__atomic_...`)*/
+#define LV_INDEV_QUEUE_SIZE               0
+
 /*==================
  * Feature usage
  *==================*/
@@ -135,8 +153,30 @@ typedef void * lv_anim_user_data_t;
 
 #endif
 
+/* 1: Synchronize the animations with the refresh of the displays.
+ * The animations are stepped right before rendering to the time when the new frame is expected
+ * to be visible instead of in a separate task. It also enables `lv_disp_vsync()` to refresh
+ * the displays on vertical sync (see `vsync` in `lv_disp_drv_t`)*/
+#define LV_USE_FRAME_SYNC       0
+
 /* 1: Enable shadow drawing*/
 #define LV_USE_SHADOW           1
+#if LV_USE_SHADOW
+/* Number of pre-calculated shadow corners (radius, shadow width and opacity) to keep in the memory.
+ * Speeds up drawing the same shadows again. 0: disable the cache */
+#  define LV_SHADOW_CACHE_SIZE  4
+#endif
+
+/* Number of pre-calculated gradient color ramps (colors and length) to keep in the memory.
+ * Speeds up drawing the same gradients again. 0: calculate the colors on the fly */
+#define LV_GRAD_CACHE_SIZE      4
+
+/* 1: Dither the gradients to avoid visible color bands with 8 and 16 bit color depth*/
+#define LV_GRAD_DITHER          0
+
+/* 1: Draw arcs, triangles and polygons with an anti-aliased scanline rasterizer
+ * 0: Draw them from lines and pixels (smaller code) */
+#define LV_USE_DRAW_RASTER      0
 
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #define LV_USE_GROUP            1
@@ -144,6 +184,15 @@ typedef void * lv_anim_user_data_t;
 typedef void * lv_group_user_data_t;
 #endif  /*LV_USE_GROUP*/
 
+/* 1: Enable a thread safe command queue to update the objects from other threads (see lv_cmdq.h).
+ * The commands are executed at the beginning of `lv_task_handler()`.
+ * Requires GCC compatible atomic builtins (`__atomic_...`)*/
+#define LV_USE_CMDQ             0
+#if LV_USE_CMDQ
+#  define LV_CMDQ_SIZE          32  /*Number of commands in the queue (power of 2)*/
+#  define LV_CMDQ_DATA_SIZE     32  /*Max. text length + 1 and size of the chart points in a command [bytes]*/
+#endif
+
 /* 1: Enable GPU interface*/
 #define LV_USE_GPU              1
 
@@ -152,6 +201,18 @@ typedef void * lv_group_user_data_t;
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
 typedef void * lv_fs_drv_user_data_t;
+
+/* 1: Enable caching the reads of the files.
+ * Enable it for a driver with the `read_ahead` and `cache` fields of `lv_fs_drv_t`*/
+#define LV_USE_FS_CACHE         0
+#if LV_USE_FS_CACHE
+#define LV_FS_CACHE_BLOCK_SIZE  512     /*Size of the blocks in the shared cache [bytes]*/
+#define LV_FS_CACHE_BLOCK_CNT   16      /*Number of blocks in the shared cache*/
+#endif
+
+/* 1: Enable the driver of read-only files in the memory (e.g. in ROM or XIP flash).
+ * See `lv_fs_mem_drv_init()`. Its files can be mapped with `lv_fs_map()` without copying*/
+#define LV_USE_FS_MEM           0
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -196,6 +257,10 @@ typedef void * lv_img_decoder_user_data_t;
  * font's bitmaps */
 #define LV_ATTRIBUTE_LARGE_CONST
 
+/* Attribute to store a variable per thread. Required by `LV_USE_PARALLEL_REFR`.
+ * E.g. `__thread` or `_Thread_local` */
+#define LV_ATTRIBUTE_THREAD_LOCAL
+
 /* Export integer constant to binding.
  * This macro is used with constants in the form of LV_<CONST> that
  * should also appear on lvgl binding API such as Micropython
@@ -276,6 +341,22 @@ typedef void * lv_indev_drv_user_data_t;            /*Type of user data in the i
 
 #endif /*LV_USE_DEBUG*/
 
+/*====================
+ * Profiler settings
+ *===================*/
+
+/* 1: Measure the refresh time per object type, draw primitive and flushing (see `lv_prof.h`).
+ * Adds some overhead to every drawing. Register a microsecond clock with `lv_prof_set_time_cb()`*/
+#define LV_USE_PROF         0
+#if LV_USE_PROF
+/*Max. number of object types measured separately in a frame*/
+#define LV_PROF_TYPE_MAX    32
+#endif /*LV_USE_PROF*/
+
+/* 1: Enable a benchmark rendering reproducible scenes on an in-memory display (see `lv_bench.h`).
+ * Uses a static draw buffer of 1/10 screen size*/
+#define LV_USE_BENCH        0
+
 /*================
  *  THEME USAGE
  *================*/
@@ -400,6 +481,45 @@ typedef void * lv_obj_user_data_t;
 /*1: enable `lv_obj_realaign()` based on `lv_obj_align()` parameters*/
 #define LV_USE_OBJ_REALIGN          1
 
+/*1: Cache the style of the objects which inherit their style from a parent (+1 pointer per object)*/
+#define LV_USE_OBJ_STYLE_CACHE      0
+
+/*1: Index the objects by their style (+8 bytes per object).
+ * `lv_obj_report_style_mod(style)` will refresh only the users of `style` instead of searching all objects*/
+#define LV_USE_OBJ_STYLE_INDEX      0
+
+/*1: Store the children of the objects in arrays instead of linked lists.
+ * Makes walking the object tree faster and needs less memory per object*/
+#define LV_USE_OBJ_CHILD_ARRAY      0
+
+/*1: Enable `lv_obj_set_layer_cache()` to draw static objects and their children from a saved image*/
+#define LV_USE_OBJ_LAYER_CACHE      0
+
+/* Max. number of opaque objects collected in a refreshed area (occlusion culling).
+ * The objects (or their parts) covered by them are not drawn.
+ * 0: disable it (e.g. if a custom `design_cb` answers `LV_DESIGN_COVER_CHK` incorrectly)*/
+#define LV_REFR_OCCLUDER_MAX        8
+
+/*1: Scroll `lv_page`s by moving the already rendered pixels and redraw only the uncovered parts.
+ * Requires true double buffering or `copy_area_cb` in the display driver*/
+#define LV_USE_SCROLL_BLIT          0
+
+/*1: Enable `flush_batch_cb` in the display driver to flush the small areas of a refresh together.
+ * The areas are rendered next to each other into the display buffer while they fit*/
+#define LV_USE_FLUSH_BATCH          0
+
+/*1: Allow refreshing the displays in parallel, each from its own thread with `lv_refr_now(disp)`.
+ * The state of the rendering is stored per thread (see `LV_ATTRIBUTE_THREAD_LOCAL`).
+ * The objects can be only read while the displays are refreshed: hold a write lock
+ * around `lv_task_handler()` and a read lock around `lv_refr_now()`.
+ * Requires `LV_MEM_CUSTOM 1` with a thread safe allocator. Not supported with `LV_USE_PROF` and `LV_MEM_TRACE`.*/
+#define LV_USE_PARALLEL_REFR        0
+
+/*Lock and unlock the caches shared by the displays' refresh threads (images, shadows, gradients)
+ * E.g. take and give a mutex. Only used with `LV_USE_PARALLEL_REFR`*/
+#define LV_REFR_SHARED_LOCK()
+#define LV_REFR_SHARED_UNLOCK()
+
 /* Enable to make the object clickable on a larger area.
  * LV_EXT_CLICK_AREA_OFF or 0: Disable this feature
  * LV_EXT_CLICK_AREA_TINY: The extra area can be adjusted horizontally and vertically (0..255 px)
@@ -447,6 +567,12 @@ typedef void * lv_obj_user_data_t;
 
 /*Container (dependencies: -*/
 #define LV_USE_CONT     1
+#if LV_USE_CONT != 0
+/* 1: Refresh the layout and fit of the containers only once before the next screen refresh
+ * instead of on every change of their children. It makes adding a lot of children faster.
+ * Call `lv_cont_layout_flush()` to get the new coordinates immediately.*/
+#  define LV_CONT_DEFER_LAYOUT    0
+#endif
 
 /*Color picker (dependencies: -*/
 #define LV_USE_CPICKER   1
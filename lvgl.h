@@ -30,6 +30,9 @@ extern "C" {
 #include "src/lv_core/lv_refr.h"
 #include "src/lv_core/lv_disp.h"
 #include "src/lv_core/lv_debug.h"
+#include "src/lv_core/lv_prof.h"
+#include "src/lv_core/lv_bench.h"
+#include "src/lv_core/lv_cmdq.h"
 
 #include "src/lv_themes/lv_theme.h"
 
@@ -37,6 +40,7 @@ extern "C" {
 #include "src/lv_font/lv_font_fmt_txt.h"
 #include "src/lv_misc/lv_bidi.h"
 #include "src/lv_misc/lv_printf.h"
+#include "src/lv_misc/lv_fs_mem.h"
 
 #include "src/lv_objx/lv_btn.h"
 #include "src/lv_objx/lv_imgbtn.h"
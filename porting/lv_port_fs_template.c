@@ -51,6 +51,8 @@ static lv_fs_res_t fs_size (lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
 static lv_fs_res_t fs_tell (lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
 static lv_fs_res_t fs_remove (lv_fs_drv_t * drv, const char *path);
 static lv_fs_res_t fs_trunc (lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_map (lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
+static lv_fs_res_t fs_unmap (lv_fs_drv_t * drv, void * file_p, const void * buf);
 static lv_fs_res_t fs_rename (lv_fs_drv_t * drv, const char * oldname, const char * newname);
 static lv_fs_res_t fs_free (lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
 static lv_fs_res_t fs_dir_open (lv_fs_drv_t * drv, void * rddir_p, const char *path);
@@ -103,6 +105,10 @@ void lv_port_fs_init(void)
     fs_drv.rename_cb = fs_rename;
     fs_drv.trunc_cb = fs_trunc;
 
+    /*Optional: let the file content to be used without copying*/
+    fs_drv.map_cb = fs_map;
+    fs_drv.unmap_cb = fs_unmap;
+
     fs_drv.rddir_size = sizeof(dir_t);
     fs_drv.dir_close_cb = fs_dir_close;
     fs_drv.dir_open_cb = fs_dir_open;
@@ -291,6 +297,43 @@ static lv_fs_res_t fs_trunc (lv_fs_drv_t * drv, void * file_p)
     return res;
 }
 
+/**
+ * Give a pointer to the whole content of a file
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a file_t variable
+ * @param buf_p pointer to store the pointer to the content of the file
+ * @param size_p pointer to store the size of the file
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_map (lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p)
+{
+    lv_fs_res_t res = LV_FS_RES_NOT_IMP;
+
+    /* Add your code here*/
+    /* E.g. with a POSIX file system use `mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0)`.
+     * If the files are in an execute-in-place (XIP) flash simply give the address of the file
+     * or use the built-in driver of `lv_fs_mem_drv_init()` instead of this template (see `LV_USE_FS_MEM`).*/
+
+    return res;
+}
+
+/**
+ * Release the content of a file given by `fs_map`
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a file_t variable
+ * @param buf the pointer given by `fs_map`
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_unmap (lv_fs_drv_t * drv, void * file_p, const void * buf)
+{
+    lv_fs_res_t res = LV_FS_RES_NOT_IMP;
+
+    /* Add your code here*/
+    /* E.g. with a POSIX file system use `munmap()`. Nothing to do with an XIP flash.*/
+
+    return res;
+}
+
 /**
  * Rename a file
  * @param drv pointer to a driver where this function belongs
@@ -119,6 +119,18 @@
 #endif
 #endif     /*LV_MEM_CUSTOM*/
 
+/* 1: Save the call site of every allocation to see which module owns the memory (see `lv_mem_trace_dump()`).
+ * The size of an allocation is limited to 16 MB. Not supported with `LV_ENABLE_GC`*/
+#ifndef LV_MEM_TRACE
+#define LV_MEM_TRACE       0
+#endif
+#if LV_MEM_TRACE
+/* Max. number of separately traced call sites (<= 128)*/
+#ifndef LV_MEM_TRACE_SITE_MAX
+#  define LV_MEM_TRACE_SITE_MAX  64
+#endif
+#endif
+
 /* Garbage Collector settings
  * Used if lvgl is binded to higher level language and the memory is managed by that language */
 #ifndef LV_ENABLE_GC
@@ -170,6 +182,20 @@
 #define LV_INDEV_DEF_LONG_PRESS_REP_TIME  100
 #endif
 
+/* Sort the clickable objects of the screens into a grid of N x N cells
+ * to find the pressed object faster on screens with a lot of objects.
+ * Moved and resized objects are updated in the index, other changes rebuild it on the next press. 0: disable*/
+#ifndef LV_INDEV_HIT_INDEX_GRID
+#define LV_INDEV_HIT_INDEX_GRID           0
+#endif
+
+/* Size of the sample queue of the input devices (power of 2). 0: disable
+ * The drivers can push timestamped samples with `lv_indev_push()` from interrupts or other threads
+ * instead of being polled by `read_cb`. Requires GCC compatible atomic builtins (`__atomic_...`)*/
+#ifndef LV_INDEV_QUEUE_SIZE
+#define LV_INDEV_QUEUE_SIZE               0
+#endif
+
 /*==================
  * Feature usage
  *==================*/
@@ -184,10 +210,42 @@
 
 #endif
 
+/* 1: Synchronize the animations with the refresh of the displays.
+ * The animations are stepped right before rendering to the time when the new frame is expected
+ * to be visible instead of in a separate task. It also enables `lv_disp_vsync()` to refresh
+ * the displays on vertical sync (see `vsync` in `lv_disp_drv_t`)*/
+#ifndef LV_USE_FRAME_SYNC
+#define LV_USE_FRAME_SYNC       0
+#endif
+
 /* 1: Enable shadow drawing*/
 #ifndef LV_USE_SHADOW
 #define LV_USE_SHADOW           1
 #endif
+#if LV_USE_SHADOW
+/* Number of pre-calculated shadow corners (radius, shadow width and opacity) to keep in the memory.
+ * Speeds up drawing the same shadows again. 0: disable the cache */
+#ifndef LV_SHADOW_CACHE_SIZE
+#  define LV_SHADOW_CACHE_SIZE  4
+#endif
+#endif
+
+/* Number of pre-calculated gradient color ramps (colors and length) to keep in the memory.
+ * Speeds up drawing the same gradients again. 0: calculate the colors on the fly */
+#ifndef LV_GRAD_CACHE_SIZE
+#define LV_GRAD_CACHE_SIZE      4
+#endif
+
+/* 1: Dither the gradients to avoid visible color bands with 8 and 16 bit color depth*/
+#ifndef LV_GRAD_DITHER
+#define LV_GRAD_DITHER          0
+#endif
+
+/* 1: Draw arcs, triangles and polygons with an anti-aliased scanline rasterizer
+ * 0: Draw them from lines and pixels (smaller code) */
+#ifndef LV_USE_DRAW_RASTER
+#define LV_USE_DRAW_RASTER      0
+#endif
 
 /* 1: Enable object groups (for keyboard/encoder navigation) */
 #ifndef LV_USE_GROUP
@@ -196,6 +254,21 @@
 #if LV_USE_GROUP
 #endif  /*LV_USE_GROUP*/
 
+/* 1: Enable a thread safe command queue to update the objects from other threads (see lv_cmdq.h).
+ * The commands are executed at the beginning of `lv_task_handler()`.
+ * Requires GCC compatible atomic builtins (`__atomic_...`)*/
+#ifndef LV_USE_CMDQ
+#define LV_USE_CMDQ             0
+#endif
+#if LV_USE_CMDQ
+#ifndef LV_CMDQ_SIZE
+#  define LV_CMDQ_SIZE          32  /*Number of commands in the queue (power of 2)*/
+#endif
+#ifndef LV_CMDQ_DATA_SIZE
+#  define LV_CMDQ_DATA_SIZE     32  /*Max. text length + 1 and size of the chart points in a command [bytes]*/
+#endif
+#endif
+
 /* 1: Enable GPU interface*/
 #ifndef LV_USE_GPU
 #define LV_USE_GPU              1
@@ -207,6 +280,26 @@
 #endif
 #if LV_USE_FILESYSTEM
 /*Declare the type of the user data of file system drivers (can be e.g. `void *`, `int`, `struct`)*/
+
+/* 1: Enable caching the reads of the files.
+ * Enable it for a driver with the `read_ahead` and `cache` fields of `lv_fs_drv_t`*/
+#ifndef LV_USE_FS_CACHE
+#define LV_USE_FS_CACHE         0
+#endif
+#if LV_USE_FS_CACHE
+#ifndef LV_FS_CACHE_BLOCK_SIZE
+#define LV_FS_CACHE_BLOCK_SIZE  512     /*Size of the blocks in the shared cache [bytes]*/
+#endif
+#ifndef LV_FS_CACHE_BLOCK_CNT
+#define LV_FS_CACHE_BLOCK_CNT   16      /*Number of blocks in the shared cache*/
+#endif
+#endif
+
+/* 1: Enable the driver of read-only files in the memory (e.g. in ROM or XIP flash).
+ * See `lv_fs_mem_drv_init()`. Its files can be mapped with `lv_fs_map()` without copying*/
+#ifndef LV_USE_FS_MEM
+#define LV_USE_FS_MEM           0
+#endif
 #endif
 
 /*1: Add a `user_data` to drivers and objects*/
@@ -266,6 +359,12 @@
 #define LV_ATTRIBUTE_LARGE_CONST
 #endif
 
+/* Attribute to store a variable per thread. Required by `LV_USE_PARALLEL_REFR`.
+ * E.g. `__thread` or `_Thread_local` */
+#ifndef LV_ATTRIBUTE_THREAD_LOCAL
+#define LV_ATTRIBUTE_THREAD_LOCAL
+#endif
+
 /* Export integer constant to binding.
  * This macro is used with constants in the form of LV_<CONST> that
  * should also appear on lvgl binding API such as Micropython
@@ -370,6 +469,28 @@
 
 #endif /*LV_USE_DEBUG*/
 
+/*====================
+ * Profiler settings
+ *===================*/
+
+/* 1: Measure the refresh time per object type, draw primitive and flushing (see `lv_prof.h`).
+ * Adds some overhead to every drawing. Register a microsecond clock with `lv_prof_set_time_cb()`*/
+#ifndef LV_USE_PROF
+#define LV_USE_PROF         0
+#endif
+#if LV_USE_PROF
+/*Max. number of object types measured separately in a frame*/
+#ifndef LV_PROF_TYPE_MAX
+#define LV_PROF_TYPE_MAX    32
+#endif
+#endif /*LV_USE_PROF*/
+
+/* 1: Enable a benchmark rendering reproducible scenes on an in-memory display (see `lv_bench.h`).
+ * Uses a static draw buffer of 1/10 screen size*/
+#ifndef LV_USE_BENCH
+#define LV_USE_BENCH        0
+#endif
+
 /*================
  *  THEME USAGE
  *================*/
@@ -558,6 +679,65 @@
 #define LV_USE_OBJ_REALIGN          1
 #endif
 
+/*1: Cache the style of the objects which inherit their style from a parent (+1 pointer per object)*/
+#ifndef LV_USE_OBJ_STYLE_CACHE
+#define LV_USE_OBJ_STYLE_CACHE      0
+#endif
+
+/*1: Index the objects by their style (+8 bytes per object).
+ * `lv_obj_report_style_mod(style)` will refresh only the users of `style` instead of searching all objects*/
+#ifndef LV_USE_OBJ_STYLE_INDEX
+#define LV_USE_OBJ_STYLE_INDEX      0
+#endif
+
+/*1: Store the children of the objects in arrays instead of linked lists.
+ * Makes walking the object tree faster and needs less memory per object*/
+#ifndef LV_USE_OBJ_CHILD_ARRAY
+#define LV_USE_OBJ_CHILD_ARRAY      0
+#endif
+
+/*1: Enable `lv_obj_set_layer_cache()` to draw static objects and their children from a saved image*/
+#ifndef LV_USE_OBJ_LAYER_CACHE
+#define LV_USE_OBJ_LAYER_CACHE      0
+#endif
+
+/* Max. number of opaque objects collected in a refreshed area (occlusion culling).
+ * The objects (or their parts) covered by them are not drawn.
+ * 0: disable it (e.g. if a custom `design_cb` answers `LV_DESIGN_COVER_CHK` incorrectly)*/
+#ifndef LV_REFR_OCCLUDER_MAX
+#define LV_REFR_OCCLUDER_MAX        8
+#endif
+
+/*1: Scroll `lv_page`s by moving the already rendered pixels and redraw only the uncovered parts.
+ * Requires true double buffering or `copy_area_cb` in the display driver*/
+#ifndef LV_USE_SCROLL_BLIT
+#define LV_USE_SCROLL_BLIT          0
+#endif
+
+/*1: Enable `flush_batch_cb` in the display driver to flush the small areas of a refresh together.
+ * The areas are rendered next to each other into the display buffer while they fit*/
+#ifndef LV_USE_FLUSH_BATCH
+#define LV_USE_FLUSH_BATCH          0
+#endif
+
+/*1: Allow refreshing the displays in parallel, each from its own thread with `lv_refr_now(disp)`.
+ * The state of the rendering is stored per thread (see `LV_ATTRIBUTE_THREAD_LOCAL`).
+ * The objects can be only read while the displays are refreshed: hold a write lock
+ * around `lv_task_handler()` and a read lock around `lv_refr_now()`.
+ * Requires `LV_MEM_CUSTOM 1` with a thread safe allocator. Not supported with `LV_USE_PROF` and `LV_MEM_TRACE`.*/
+#ifndef LV_USE_PARALLEL_REFR
+#define LV_USE_PARALLEL_REFR        0
+#endif
+
+/*Lock and unlock the caches shared by the displays' refresh threads (images, shadows, gradients)
+ * E.g. take and give a mutex. Only used with `LV_USE_PARALLEL_REFR`*/
+#ifndef LV_REFR_SHARED_LOCK
+#define LV_REFR_SHARED_LOCK()
+#endif
+#ifndef LV_REFR_SHARED_UNLOCK
+#define LV_REFR_SHARED_UNLOCK()
+#endif
+
 /* Enable to make the object clickable on a larger area.
  * LV_EXT_CLICK_AREA_OFF or 0: Disable this feature
  * LV_EXT_CLICK_AREA_TINY: The extra area can be adjusted horizontally and vertically (0..255 px)
@@ -629,6 +809,14 @@
 #ifndef LV_USE_CONT
 #define LV_USE_CONT     1
 #endif
+#if LV_USE_CONT != 0
+/* 1: Refresh the layout and fit of the containers only once before the next screen refresh
+ * instead of on every change of their children. It makes adding a lot of children faster.
+ * Call `lv_cont_layout_flush()` to get the new coordinates immediately.*/
+#ifndef LV_CONT_DEFER_LAYOUT
+#  define LV_CONT_DEFER_LAYOUT    0
+#endif
+#endif
 
 /*Color picker (dependencies: -*/
 #ifndef LV_USE_CPICKER
@@ -0,0 +1,615 @@
+/**
+ * @file lv_bench.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_bench.h"
+#if LV_USE_BENCH
+
+#include <string.h>
+#include "lv_debug.h"
+#include "lv_disp.h"
+#include "lv_refr.h"
+#include "../lv_hal/lv_hal.h"
+#include "../lv_misc/lv_task.h"
+#include "../lv_misc/lv_anim.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_printf.h"
+#include "../lv_draw/lv_img_cache.h"
+#include "../lv_objx/lv_label.h"
+#include "../lv_objx/lv_img.h"
+#include "../lv_objx/lv_chart.h"
+#include "../lv_objx/lv_list.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_BENCH_BUF_SIZE (LV_HOR_RES_MAX * LV_VER_RES_MAX / 10)
+#define LV_BENCH_IMG_SIZE 32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Create the objects of a scene on `scr`*/
+typedef void (*lv_bench_create_cb_t)(lv_obj_t * scr, const void * param);
+
+/*Modify the scene before the `frame`th frame*/
+typedef void (*lv_bench_frame_cb_t)(lv_obj_t * scr, uint32_t frame);
+
+typedef struct
+{
+    const char * name;
+    lv_bench_create_cb_t create_cb;
+    lv_bench_frame_cb_t frame_cb; /*NULL if the scene changes by itself (e.g. animations)*/
+    const void * param;           /*Passed to `create_cb`*/
+} lv_bench_scene_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void bench_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
+static void bench_hash(const void * data, uint32_t size);
+static uint32_t bench_rand(void);
+static void frame_inv(lv_obj_t * scr, uint32_t frame);
+static void scene_fill_create(lv_obj_t * scr, const void * param);
+static void scene_rect_create(lv_obj_t * scr, const void * param);
+#if LV_USE_LABEL
+static void scene_text_create(lv_obj_t * scr, const void * param);
+#endif
+#if LV_USE_IMG
+static void scene_img_create(lv_obj_t * scr, const void * param);
+#endif
+#if LV_USE_CHART
+static void scene_chart_create(lv_obj_t * scr, const void * param);
+static void scene_chart_frame(lv_obj_t * scr, uint32_t frame);
+#endif
+#if LV_USE_LIST
+static void scene_list_create(lv_obj_t * scr, const void * param);
+static void scene_list_frame(lv_obj_t * scr, uint32_t frame);
+#endif
+#if LV_USE_ANIMATION
+static void scene_anim_create(lv_obj_t * scr, const void * param);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_bench_time_cb_t custom_time_cb;
+static lv_disp_t * bench_disp;
+static uint32_t flush_px;
+static uint32_t flush_hash;
+static uint32_t rand_seed;
+static lv_style_t style_scr;
+static lv_style_t style_rect;
+static lv_style_t style_text;
+#if LV_USE_IMG
+static lv_img_dsc_t * img_dsc;
+static const lv_img_cf_t img_cf_true_color    = LV_IMG_CF_TRUE_COLOR;
+static const lv_img_cf_t img_cf_alpha         = LV_IMG_CF_TRUE_COLOR_ALPHA;
+static const lv_img_cf_t img_cf_indexed       = LV_IMG_CF_INDEXED_4BIT;
+static const lv_img_cf_t img_cf_chroma_keyed  = LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED;
+#endif
+#if LV_USE_CHART
+static lv_chart_series_t * chart_ser[2];
+#endif
+
+static const bool fill_grad   = true;
+static const bool fill_plain  = false;
+static const bool rect_plain  = false;
+#if LV_USE_SHADOW
+static const bool rect_shadow = true;
+#endif
+
+static const lv_bench_scene_t scenes[] = {
+    {"fill", scene_fill_create, frame_inv, &fill_plain},
+    {"fill_gradient", scene_fill_create, frame_inv, &fill_grad},
+    {"rect_radius", scene_rect_create, frame_inv, &rect_plain},
+#if LV_USE_SHADOW
+    {"rect_shadow", scene_rect_create, frame_inv, &rect_shadow},
+#endif
+#if LV_USE_LABEL
+#if LV_FONT_ROBOTO_12
+    {"text_roboto_12", scene_text_create, frame_inv, &lv_font_roboto_12},
+#endif
+#if LV_FONT_ROBOTO_12_SUBPX
+    {"text_roboto_12_subpx", scene_text_create, frame_inv, &lv_font_roboto_12_subpx},
+#endif
+#if LV_FONT_ROBOTO_16
+    {"text_roboto_16", scene_text_create, frame_inv, &lv_font_roboto_16},
+#endif
+#if LV_FONT_ROBOTO_22
+    {"text_roboto_22", scene_text_create, frame_inv, &lv_font_roboto_22},
+#endif
+#if LV_FONT_ROBOTO_28
+    {"text_roboto_28", scene_text_create, frame_inv, &lv_font_roboto_28},
+#endif
+#if LV_FONT_ROBOTO_28_COMPRESSED
+    {"text_roboto_28_compressed", scene_text_create, frame_inv, &lv_font_roboto_28_compressed},
+#endif
+#if LV_FONT_UNSCII_8
+    {"text_unscii_8", scene_text_create, frame_inv, &lv_font_unscii_8},
+#endif
+#endif /*LV_USE_LABEL*/
+#if LV_USE_IMG
+    {"img_true_color", scene_img_create, frame_inv, &img_cf_true_color},
+    {"img_alpha", scene_img_create, frame_inv, &img_cf_alpha},
+    {"img_indexed", scene_img_create, frame_inv, &img_cf_indexed},
+    {"img_chroma_keyed", scene_img_create, frame_inv, &img_cf_chroma_keyed},
+#endif
+#if LV_USE_CHART
+    {"chart", scene_chart_create, scene_chart_frame, NULL},
+#endif
+#if LV_USE_LIST
+    {"list", scene_list_create, scene_list_frame, NULL},
+#endif
+#if LV_USE_ANIMATION
+    {"anim", scene_anim_create, NULL, NULL},
+#endif
+};
+
+static const char bench_txt[] = "Lorem ipsum dolor sit amet, consectetur adipiscing elit. Integer feugiat, "
+                                "nibh vel volutpat finibus, mi metus tempor nunc, sed 0123456789 vulputate "
+                                "enim ante a lectus. Donec ut nisl quis lorem (sodales) interdum? Aenean "
+                                "porta lacinia arcu, at bibendum ex dapibus #et. QUICK BROWN FOX JUMPS!";
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Set the clock to measure the rendering time. It's required as the benchmark
+ * increments the tick with `lv_tick_inc()` to get reproducible animations.
+ * @param time_cb a function returning the current time in microseconds
+ */
+void lv_bench_set_time_cb(lv_bench_time_cb_t time_cb)
+{
+    custom_time_cb = time_cb;
+}
+
+/**
+ * Get the in-memory display of the benchmark. It's registered on the first call.
+ * Its `flush_cb` only hashes the pixels.
+ * @return pointer to the display
+ */
+lv_disp_t * lv_bench_get_disp(void)
+{
+    if(bench_disp) return bench_disp;
+
+    static lv_color_t buf[LV_BENCH_BUF_SIZE];
+    static lv_disp_buf_t disp_buf;
+    static lv_disp_drv_t disp_drv;
+
+    lv_disp_buf_init(&disp_buf, buf, NULL, LV_BENCH_BUF_SIZE);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.buffer   = &disp_buf;
+    disp_drv.flush_cb = bench_flush;
+
+    /*Don't change the default display just because the benchmark's display is registered*/
+    lv_disp_t * def = lv_disp_get_default();
+    bench_disp      = lv_disp_drv_register(&disp_drv);
+    if(def) lv_disp_set_default(def);
+
+    return bench_disp;
+}
+
+/**
+ * Get the number of scenes
+ * @return the number of scenes
+ */
+uint16_t lv_bench_get_scene_cnt(void)
+{
+    return sizeof(scenes) / sizeof(scenes[0]);
+}
+
+/**
+ * Get the name of a scene
+ * @param id index of the scene [0..`lv_bench_get_scene_cnt()`-1]
+ * @return the name of the scene, e.g. "rect_shadow"
+ */
+const char * lv_bench_get_scene_name(uint16_t id)
+{
+    if(id >= lv_bench_get_scene_cnt()) return NULL;
+
+    return scenes[id].name;
+}
+
+/**
+ * Create a scene on the benchmark's display, render it in `frame_cnt` frames and delete it.
+ * The tick is incremented by `LV_DISP_DEF_REFR_PERIOD` before every frame
+ * and a frame is measured as one `lv_task_handler()` call.
+ * @param id index of the scene
+ * @param frame_cnt number of frames to render
+ * @param res store the result here
+ */
+void lv_bench_run_scene(uint16_t id, uint32_t frame_cnt, lv_bench_res_t * res)
+{
+    memset(res, 0, sizeof(lv_bench_res_t));
+    if(id >= lv_bench_get_scene_cnt()) return;
+
+    const lv_bench_scene_t * scene = &scenes[id];
+    res->name                      = scene->name;
+
+    if(custom_time_cb == NULL) {
+        LV_LOG_WARN("lv_bench_run_scene: no time_cb is set");
+        return;
+    }
+
+    lv_disp_t * disp = lv_bench_get_disp();
+    lv_disp_t * def  = lv_disp_get_default();
+    lv_disp_set_default(disp);
+
+    lv_mem_reset_max_used();
+
+    /*Create the scene on a new screen with a fixed style to not depend on the theme*/
+    lv_style_copy(&style_scr, &lv_style_plain);
+    lv_obj_t * scr_prev = lv_disp_get_scr_act(disp);
+    lv_obj_t * scr      = lv_obj_create(NULL, NULL);
+    lv_obj_set_style(scr, &style_scr);
+    rand_seed = 1;
+    scene->create_cb(scr, scene->param);
+    lv_disp_load_scr(scr);
+
+    /*Draw the first frame without measuring it*/
+    lv_refr_now(disp);
+
+    flush_px   = 0;
+    flush_hash = 2166136261U;
+
+    uint32_t i;
+    for(i = 0; i < frame_cnt; i++) {
+        if(scene->frame_cb) scene->frame_cb(scr, i);
+
+        lv_tick_inc(LV_DISP_DEF_REFR_PERIOD);
+        uint32_t start = custom_time_cb();
+        lv_task_handler();
+        res->time += custom_time_cb() - start;
+    }
+
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+
+    res->frame_cnt = frame_cnt;
+    res->px        = flush_px;
+    res->checksum  = flush_hash;
+    res->mem_max   = mon.max_used;
+
+    lv_disp_load_scr(scr_prev);
+    lv_obj_del(scr);
+    lv_refr_now(disp);
+
+#if LV_USE_IMG
+    if(img_dsc) {
+        lv_img_cache_invalidate_src(img_dsc);
+        lv_img_buf_free(img_dsc);
+        img_dsc = NULL;
+    }
+#endif
+
+    lv_disp_set_default(def);
+}
+
+/**
+ * Run all the scenes and report the results as JSON
+ * (name, frames, time, frames/s, ns per pixel, memory peak and checksum of every scene).
+ * @param frame_cnt number of frames to render in each scene
+ * @param write_cb called with the parts of the report
+ * @param user_data passed to `write_cb`
+ */
+void lv_bench_run(uint32_t frame_cnt, lv_bench_write_cb_t write_cb, void * user_data)
+{
+    char buf[256];
+
+    lv_snprintf(buf, sizeof(buf), "{\"hor_res\":%d,\"ver_res\":%d,\"color_depth\":%d,\"scenes\":[\n",
+                LV_HOR_RES_MAX, LV_VER_RES_MAX, LV_COLOR_DEPTH);
+    write_cb(buf, user_data);
+
+    uint16_t id;
+    for(id = 0; id < lv_bench_get_scene_cnt(); id++) {
+        lv_bench_res_t res;
+        lv_bench_run_scene(id, frame_cnt, &res);
+
+        uint32_t fps       = res.time ? (uint32_t)((uint64_t)res.frame_cnt * 1000000 / res.time) : 0;
+        uint32_t ps_per_px = res.px ? (uint32_t)((uint64_t)res.time * 1000000 / res.px) : 0;
+
+        lv_snprintf(buf, sizeof(buf),
+                    "%s{\"name\":\"%s\",\"frames\":%lu,\"time_us\":%lu,\"fps\":%lu,\"px\":%lu,\"ns_per_px\":%lu.%03lu,"
+                    "\"mem_max\":%lu,\"checksum\":\"%08lx\"}",
+                    id == 0 ? "" : ",\n", res.name, (unsigned long)res.frame_cnt, (unsigned long)res.time,
+                    (unsigned long)fps, (unsigned long)res.px, (unsigned long)(ps_per_px / 1000),
+                    (unsigned long)(ps_per_px % 1000), (unsigned long)res.mem_max,
+                    (unsigned long)res.checksum);
+        write_cb(buf, user_data);
+    }
+
+    write_cb("\n]}\n", user_data);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Flush callback of the in-memory display: count and hash the pixels
+ */
+static void bench_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    uint32_t size = lv_area_get_size(area);
+    flush_px += size;
+
+    bench_hash(area, sizeof(lv_area_t));
+    bench_hash(color_p, size * sizeof(lv_color_t));
+
+    lv_disp_flush_ready(disp_drv);
+}
+
+/**
+ * Add data to the checksum of the flushed pixels (FNV-1a)
+ * @param data pointer to the data
+ * @param size size of `data` in bytes
+ */
+static void bench_hash(const void * data, uint32_t size)
+{
+    const uint8_t * d = data;
+    uint32_t h        = flush_hash;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        h ^= d[i];
+        h *= 16777619U;
+    }
+    flush_hash = h;
+}
+
+/**
+ * A pseudo random number generator giving the same sequence in every scene
+ * @return a random number in [0..32767]
+ */
+static uint32_t bench_rand(void)
+{
+    rand_seed = rand_seed * 1103515245U + 12345U;
+    return (rand_seed >> 16) & 0x7FFF;
+}
+
+/**
+ * Redraw the whole screen in every frame
+ */
+static void frame_inv(lv_obj_t * scr, uint32_t frame)
+{
+    (void)frame; /*Unused*/
+
+    lv_obj_invalidate(scr);
+}
+
+/**
+ * Full screen fill
+ * @param param pointer to a `bool`: true: vertical gradient; false: one color
+ */
+static void scene_fill_create(lv_obj_t * scr, const void * param)
+{
+    const bool * grad = param;
+
+    style_scr.body.main_color = LV_COLOR_MAKE(0x20, 0x60, 0xA0);
+    style_scr.body.grad_color = *grad ? LV_COLOR_MAKE(0xE0, 0x90, 0x30) : style_scr.body.main_color;
+    lv_obj_refresh_style(scr);
+}
+
+/**
+ * 3x3 rounded rectangles with border (and shadow)
+ * @param param pointer to a `bool`: true: add shadow
+ */
+static void scene_rect_create(lv_obj_t * scr, const void * param)
+{
+    const bool * shadow = param;
+
+    lv_style_copy(&style_rect, &lv_style_plain);
+    style_rect.body.main_color   = LV_COLOR_MAKE(0x40, 0x90, 0xE0);
+    style_rect.body.grad_color   = LV_COLOR_MAKE(0x10, 0x40, 0x80);
+    style_rect.body.radius       = 12;
+    style_rect.body.border.width = 2;
+    style_rect.body.border.color = LV_COLOR_MAKE(0x10, 0x20, 0x40);
+    style_rect.body.border.opa   = LV_OPA_70;
+#if LV_USE_SHADOW
+    if(*shadow) {
+        style_rect.body.shadow.width = 12;
+        style_rect.body.shadow.color = LV_COLOR_MAKE(0x30, 0x30, 0x30);
+    }
+#else
+    (void)shadow; /*Unused*/
+#endif
+
+    lv_coord_t w = lv_obj_get_width(scr) / 3;
+    lv_coord_t h = lv_obj_get_height(scr) / 3;
+    uint8_t row;
+    uint8_t col;
+    for(row = 0; row < 3; row++) {
+        for(col = 0; col < 3; col++) {
+            lv_obj_t * obj = lv_obj_create(scr, NULL);
+            lv_obj_set_style(obj, &style_rect);
+            lv_obj_set_size(obj, w - 32, h - 32);
+            lv_obj_set_pos(obj, col * w + 16, row * h + 16);
+        }
+    }
+}
+
+#if LV_USE_LABEL
+/**
+ * Wrapped labels filling the screen
+ * @param param pointer to the font to use
+ */
+static void scene_text_create(lv_obj_t * scr, const void * param)
+{
+    lv_style_copy(&style_text, &lv_style_plain);
+    style_text.text.font  = param;
+    style_text.text.color = LV_COLOR_MAKE(0x20, 0x20, 0x20);
+
+    lv_coord_t y = 0;
+    while(y < lv_obj_get_height(scr)) {
+        lv_obj_t * label = lv_label_create(scr, NULL);
+        lv_label_set_style(label, LV_LABEL_STYLE_MAIN, &style_text);
+        lv_label_set_long_mode(label, LV_LABEL_LONG_BREAK);
+        lv_obj_set_width(label, lv_obj_get_width(scr) - 10);
+        lv_label_set_static_text(label, bench_txt);
+        lv_obj_set_pos(label, 5, y);
+        y += lv_obj_get_height(label);
+    }
+}
+#endif
+
+#if LV_USE_IMG
+/**
+ * A generated image tiled on the screen
+ * @param param pointer to the `lv_img_cf_t` of the image
+ */
+static void scene_img_create(lv_obj_t * scr, const void * param)
+{
+    lv_img_cf_t cf = *((const lv_img_cf_t *)param);
+
+    img_dsc = lv_img_buf_alloc(LV_BENCH_IMG_SIZE, LV_BENCH_IMG_SIZE, cf);
+    LV_ASSERT_MEM(img_dsc);
+    if(img_dsc == NULL) return;
+
+    if(cf == LV_IMG_CF_INDEXED_4BIT) {
+        uint8_t i;
+        for(i = 0; i < 16; i++) lv_img_buf_set_palette(img_dsc, i, lv_color_make(i * 16, 0xFF - i * 16, 0x80));
+    }
+
+    lv_coord_t x;
+    lv_coord_t y;
+    for(y = 0; y < LV_BENCH_IMG_SIZE; y++) {
+        for(x = 0; x < LV_BENCH_IMG_SIZE; x++) {
+            lv_color_t c;
+            if(cf == LV_IMG_CF_INDEXED_4BIT) {
+                c.full = (x + y) & 0xF;
+            } else if(cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED && ((x ^ y) & 0x8)) {
+                c = LV_COLOR_TRANSP;
+            } else {
+                c = lv_color_make(x * 8, y * 8, (x + y) * 4);
+            }
+            lv_img_buf_set_px_color(img_dsc, x, y, c);
+
+            if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) lv_img_buf_set_px_alpha(img_dsc, x, y, x * 8);
+        }
+    }
+
+    lv_obj_t * img = lv_img_create(scr, NULL);
+    lv_img_set_src(img, img_dsc);
+    lv_img_set_auto_size(img, false);
+    lv_obj_set_size(img, lv_obj_get_width(scr), lv_obj_get_height(scr));
+}
+#endif
+
+#if LV_USE_CHART
+/**
+ * A line chart with 2 series
+ */
+static void scene_chart_create(lv_obj_t * scr, const void * param)
+{
+    (void)param; /*Unused*/
+
+    lv_obj_t * chart = lv_chart_create(scr, NULL);
+    lv_obj_set_size(chart, lv_obj_get_width(scr), lv_obj_get_height(scr));
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    lv_chart_set_point_count(chart, 100);
+    lv_chart_set_div_line_count(chart, 3, 5);
+
+    chart_ser[0] = lv_chart_add_series(chart, LV_COLOR_RED);
+    chart_ser[1] = lv_chart_add_series(chart, LV_COLOR_BLUE);
+
+    uint16_t i;
+    for(i = 0; i < 100; i++) {
+        lv_chart_set_next(chart, chart_ser[0], bench_rand() % 100);
+        lv_chart_set_next(chart, chart_ser[1], bench_rand() % 100);
+    }
+}
+
+/**
+ * Shift new random points into the chart
+ */
+static void scene_chart_frame(lv_obj_t * scr, uint32_t frame)
+{
+    (void)frame; /*Unused*/
+
+    lv_obj_t * chart = lv_obj_get_child(scr, NULL);
+    lv_chart_set_next(chart, chart_ser[0], bench_rand() % 100);
+    lv_chart_set_next(chart, chart_ser[1], bench_rand() % 100);
+}
+#endif
+
+#if LV_USE_LIST
+/**
+ * A list with many buttons
+ */
+static void scene_list_create(lv_obj_t * scr, const void * param)
+{
+    (void)param; /*Unused*/
+
+    lv_obj_t * list = lv_list_create(scr, NULL);
+    lv_obj_set_size(list, lv_obj_get_width(scr), lv_obj_get_height(scr));
+
+    char txt[16];
+    uint16_t i;
+    for(i = 0; i < 40; i++) {
+        lv_snprintf(txt, sizeof(txt), "Item %d", i);
+        lv_list_add_btn(list, NULL, txt);
+    }
+}
+
+/**
+ * Scroll the list down and up
+ */
+static void scene_list_frame(lv_obj_t * scr, uint32_t frame)
+{
+    lv_obj_t * list = lv_obj_get_child(scr, NULL);
+    lv_obj_t * scrl = lv_page_get_scrl(list);
+
+    lv_coord_t max = lv_obj_get_height(scrl) - lv_obj_get_height(list);
+    if(max <= 0) return;
+
+    lv_coord_t pos = (frame * 8) % (2 * max);
+    if(pos > max) pos = 2 * max - pos;
+    lv_obj_set_y(scrl, -pos);
+}
+#endif
+
+#if LV_USE_ANIMATION
+/**
+ * Rectangles moving with different speed
+ */
+static void scene_anim_create(lv_obj_t * scr, const void * param)
+{
+    (void)param; /*Unused*/
+
+    lv_style_copy(&style_rect, &lv_style_plain);
+    style_rect.body.main_color = LV_COLOR_MAKE(0x40, 0x90, 0xE0);
+    style_rect.body.grad_color = LV_COLOR_MAKE(0x10, 0x40, 0x80);
+    style_rect.body.radius     = 8;
+
+    lv_coord_t h = lv_obj_get_height(scr) / 16;
+    uint8_t i;
+    for(i = 0; i < 16; i++) {
+        lv_obj_t * obj = lv_obj_create(scr, NULL);
+        lv_obj_set_style(obj, &style_rect);
+        lv_obj_set_size(obj, h * 2, h - 2);
+        lv_obj_set_y(obj, i * h);
+
+        lv_anim_t a;
+        lv_anim_init(&a);
+        lv_anim_set_exec_cb(&a, obj, (lv_anim_exec_xcb_t)lv_obj_set_x);
+        lv_anim_set_values(&a, 0, lv_obj_get_width(scr) - h * 2);
+        lv_anim_set_time(&a, 500 + i * 100, 0);
+        lv_anim_set_playback(&a, 0);
+        lv_anim_set_repeat(&a, 0);
+        lv_anim_create(&a);
+    }
+}
+#endif
+
+#endif /*LV_USE_BENCH*/
@@ -0,0 +1,105 @@
+/**
+ * @file lv_bench.h
+ * Render reproducible scenes on an in-memory display and measure them
+ */
+
+#ifndef LV_BENCH_H
+#define LV_BENCH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+#if LV_USE_BENCH
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Result of a scene*/
+typedef struct
+{
+    const char * name;  /**< Name of the scene*/
+    uint32_t frame_cnt; /**< Number of rendered frames*/
+    uint32_t time;      /**< Time of rendering the frames [us]*/
+    uint32_t px;        /**< Number of flushed pixels*/
+    uint32_t mem_max;   /**< Memory peak while the scene was created and rendered [byte]*/
+    uint32_t checksum;  /**< Hash of the flushed pixels. Changes only if the rendering changes.*/
+} lv_bench_res_t;
+
+/** Get the current time in microseconds*/
+typedef uint32_t (*lv_bench_time_cb_t)(void);
+
+/** Write a part of the report*/
+typedef void (*lv_bench_write_cb_t)(const char * txt, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the clock to measure the rendering time. It's required as the benchmark
+ * increments the tick with `lv_tick_inc()` to get reproducible animations.
+ * @param time_cb a function returning the current time in microseconds
+ */
+void lv_bench_set_time_cb(lv_bench_time_cb_t time_cb);
+
+/**
+ * Get the in-memory display of the benchmark. It's registered on the first call.
+ * Its `flush_cb` only hashes the pixels.
+ * @return pointer to the display
+ */
+lv_disp_t * lv_bench_get_disp(void);
+
+/**
+ * Get the number of scenes
+ * @return the number of scenes
+ */
+uint16_t lv_bench_get_scene_cnt(void);
+
+/**
+ * Get the name of a scene
+ * @param id index of the scene [0..`lv_bench_get_scene_cnt()`-1]
+ * @return the name of the scene, e.g. "rect_shadow"
+ */
+const char * lv_bench_get_scene_name(uint16_t id);
+
+/**
+ * Create a scene on the benchmark's display, render it in `frame_cnt` frames and delete it.
+ * The tick is incremented by `LV_DISP_DEF_REFR_PERIOD` before every frame
+ * and a frame is measured as one `lv_task_handler()` call.
+ * @param id index of the scene
+ * @param frame_cnt number of frames to render
+ * @param res store the result here
+ */
+void lv_bench_run_scene(uint16_t id, uint32_t frame_cnt, lv_bench_res_t * res);
+
+/**
+ * Run all the scenes and report the results as JSON
+ * (name, frames, time, frames/s, ns per pixel, memory peak and checksum of every scene).
+ * @param frame_cnt number of frames to render in each scene
+ * @param write_cb called with the parts of the report
+ * @param user_data passed to `write_cb`
+ */
+void lv_bench_run(uint32_t frame_cnt, lv_bench_write_cb_t write_cb, void * user_data);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_BENCH*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_BENCH_H*/
@@ -0,0 +1,376 @@
+/**
+ * @file lv_cmdq.c
+ * Thread safe queue of commands to update the objects from other threads.
+ * It's a bounded lock-free queue: the producers reserve a slot with compare-and-swap
+ * and mark it ready with a sequence number, the only consumer is `lv_task_handler()`.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cmdq.h"
+#if LV_USE_CMDQ
+
+#include <string.h>
+#include "../lv_misc/lv_math.h"
+#include "../lv_objx/lv_label.h"
+#include "../lv_objx/lv_bar.h"
+#include "../lv_objx/lv_lmeter.h"
+#include "../lv_objx/lv_gauge.h"
+#include "../lv_objx/lv_spinbox.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if !defined(__GNUC__)
+#error "LV_USE_CMDQ requires GCC compatible atomic builtins"
+#endif
+
+#if (LV_CMDQ_SIZE & (LV_CMDQ_SIZE - 1)) != 0
+#error "LV_CMDQ_SIZE should be a power of 2"
+#endif
+
+#define CMDQ_MASK (LV_CMDQ_SIZE - 1)
+#define CMDQ_POINT_MAX (LV_CMDQ_DATA_SIZE / sizeof(lv_coord_t))
+
+#define CMDQ_LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define CMDQ_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#define CMDQ_CAS(p, exp_p, v) __atomic_compare_exchange_n(p, exp_p, v, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    CMDQ_TYPE_NONE, /*Dropped command*/
+    CMDQ_TYPE_VALUE,
+    CMDQ_TYPE_TEXT,
+    CMDQ_TYPE_CHART,
+    CMDQ_TYPE_CALL,
+};
+typedef uint8_t cmdq_type_t;
+
+typedef struct
+{
+    cmdq_type_t type;
+    uint8_t cnt; /*Number of chart points*/
+    lv_obj_t * obj;
+    union
+    {
+        int32_t value;
+        void * ser;
+        lv_async_cb_t cb;
+    } param;
+    void * user_data;
+    union
+    {
+        char text[LV_CMDQ_DATA_SIZE];
+        lv_coord_t points[CMDQ_POINT_MAX];
+    } data;
+} cmdq_cmd_t;
+
+typedef struct
+{
+    uint32_t seq; /*`pos`: free for the producer at `pos`; `pos + 1`: ready for the consumer*/
+    cmdq_cmd_t cmd;
+} cmdq_slot_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static cmdq_cmd_t * cmdq_claim(uint32_t * pos);
+static void cmdq_commit(uint32_t pos);
+static bool cmdq_is_replaced(const cmdq_cmd_t * cmd, uint32_t from, uint32_t end);
+static void cmdq_exec(cmdq_cmd_t * cmd);
+static void cmdq_exec_value(lv_obj_t * obj, int32_t value);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static cmdq_slot_t slots[LV_CMDQ_SIZE];
+static uint32_t enq_pos; /*Position of the next command to write. Shared by the producers.*/
+static uint32_t deq_pos; /*Position of the next command to execute. Used only by `lv_task_handler()`.*/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the command queue. Called by `lv_init()`.
+ */
+void lv_cmdq_init(void)
+{
+    uint32_t i;
+    for(i = 0; i < LV_CMDQ_SIZE; i++) {
+        slots[i].seq = i;
+    }
+
+    enq_pos = 0;
+    deq_pos = 0;
+}
+
+/**
+ * Execute the commands sent until now. Called at the beginning of `lv_task_handler()`.
+ * Only the last one of the `lv_cmdq_set_value()` and `lv_cmdq_set_text()` commands
+ * sent to the same object is executed.
+ */
+void lv_cmdq_handler(void)
+{
+    /*Find the commands which are completely written. The ones sent from now wait for the next call.*/
+    uint32_t end = deq_pos;
+    while(end - deq_pos < LV_CMDQ_SIZE && CMDQ_LOAD(&slots[end & CMDQ_MASK].seq) == end + 1) {
+        end++;
+    }
+
+    while(deq_pos != end) {
+        cmdq_slot_t * slot = &slots[deq_pos & CMDQ_MASK];
+
+        if(cmdq_is_replaced(&slot->cmd, deq_pos + 1, end) == false) cmdq_exec(&slot->cmd);
+
+        /*Give the slot back to the producers for the next round*/
+        CMDQ_STORE(&slot->seq, deq_pos + LV_CMDQ_SIZE);
+        deq_pos++;
+    }
+}
+
+/**
+ * Set the value of a bar, slider, line meter, gauge (first needle) or spinbox from any thread.
+ * @param obj pointer to an object
+ * @param value the new value
+ * @return true: the command is queued; false: the queue is full
+ */
+bool lv_cmdq_set_value(lv_obj_t * obj, int32_t value)
+{
+    uint32_t pos;
+    cmdq_cmd_t * cmd = cmdq_claim(&pos);
+    if(cmd == NULL) return false;
+
+    cmd->type        = CMDQ_TYPE_VALUE;
+    cmd->obj         = obj;
+    cmd->param.value = value;
+    cmdq_commit(pos);
+
+    return true;
+}
+
+/**
+ * Set the text of a label from any thread.
+ * @param label pointer to a label
+ * @param text the new text. It's copied so it can be freed after the call.
+ * @return true: the command is queued; false: the queue is full or the text is longer than
+ *         `LV_CMDQ_DATA_SIZE - 1` bytes
+ */
+bool lv_cmdq_set_text(lv_obj_t * label, const char * text)
+{
+    size_t len = strlen(text);
+    if(len >= LV_CMDQ_DATA_SIZE) return false;
+
+    uint32_t pos;
+    cmdq_cmd_t * cmd = cmdq_claim(&pos);
+    if(cmd == NULL) return false;
+
+    cmd->type = CMDQ_TYPE_TEXT;
+    cmd->obj  = label;
+    memcpy(cmd->data.text, text, len + 1);
+    cmdq_commit(pos);
+
+    return true;
+}
+
+#if LV_USE_CHART
+/**
+ * Add points to a data series of a chart from any thread. (Like `lv_chart_set_next_array()`)
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y_array the new values. They are copied so the array can be freed after the call.
+ * @param cnt number of values in `y_array`
+ * @return true: the command is queued; false: the queue is full (maybe some of the points are queued)
+ */
+bool lv_cmdq_chart_add(lv_obj_t * chart, lv_chart_series_t * ser, const lv_coord_t y_array[], uint32_t cnt)
+{
+    /*Send the points in as many commands as required*/
+    while(cnt > 0) {
+        uint32_t pos;
+        cmdq_cmd_t * cmd = cmdq_claim(&pos);
+        if(cmd == NULL) return false;
+
+        uint32_t part_cnt = LV_MATH_MIN(cnt, CMDQ_POINT_MAX);
+        cmd->type         = CMDQ_TYPE_CHART;
+        cmd->obj          = chart;
+        cmd->param.ser    = ser;
+        cmd->cnt          = part_cnt;
+        memcpy(cmd->data.points, y_array, part_cnt * sizeof(lv_coord_t));
+        cmdq_commit(pos);
+
+        y_array += part_cnt;
+        cnt -= part_cnt;
+    }
+
+    return true;
+}
+#endif
+
+/**
+ * Call a function from `lv_task_handler()`. Unlike `lv_async_call()` it can be used from any thread.
+ * @param async_xcb a callback which is the task itself
+ * @param user_data custom parameter
+ * @return true: the command is queued; false: the queue is full
+ */
+bool lv_cmdq_call(lv_async_cb_t async_xcb, void * user_data)
+{
+    uint32_t pos;
+    cmdq_cmd_t * cmd = cmdq_claim(&pos);
+    if(cmd == NULL) return false;
+
+    cmd->type      = CMDQ_TYPE_CALL;
+    cmd->obj       = NULL;
+    cmd->param.cb  = async_xcb;
+    cmd->user_data = user_data;
+    cmdq_commit(pos);
+
+    return true;
+}
+
+/**
+ * Drop the queued commands of an object. Called when the object is deleted.
+ * (The other threads shouldn't send commands to an object which can be deleted.)
+ * @param obj pointer to an object
+ */
+void lv_cmdq_remove_obj(const lv_obj_t * obj)
+{
+    uint32_t pos;
+    for(pos = deq_pos; pos - deq_pos < LV_CMDQ_SIZE; pos++) {
+        cmdq_slot_t * slot = &slots[pos & CMDQ_MASK];
+        if(CMDQ_LOAD(&slot->seq) != pos + 1) break;
+
+        if(slot->cmd.obj == obj) slot->cmd.type = CMDQ_TYPE_NONE;
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Reserve the next free slot for a producer
+ * @param pos the position of the slot is stored here. Pass it to `cmdq_commit()`.
+ * @return pointer to the command of the slot or NULL if the queue is full
+ */
+static cmdq_cmd_t * cmdq_claim(uint32_t * pos)
+{
+    uint32_t p = __atomic_load_n(&enq_pos, __ATOMIC_RELAXED);
+    while(1) {
+        cmdq_slot_t * slot = &slots[p & CMDQ_MASK];
+        int32_t diff       = (int32_t)(CMDQ_LOAD(&slot->seq) - p);
+
+        if(diff == 0) {
+            /*The slot is free. Take it if an other producer didn't take it in the meantime.
+             *On failure `p` is updated to the current position.*/
+            if(CMDQ_CAS(&enq_pos, &p, p + 1)) {
+                *pos = p;
+                return &slot->cmd;
+            }
+        } else if(diff < 0) {
+            /*The consumer hasn't executed the command of the previous round yet*/
+            return NULL;
+        } else {
+            /*An other producer has taken the slot*/
+            p = __atomic_load_n(&enq_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * Mark a claimed slot ready for the consumer
+ * @param pos position of the slot returned by `cmdq_claim()`
+ */
+static void cmdq_commit(uint32_t pos)
+{
+    CMDQ_STORE(&slots[pos & CMDQ_MASK].seq, pos + 1);
+}
+
+/**
+ * Check whether a command is made useless by a later command
+ * @param cmd pointer to a command
+ * @param from position of the first command after `cmd`
+ * @param end position after the last command to check
+ * @return true: an other command of the same type sets the same object later
+ */
+static bool cmdq_is_replaced(const cmdq_cmd_t * cmd, uint32_t from, uint32_t end)
+{
+    if(cmd->type != CMDQ_TYPE_VALUE && cmd->type != CMDQ_TYPE_TEXT) return false;
+
+    uint32_t pos;
+    for(pos = from; pos != end; pos++) {
+        const cmdq_cmd_t * next = &slots[pos & CMDQ_MASK].cmd;
+        if(next->type == cmd->type && next->obj == cmd->obj) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Execute a command
+ * @param cmd pointer to a command
+ */
+static void cmdq_exec(cmdq_cmd_t * cmd)
+{
+    switch(cmd->type) {
+        case CMDQ_TYPE_VALUE: cmdq_exec_value(cmd->obj, cmd->param.value); break;
+#if LV_USE_LABEL
+        case CMDQ_TYPE_TEXT: lv_label_set_text(cmd->obj, cmd->data.text); break;
+#endif
+#if LV_USE_CHART
+        case CMDQ_TYPE_CHART: lv_chart_set_next_array(cmd->obj, cmd->param.ser, cmd->data.points, cmd->cnt); break;
+#endif
+        case CMDQ_TYPE_CALL: cmd->param.cb(cmd->user_data); break;
+        default: break;
+    }
+}
+
+/**
+ * Set the value of an object with the setter function of its type
+ * @param obj pointer to a bar, slider, line meter, gauge or spinbox
+ * @param value the new value
+ */
+static void cmdq_exec_value(lv_obj_t * obj, int32_t value)
+{
+    lv_obj_type_t types;
+    lv_obj_get_type(obj, &types);
+
+    /*Find the most derived known type (e.g. the gauge before the line meter)*/
+    uint8_t i;
+    for(i = 0; i < LV_MAX_ANCESTOR_NUM && types.type[i] != NULL; i++) {
+#if LV_USE_SPINBOX
+        if(strcmp(types.type[i], "lv_spinbox") == 0) {
+            lv_spinbox_set_value(obj, value);
+            return;
+        }
+#endif
+#if LV_USE_GAUGE
+        if(strcmp(types.type[i], "lv_gauge") == 0) {
+            lv_gauge_set_value(obj, 0, value);
+            return;
+        }
+#endif
+#if LV_USE_LMETER
+        if(strcmp(types.type[i], "lv_lmeter") == 0) {
+            lv_lmeter_set_value(obj, value);
+            return;
+        }
+#endif
+#if LV_USE_BAR
+        if(strcmp(types.type[i], "lv_bar") == 0) {
+            lv_bar_set_value(obj, value, LV_ANIM_OFF);
+            return;
+        }
+#endif
+    }
+
+    LV_LOG_WARN("lv_cmdq_set_value: the object has no value");
+}
+
+#endif /*LV_USE_CMDQ*/
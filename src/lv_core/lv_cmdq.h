@@ -0,0 +1,103 @@
+/**
+ * @file lv_cmdq.h
+ * Thread safe queue of commands to update the objects from other threads
+ */
+
+#ifndef LV_CMDQ_H
+#define LV_CMDQ_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+#include "../lv_misc/lv_async.h"
+
+#if LV_USE_CMDQ
+
+#if LV_USE_CHART
+#include "../lv_objx/lv_chart.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the command queue. Called by `lv_init()`.
+ */
+void lv_cmdq_init(void);
+
+/**
+ * Execute the commands sent until now. Called at the beginning of `lv_task_handler()`.
+ * Only the last one of the `lv_cmdq_set_value()` and `lv_cmdq_set_text()` commands
+ * sent to the same object is executed.
+ */
+void lv_cmdq_handler(void);
+
+/**
+ * Set the value of a bar, slider, line meter, gauge (first needle) or spinbox from any thread.
+ * @param obj pointer to an object
+ * @param value the new value
+ * @return true: the command is queued; false: the queue is full
+ */
+bool lv_cmdq_set_value(lv_obj_t * obj, int32_t value);
+
+/**
+ * Set the text of a label from any thread.
+ * @param label pointer to a label
+ * @param text the new text. It's copied so it can be freed after the call.
+ * @return true: the command is queued; false: the queue is full or the text is longer than
+ *         `LV_CMDQ_DATA_SIZE - 1` bytes
+ */
+bool lv_cmdq_set_text(lv_obj_t * label, const char * text);
+
+#if LV_USE_CHART
+/**
+ * Add points to a data series of a chart from any thread. (Like `lv_chart_set_next_array()`)
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y_array the new values. They are copied so the array can be freed after the call.
+ * @param cnt number of values in `y_array`
+ * @return true: the command is queued; false: the queue is full (maybe some of the points are queued)
+ */
+bool lv_cmdq_chart_add(lv_obj_t * chart, lv_chart_series_t * ser, const lv_coord_t y_array[], uint32_t cnt);
+#endif
+
+/**
+ * Call a function from `lv_task_handler()`. Unlike `lv_async_call()` it can be used from any thread.
+ * @param async_xcb a callback which is the task itself
+ * @param user_data custom parameter
+ * @return true: the command is queued; false: the queue is full
+ */
+bool lv_cmdq_call(lv_async_cb_t async_xcb, void * user_data);
+
+/**
+ * Drop the queued commands of an object. Called when the object is deleted.
+ * (The other threads shouldn't send commands to an object which can be deleted.)
+ * @param obj pointer to an object
+ */
+void lv_cmdq_remove_obj(const lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_CMDQ*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_CMDQ_H*/
@@ -5,6 +5,9 @@ CSRCS += lv_obj.c
 CSRCS += lv_refr.c
 CSRCS += lv_style.c
 CSRCS += lv_debug.c
+CSRCS += lv_prof.c
+CSRCS += lv_bench.c
+CSRCS += lv_cmdq.c
 
 DEPPATH += --dep-path $(LVGL_DIR)/lvgl/src/lv_core
 VPATH += :$(LVGL_DIR)/lvgl/src/lv_core
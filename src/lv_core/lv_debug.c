@@ -178,7 +178,7 @@ static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_fin
 {
     /*Check all children of `parent`*/
     lv_obj_t * child;
-    LV_LL_READ(parent->child_ll, child) {
+    LV_OBJ_CHILD_READ(parent, child) {
         if(child == obj_to_find) return true;
 
         /*Check the children*/
@@ -242,6 +242,7 @@ void lv_group_focus_obj(lv_obj_t * obj)
             }
 
             g->obj_focus = i;
+            lv_obj_clean_style_cache(obj); /*The children might inherit the focused style*/
 
             if(g->obj_focus != NULL) {
                 (*g->obj_focus)->signal_cb(*g->obj_focus, LV_SIGNAL_FOCUS, NULL);
@@ -676,6 +677,7 @@ static void focus_next_core(lv_group_t * group, void * (*begin)(const lv_ll_t *)
     }
 
     group->obj_focus = obj_next;
+    lv_obj_clean_style_cache(*group->obj_focus); /*The children might inherit the focused style*/
 
     (*group->obj_focus)->signal_cb(*group->obj_focus, LV_SIGNAL_FOCUS, NULL);
     lv_res_t res = lv_event_send(*group->obj_focus, LV_EVENT_FOCUSED, NULL);
@@ -15,6 +15,12 @@
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_gc.h"
+#include <string.h>
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -24,9 +30,47 @@
 #warning "LV_INDEV_DRAG_THROW must be greater than 0"
 #endif
 
+#if LV_INDEV_HIT_INDEX_GRID > 0
+#define HIT_INDEX_SLOT_CNT 3 /*Enough for the system layer, top layer and active screen of a display*/
+#define HIT_INDEX_CELL_CNT (LV_INDEV_HIT_INDEX_GRID * LV_INDEV_HIT_INDEX_GRID)
+#define HIT_INDEX_NONE 0xFFFF /*End of the lists of items*/
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_INDEV_HIT_INDEX_GRID > 0
+typedef struct
+{
+    lv_obj_t * obj;
+    lv_area_t area;        /*Clickable area of `obj` truncated by the clickable area of its parents*/
+    uint8_t on : 1;        /*1: `area` is valid; 0: `obj` is out of its parents*/
+    uint8_t in_cells : 1;  /*1: added to the cells of `area`*/
+} lv_indev_hit_entry_t;
+
+/*An entry on a cell of the grid*/
+typedef struct
+{
+    uint16_t entry; /*Index of the entry*/
+    uint16_t next;  /*The next item on the same cell or `HIT_INDEX_NONE`*/
+} lv_indev_hit_item_t;
+
+/*Clickable objects of a screen (or layer) sorted into the cells of a grid*/
+typedef struct
+{
+    lv_obj_t * root;
+    uint32_t gen;      /*Value of `hit_index_gen` when the index was built*/
+    uint32_t last_use; /*To find the least recently used index*/
+    lv_area_t area;    /*Clickable area of `root`. It's divided into the cells*/
+    lv_coord_t cell_w;
+    lv_coord_t cell_h;
+    lv_indev_hit_entry_t * entries; /*Not hidden objects in the order they are searched (top most first)*/
+    uint16_t entry_cnt;
+    lv_indev_hit_item_t * items;    /*The lists of the cells. The unused items are in a list too.*/
+    uint16_t item_free;             /*First unused item*/
+    uint16_t cell_head[HIT_INDEX_CELL_CNT]; /*First item of each cell. The items are ordered like `entries`*/
+} lv_indev_hit_index_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -40,15 +84,34 @@ static void indev_proc_press(lv_indev_proc_t * proc);
 static void indev_proc_release(lv_indev_proc_t * proc);
 static void indev_proc_reset_query_handler(lv_indev_t * indev);
 static lv_obj_t * indev_search_obj(const lv_indev_proc_t * proc, lv_obj_t * obj);
+static void indev_get_click_area(const lv_obj_t * obj, lv_area_t * area);
+#if LV_INDEV_HIT_INDEX_GRID > 0
+static lv_indev_hit_index_t * hit_index_get(lv_obj_t * root);
+static bool hit_index_build(lv_indev_hit_index_t * index, lv_obj_t * root);
+static uint32_t hit_index_count(const lv_obj_t * obj);
+static bool hit_index_set(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * par_area, uint16_t * e,
+                          bool check);
+static void hit_index_get_cells(const lv_indev_hit_index_t * index, const lv_area_t * area_p, lv_area_t * cells_p);
+static bool hit_index_cells_add(lv_indev_hit_index_t * index, uint16_t e);
+static void hit_index_cells_rem(lv_indev_hit_index_t * index, uint16_t e);
+static bool hit_index_items_grow(lv_indev_hit_index_t * index);
+static lv_obj_t * hit_index_search(const lv_indev_hit_index_t * index, const lv_point_t * point);
+#endif
 static void indev_drag(lv_indev_proc_t * state);
 static void indev_drag_throw(lv_indev_proc_t * proc);
 static bool indev_reset_check(lv_indev_proc_t * proc);
+static uint32_t indev_elaps(uint32_t prev_tick);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static lv_indev_t * indev_act;
 static lv_obj_t * indev_obj_act = NULL;
+static uint32_t indev_time; /*Time of the processed sample*/
+#if LV_INDEV_HIT_INDEX_GRID > 0
+static uint32_t hit_index_gen;
+static uint32_t hit_index_stamp;
+#endif
 
 /**********************
  *      MACROS
@@ -94,13 +157,19 @@ void lv_indev_read_task(lv_task_t * task)
         indev_proc_reset_query_handler(indev_act);
         indev_obj_act = NULL;
 
+#if LV_INDEV_QUEUE_SIZE > 0
+        indev_time = data.timestamp ? data.timestamp : lv_tick_get();
+#else
+        indev_time = lv_tick_get();
+#endif
+
         indev_act->proc.state = data.state;
 
         /*Save the last activity time*/
         if(indev_act->proc.state == LV_INDEV_STATE_PR) {
-            indev_act->driver.disp->last_activity_time = lv_tick_get();
+            indev_act->driver.disp->last_activity_time = indev_time;
         } else if(indev_act->driver.type == LV_INDEV_TYPE_ENCODER && data.enc_diff) {
-            indev_act->driver.disp->last_activity_time = lv_tick_get();
+            indev_act->driver.disp->last_activity_time = indev_time;
         }
 
         if(indev_act->driver.type == LV_INDEV_TYPE_POINTER) {
@@ -325,6 +394,104 @@ lv_obj_t * lv_indev_get_obj_act(void)
     return indev_obj_act;
 }
 
+/**
+ * Mark the index of the clickable objects outdated (see `LV_INDEV_HIT_INDEX_GRID`).
+ * Called by the object library when an object is created, deleted, hidden, reordered, moved to an other parent
+ * or its clickability is changed.
+ */
+void lv_indev_invalidate_hit_index(void)
+{
+#if LV_INDEV_HIT_INDEX_GRID > 0
+    hit_index_gen++;
+#endif
+}
+
+/**
+ * Update the clickable area of an object and its children in the index of its screen
+ * (see `LV_INDEV_HIT_INDEX_GRID`). Called by the object library when an object is moved or resized
+ * or its extended click area is changed.
+ * @param obj pointer to an object
+ */
+void lv_indev_update_hit_index(lv_obj_t * obj)
+{
+#if LV_INDEV_HIT_INDEX_GRID > 0
+    if(LV_GC_ROOT(_lv_indev_hit_index) == NULL) return;
+
+    /*The cells of a screen depend on its size*/
+    lv_obj_t * par = lv_obj_get_parent(obj);
+    if(par == NULL) {
+        lv_indev_invalidate_hit_index();
+        return;
+    }
+
+    /*Nothing to do if the screen has no index (it will be built when needed)*/
+    lv_obj_t * scr                = lv_obj_get_screen(obj);
+    lv_indev_hit_index_t * index  = NULL;
+    lv_indev_hit_index_t * slots = LV_GC_ROOT(_lv_indev_hit_index);
+    uint8_t s;
+    for(s = 0; s < HIT_INDEX_SLOT_CNT; s++) {
+        if(slots[s].root == scr && slots[s].gen == hit_index_gen) {
+            index = &slots[s];
+            break;
+        }
+    }
+    if(index == NULL) return;
+
+    /*Find the entry of the object. Hidden objects (and their children) have no entry.*/
+    uint16_t last;
+    for(last = 0; last < index->entry_cnt; last++) {
+        if(index->entries[last].obj == obj) break;
+    }
+    if(last == index->entry_cnt) return;
+
+    /*The children are right before their parent*/
+    uint32_t cnt = hit_index_count(obj);
+    if(cnt > (uint32_t)last + 1) {
+        index->root = NULL;
+        return;
+    }
+    uint16_t first = last + 1 - cnt;
+
+    uint16_t e;
+    for(e = first; e <= last; e++) {
+        if(index->entries[e].in_cells) hit_index_cells_rem(index, e);
+        index->entries[e].in_cells = 0;
+    }
+
+    /*Get where the parent is clickable*/
+    lv_area_t par_area;
+    lv_area_t area;
+    bool on = true;
+    indev_get_click_area(par, &par_area);
+    for(par = lv_obj_get_parent(par); par != NULL && on; par = lv_obj_get_parent(par)) {
+        indev_get_click_area(par, &area);
+        on = lv_area_intersect(&par_area, &par_area, &area);
+    }
+
+    /*Set the entries again and add them to their new cells.
+     * The index is rebuilt if the objects are changed since it was built (e.g. while an object is created).*/
+    e = first;
+    if(hit_index_set(index, obj, on ? &par_area : NULL, &e, true) == false) {
+        index->root = NULL;
+        return;
+    }
+
+    e = last + 1;
+    while(e > first) {
+        e--;
+        if(index->entries[e].on && lv_obj_get_click(index->entries[e].obj)) {
+            if(hit_index_cells_add(index, e) == false) {
+                index->root = NULL;
+                return;
+            }
+            index->entries[e].in_cells = 1;
+        }
+    }
+#else
+    (void)obj; /*Unused*/
+#endif
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -353,6 +520,10 @@ static void indev_pointer_proc(lv_indev_t * i, lv_indev_data_t * data)
 
     i->proc.types.pointer.last_point.x = i->proc.types.pointer.act_point.x;
     i->proc.types.pointer.last_point.y = i->proc.types.pointer.act_point.y;
+#if LV_INDEV_QUEUE_SIZE > 0
+    /*Measure the speed from the last real sample (not from the reads of an empty queue)*/
+    if(data->timestamp) i->proc.types.pointer.last_timestamp = data->timestamp;
+#endif
 }
 
 /**
@@ -393,7 +564,7 @@ static void indev_keypad_proc(lv_indev_t * i, lv_indev_data_t * data)
 
     /*Key press happened*/
     if(data->state == LV_INDEV_STATE_PR && prev_state == LV_INDEV_STATE_REL) {
-        i->proc.pr_timestamp = lv_tick_get();
+        i->proc.pr_timestamp = indev_time;
 
         /*Simulate a press on the object if ENTER was pressed*/
         if(data->key == LV_KEY_ENTER) {
@@ -431,10 +602,10 @@ static void indev_keypad_proc(lv_indev_t * i, lv_indev_data_t * data)
     /*Pressing*/
     else if(data->state == LV_INDEV_STATE_PR && prev_state == LV_INDEV_STATE_PR) {
         /*Long press time has elapsed?*/
-        if(i->proc.long_pr_sent == 0 && lv_tick_elaps(i->proc.pr_timestamp) > i->driver.long_press_time) {
+        if(i->proc.long_pr_sent == 0 && indev_elaps(i->proc.pr_timestamp) > i->driver.long_press_time) {
             i->proc.long_pr_sent = 1;
             if(data->key == LV_KEY_ENTER) {
-                i->proc.longpr_rep_timestamp = lv_tick_get();
+                i->proc.longpr_rep_timestamp = indev_time;
                 indev_obj_act->signal_cb(indev_obj_act, LV_SIGNAL_LONG_PRESS, NULL);
                 if(indev_reset_check(&i->proc)) return;
                 lv_event_send(indev_obj_act, LV_EVENT_LONG_PRESSED, NULL);
@@ -443,9 +614,9 @@ static void indev_keypad_proc(lv_indev_t * i, lv_indev_data_t * data)
         }
         /*Long press repeated time has elapsed?*/
         else if(i->proc.long_pr_sent != 0 &&
-                lv_tick_elaps(i->proc.longpr_rep_timestamp) > i->driver.long_press_rep_time) {
+                indev_elaps(i->proc.longpr_rep_timestamp) > i->driver.long_press_rep_time) {
 
-            i->proc.longpr_rep_timestamp = lv_tick_get();
+            i->proc.longpr_rep_timestamp = indev_time;
 
             /*Send LONG_PRESS_REP on ENTER*/
             if(data->key == LV_KEY_ENTER) {
@@ -564,7 +735,7 @@ static void indev_encoder_proc(lv_indev_t * i, lv_indev_data_t * data)
         bool editable = false;
         indev_obj_act->signal_cb(indev_obj_act, LV_SIGNAL_GET_EDITABLE, &editable);
 
-        i->proc.pr_timestamp = lv_tick_get();
+        i->proc.pr_timestamp = indev_time;
         if(lv_group_get_editing(g) == true || editable == false) {
             indev_obj_act->signal_cb(indev_obj_act, LV_SIGNAL_PRESSED, NULL);
             if(indev_reset_check(&i->proc)) return;
@@ -575,7 +746,7 @@ static void indev_encoder_proc(lv_indev_t * i, lv_indev_data_t * data)
     }
     /*Pressing*/
     else if(data->state == LV_INDEV_STATE_PR && last_state == LV_INDEV_STATE_PR) {
-        if(i->proc.long_pr_sent == 0 && lv_tick_elaps(i->proc.pr_timestamp) > i->driver.long_press_time) {
+        if(i->proc.long_pr_sent == 0 && indev_elaps(i->proc.pr_timestamp) > i->driver.long_press_time) {
             bool editable = false;
             indev_obj_act->signal_cb(indev_obj_act, LV_SIGNAL_GET_EDITABLE, &editable);
 
@@ -738,7 +909,7 @@ static void indev_proc_press(lv_indev_proc_t * proc)
         if(indev_obj_act != NULL) {
             /* Save the time when the obj pressed.
              * It is necessary to count the long press time.*/
-            proc->pr_timestamp                 = lv_tick_get();
+            proc->pr_timestamp                 = indev_time;
             proc->long_pr_sent                 = 0;
             proc->types.pointer.drag_limit_out = 0;
             proc->types.pointer.drag_in_prog   = 0;
@@ -786,8 +957,26 @@ static void indev_proc_press(lv_indev_proc_t * proc)
     else if(proc->types.pointer.drag_throw_vect.y > 0)
         proc->types.pointer.drag_throw_vect.y--;
 
-    proc->types.pointer.drag_throw_vect.x += (proc->types.pointer.vect.x * 4) >> 3;
-    proc->types.pointer.drag_throw_vect.y += (proc->types.pointer.vect.y * 4) >> 3;
+    lv_point_t throw_add = proc->types.pointer.vect;
+#if LV_INDEV_QUEUE_SIZE > 0
+    /*The pushed samples have real time stamps and they can come at any rate.
+     *So convert the distance to the speed in pixels per read period which is used by the drag throw.*/
+    if(indev_act->driver.read_cb == NULL) {
+        int32_t dt = (int32_t)(indev_time - proc->types.pointer.last_timestamp);
+        if(dt > 0) {
+            uint32_t period = indev_act->driver.read_task->period;
+            throw_add.x     = (int32_t)throw_add.x * (int32_t)period / dt;
+            throw_add.y     = (int32_t)throw_add.y * (int32_t)period / dt;
+        } else {
+            /*The samples have the same time stamp so the speed is unknown*/
+            throw_add.x = 0;
+            throw_add.y = 0;
+        }
+    }
+#endif
+
+    proc->types.pointer.drag_throw_vect.x += (throw_add.x * 4) >> 3;
+    proc->types.pointer.drag_throw_vect.y += (throw_add.y * 4) >> 3;
 
     /*If there is active object and it can be dragged run the drag*/
     if(indev_obj_act != NULL) {
@@ -802,7 +991,7 @@ static void indev_proc_press(lv_indev_proc_t * proc)
         /*If there is no drag then check for long press time*/
         if(proc->types.pointer.drag_in_prog == 0 && proc->long_pr_sent == 0) {
             /*Send a signal about the long press if enough time elapsed*/
-            if(lv_tick_elaps(proc->pr_timestamp) > indev_act->driver.long_press_time) {
+            if(indev_elaps(proc->pr_timestamp) > indev_act->driver.long_press_time) {
                 indev_obj_act->signal_cb(indev_obj_act, LV_SIGNAL_LONG_PRESS, indev_act);
                 if(indev_reset_check(proc)) return;
                 lv_event_send(indev_obj_act, LV_EVENT_LONG_PRESSED, NULL);
@@ -812,18 +1001,18 @@ static void indev_proc_press(lv_indev_proc_t * proc)
                 proc->long_pr_sent = 1;
 
                 /*Save the long press time stamp for the long press repeat handler*/
-                proc->longpr_rep_timestamp = lv_tick_get();
+                proc->longpr_rep_timestamp = indev_time;
             }
         }
         /*Send long press repeated signal*/
         if(proc->types.pointer.drag_in_prog == 0 && proc->long_pr_sent == 1) {
             /*Send a signal about the long press repeat if enough time elapsed*/
-            if(lv_tick_elaps(proc->longpr_rep_timestamp) > indev_act->driver.long_press_rep_time) {
+            if(indev_elaps(proc->longpr_rep_timestamp) > indev_act->driver.long_press_rep_time) {
                 indev_obj_act->signal_cb(indev_obj_act, LV_SIGNAL_LONG_PRESS_REP, indev_act);
                 if(indev_reset_check(proc)) return;
                 lv_event_send(indev_obj_act, LV_EVENT_LONG_PRESSED_REPEAT, NULL);
                 if(indev_reset_check(proc)) return;
-                proc->longpr_rep_timestamp = lv_tick_get();
+                proc->longpr_rep_timestamp = indev_time;
             }
         }
     }
@@ -999,29 +1188,22 @@ static lv_obj_t * indev_search_obj(const lv_indev_proc_t * proc, lv_obj_t * obj)
 {
     lv_obj_t * found_p = NULL;
 
-    /*If the point is on this object check its children too*/
-#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    lv_area_t ext_area;
-    ext_area.x1 = obj->coords.x1 - obj->ext_click_pad_hor;
-    ext_area.x2 = obj->coords.x2 + obj->ext_click_pad_hor;
-    ext_area.y1 = obj->coords.y1 - obj->ext_click_pad_ver;
-    ext_area.y2 = obj->coords.y2 + obj->ext_click_pad_ver;
+#if LV_INDEV_HIT_INDEX_GRID > 0
+    /*Screens and layers are searched in their index (if it can be built). Their children are not roots.*/
+    if(lv_obj_get_parent(obj) == NULL) {
+        lv_indev_hit_index_t * index = hit_index_get(obj);
+        if(index) return hit_index_search(index, &proc->types.pointer.act_point);
+    }
+#endif
 
-    if(lv_area_is_point_on(&ext_area, &proc->types.pointer.act_point)) {
-#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    /*If the point is on this object check its children too*/
     lv_area_t ext_area;
-    ext_area.x1 = obj->coords.x1 - obj->ext_click_pad.x1;
-    ext_area.x2 = obj->coords.x2 + obj->ext_click_pad.x2;
-    ext_area.y1 = obj->coords.y1 - obj->ext_click_pad.y1;
-    ext_area.y2 = obj->coords.y2 + obj->ext_click_pad.y2;
+    indev_get_click_area(obj, &ext_area);
 
     if(lv_area_is_point_on(&ext_area, &proc->types.pointer.act_point)) {
-#else
-    if(lv_area_is_point_on(&obj->coords, &proc->types.pointer.act_point)) {
-#endif
         lv_obj_t * i;
 
-        LV_LL_READ(obj->child_ll, i)
+        LV_OBJ_CHILD_READ(obj, i)
         {
             found_p = indev_search_obj(proc, i);
 
@@ -1047,6 +1229,325 @@ static lv_obj_t * indev_search_obj(const lv_indev_proc_t * proc, lv_obj_t * obj)
     return found_p;
 }
 
+/**
+ * Get the area where an object can be clicked (its coordinates with the extended click area)
+ * @param obj pointer to an object
+ * @param area store the result area here
+ */
+static void indev_get_click_area(const lv_obj_t * obj, lv_area_t * area)
+{
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    area->x1 = obj->coords.x1 - obj->ext_click_pad_hor;
+    area->x2 = obj->coords.x2 + obj->ext_click_pad_hor;
+    area->y1 = obj->coords.y1 - obj->ext_click_pad_ver;
+    area->y2 = obj->coords.y2 + obj->ext_click_pad_ver;
+#elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    area->x1 = obj->coords.x1 - obj->ext_click_pad.x1;
+    area->x2 = obj->coords.x2 + obj->ext_click_pad.x2;
+    area->y1 = obj->coords.y1 - obj->ext_click_pad.y1;
+    area->y2 = obj->coords.y2 + obj->ext_click_pad.y2;
+#else
+    lv_area_copy(area, &obj->coords);
+#endif
+}
+
+#if LV_INDEV_HIT_INDEX_GRID > 0
+/**
+ * Get the up-to-date index of a screen or layer. Rebuild it if outdated.
+ * If the screen has no index yet, replace the least recently used one.
+ * @param root pointer to a screen or layer
+ * @return pointer to the index or NULL if it can't be built (e.g. out of memory)
+ */
+static lv_indev_hit_index_t * hit_index_get(lv_obj_t * root)
+{
+    if(LV_GC_ROOT(_lv_indev_hit_index) == NULL) {
+        LV_GC_ROOT(_lv_indev_hit_index) = lv_mem_alloc(sizeof(lv_indev_hit_index_t) * HIT_INDEX_SLOT_CNT);
+        if(LV_GC_ROOT(_lv_indev_hit_index) == NULL) return NULL;
+        memset(LV_GC_ROOT(_lv_indev_hit_index), 0, sizeof(lv_indev_hit_index_t) * HIT_INDEX_SLOT_CNT);
+    }
+
+    lv_indev_hit_index_t * slots = LV_GC_ROOT(_lv_indev_hit_index);
+    hit_index_stamp++;
+
+    /*Find the index of the root or the least recently used one*/
+    lv_indev_hit_index_t * index = &slots[0];
+    uint8_t i;
+    for(i = 0; i < HIT_INDEX_SLOT_CNT; i++) {
+        if(slots[i].root == root) {
+            index = &slots[i];
+            break;
+        }
+
+        if(slots[i].last_use < index->last_use) index = &slots[i];
+    }
+
+    index->last_use = hit_index_stamp;
+    if(index->root == root && index->gen == hit_index_gen) return index;
+
+    if(hit_index_build(index, root) == false) return NULL;
+
+    return index;
+}
+
+/**
+ * Collect the clickable objects of a screen and sort them into the cells of the grid
+ * @param index pointer to an index to (re)build. The buffers of the previous content are reused.
+ * @param root pointer to a screen or layer
+ * @return true: the index is built; false: the index can't be built
+ */
+static bool hit_index_build(lv_indev_hit_index_t * index, lv_obj_t * root)
+{
+    index->root = NULL; /*Invalid until it's successfully built*/
+
+    uint32_t obj_cnt = hit_index_count(root);
+    if(obj_cnt >= HIT_INDEX_NONE) return false; /*The items can't address so many entries*/
+
+    uint32_t entries_size = LV_MATH_MAX(obj_cnt, 1) * sizeof(lv_indev_hit_entry_t);
+    if(lv_mem_get_size(index->entries) < entries_size) {
+        lv_mem_free(index->entries);
+        index->entries = lv_mem_alloc(entries_size);
+        if(index->entries == NULL) return false;
+    }
+
+    indev_get_click_area(root, &index->area);
+    index->cell_w = (lv_area_get_width(&index->area) + LV_INDEV_HIT_INDEX_GRID - 1) / LV_INDEV_HIT_INDEX_GRID;
+    index->cell_h = (lv_area_get_height(&index->area) + LV_INDEV_HIT_INDEX_GRID - 1) / LV_INDEV_HIT_INDEX_GRID;
+    if(index->cell_w < 1) index->cell_w = 1;
+    if(index->cell_h < 1) index->cell_h = 1;
+
+    uint16_t entry_cnt = 0;
+    hit_index_set(index, root, &index->area, &entry_cnt, false);
+    index->entry_cnt = entry_cnt;
+
+    /*Count the items of the clickable entries and reserve some more for the moved objects*/
+    uint32_t item_cnt = 0;
+    uint16_t e;
+    lv_area_t cells;
+    for(e = 0; e < entry_cnt; e++) {
+        if(index->entries[e].on == 0 || lv_obj_get_click(index->entries[e].obj) == false) continue;
+        hit_index_get_cells(index, &index->entries[e].area, &cells);
+        item_cnt += lv_area_get_size(&cells);
+    }
+    if(item_cnt >= HIT_INDEX_NONE) return false;
+    item_cnt = LV_MATH_MIN(item_cnt + (item_cnt >> 2) + 8, HIT_INDEX_NONE - 1);
+
+    if(lv_mem_get_size(index->items) < item_cnt * sizeof(lv_indev_hit_item_t)) {
+        lv_mem_free(index->items);
+        index->items = lv_mem_alloc(item_cnt * sizeof(lv_indev_hit_item_t));
+        if(index->items == NULL) return false;
+    }
+
+    /*All items are unused*/
+    item_cnt = LV_MATH_MIN(lv_mem_get_size(index->items) / sizeof(lv_indev_hit_item_t), HIT_INDEX_NONE - 1);
+    uint32_t i;
+    for(i = 0; i < item_cnt; i++) index->items[i].next = i + 1;
+    index->items[item_cnt - 1].next = HIT_INDEX_NONE;
+    index->item_free                = 0;
+    memset(index->cell_head, 0xFF, sizeof(index->cell_head));
+
+    /*Add the entries backward so every entry is added to the beginning of its cells*/
+    e = entry_cnt;
+    while(e > 0) {
+        e--;
+        if(index->entries[e].on && lv_obj_get_click(index->entries[e].obj)) {
+            if(hit_index_cells_add(index, e) == false) return false;
+            index->entries[e].in_cells = 1;
+        }
+    }
+
+    index->root = root;
+    index->gen  = hit_index_gen;
+
+    return true;
+}
+
+/**
+ * Count an object and its not hidden children recursively
+ * @param obj pointer to an object
+ * @return number of objects which might be clickable
+ */
+static uint32_t hit_index_count(const lv_obj_t * obj)
+{
+    if(obj->hidden) return 0;
+
+    uint32_t cnt = 1;
+    lv_obj_t * i;
+    LV_OBJ_CHILD_READ(obj, i)
+    {
+        cnt += hit_index_count(i);
+    }
+
+    return cnt;
+}
+
+/**
+ * Set the entries of an object and its not hidden children in the same order as `indev_search_obj`
+ * would find them: the children (top most first) before their parent. The cells are not updated.
+ * @param index pointer to an index
+ * @param obj pointer to an object
+ * @param par_area the area where the parent of `obj` is clickable or NULL if it's out of its parents
+ * @param e pointer to the index of the next entry. Incremented with the set entries.
+ * @param check true: the entries have to belong to the same objects (update); false: new entries (build)
+ * @return false: the entries belong to other objects
+ */
+static bool hit_index_set(lv_indev_hit_index_t * index, lv_obj_t * obj, const lv_area_t * par_area, uint16_t * e,
+                          bool check)
+{
+    /*Neither the hidden objects nor their children can be clicked*/
+    if(obj->hidden) return true;
+
+    lv_area_t area;
+    bool on = false;
+    if(par_area) {
+        indev_get_click_area(obj, &area);
+        on = lv_area_intersect(&area, &area, par_area);
+    }
+
+    lv_obj_t * i;
+    LV_OBJ_CHILD_READ(obj, i)
+    {
+        if(hit_index_set(index, i, on ? &area : NULL, e, check) == false) return false;
+    }
+
+    lv_indev_hit_entry_t * entry = &index->entries[*e];
+    if(check) {
+        if(*e >= index->entry_cnt || entry->obj != obj) return false;
+    } else {
+        entry->obj      = obj;
+        entry->in_cells = 0;
+    }
+
+    entry->on = on ? 1 : 0;
+    if(on) lv_area_copy(&entry->area, &area);
+    (*e)++;
+
+    return true;
+}
+
+/**
+ * Get the cells covered by an area
+ * @param index pointer to an index
+ * @param area_p pointer to an area on the root
+ * @param cells_p store the column and row of the first (x1, y1) and last (x2, y2) cells here
+ */
+static void hit_index_get_cells(const lv_indev_hit_index_t * index, const lv_area_t * area_p, lv_area_t * cells_p)
+{
+    cells_p->x1 = (area_p->x1 - index->area.x1) / index->cell_w;
+    cells_p->y1 = (area_p->y1 - index->area.y1) / index->cell_h;
+    cells_p->x2 = (area_p->x2 - index->area.x1) / index->cell_w;
+    cells_p->y2 = (area_p->y2 - index->area.y1) / index->cell_h;
+}
+
+/**
+ * Add an entry to the cells of its area keeping the order of the entries in the cells
+ * @param index pointer to an index
+ * @param e index of the entry
+ * @return false: out of memory
+ */
+static bool hit_index_cells_add(lv_indev_hit_index_t * index, uint16_t e)
+{
+    lv_area_t cells;
+    hit_index_get_cells(index, &index->entries[e].area, &cells);
+
+    lv_coord_t cx;
+    lv_coord_t cy;
+    for(cy = cells.y1; cy <= cells.y2; cy++) {
+        for(cx = cells.x1; cx <= cells.x2; cx++) {
+            if(index->item_free == HIT_INDEX_NONE && hit_index_items_grow(index) == false) return false;
+
+            uint16_t item    = index->item_free;
+            index->item_free = index->items[item].next;
+
+            uint16_t * next_p = &index->cell_head[cy * LV_INDEV_HIT_INDEX_GRID + cx];
+            while(*next_p != HIT_INDEX_NONE && index->items[*next_p].entry < e) {
+                next_p = &index->items[*next_p].next;
+            }
+
+            index->items[item].entry = e;
+            index->items[item].next  = *next_p;
+            *next_p                  = item;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Remove an entry from the cells of its area
+ * @param index pointer to an index
+ * @param e index of the entry
+ */
+static void hit_index_cells_rem(lv_indev_hit_index_t * index, uint16_t e)
+{
+    lv_area_t cells;
+    hit_index_get_cells(index, &index->entries[e].area, &cells);
+
+    lv_coord_t cx;
+    lv_coord_t cy;
+    for(cy = cells.y1; cy <= cells.y2; cy++) {
+        for(cx = cells.x1; cx <= cells.x2; cx++) {
+            uint16_t * next_p = &index->cell_head[cy * LV_INDEV_HIT_INDEX_GRID + cx];
+            while(*next_p != HIT_INDEX_NONE) {
+                uint16_t item = *next_p;
+                if(index->items[item].entry == e) {
+                    *next_p                 = index->items[item].next;
+                    index->items[item].next = index->item_free;
+                    index->item_free        = item;
+                    break;
+                }
+                next_p = &index->items[item].next;
+            }
+        }
+    }
+}
+
+/**
+ * Allocate more items for the cells
+ * @param index pointer to an index without unused items
+ * @return false: out of memory or too many items
+ */
+static bool hit_index_items_grow(lv_indev_hit_index_t * index)
+{
+    uint32_t cnt = lv_mem_get_size(index->items) / sizeof(lv_indev_hit_item_t);
+    if(cnt >= HIT_INDEX_NONE - 1) return false;
+
+    uint32_t new_cnt = LV_MATH_MIN(cnt + (cnt >> 1) + 8, HIT_INDEX_NONE - 1);
+    lv_indev_hit_item_t * items = lv_mem_realloc(index->items, new_cnt * sizeof(lv_indev_hit_item_t));
+    if(items == NULL) return false;
+    index->items = items;
+
+    uint32_t i;
+    for(i = cnt; i < new_cnt; i++) index->items[i].next = i + 1;
+    index->items[new_cnt - 1].next = HIT_INDEX_NONE;
+    index->item_free               = cnt;
+
+    return true;
+}
+
+/**
+ * Search the top most clickable object on a point in an index
+ * @param index pointer to an up-to-date index
+ * @param point pointer to a point
+ * @return pointer to the found object or NULL if there was no suitable object
+ */
+static lv_obj_t * hit_index_search(const lv_indev_hit_index_t * index, const lv_point_t * point)
+{
+    if(lv_area_is_point_on(&index->area, point) == false) return NULL;
+
+    lv_coord_t cx = (point->x - index->area.x1) / index->cell_w;
+    lv_coord_t cy = (point->y - index->area.y1) / index->cell_h;
+
+    uint16_t item;
+    for(item = index->cell_head[cy * LV_INDEV_HIT_INDEX_GRID + cx]; item != HIT_INDEX_NONE;
+        item = index->items[item].next) {
+        const lv_indev_hit_entry_t * entry = &index->entries[index->items[item].entry];
+        if(lv_area_is_point_on(&entry->area, point)) return entry->obj;
+    }
+
+    return NULL;
+}
+#endif
+
 /**
  * Handle the dragging of indev_proc_p->types.pointer.act_obj
  * @param indev pointer to a input device state
@@ -1238,3 +1739,16 @@ static bool indev_reset_check(lv_indev_proc_t * proc)
 
     return proc->reset_query ? true : false;
 }
+
+/**
+ * Get the elapsed time since a time stamp until the time of the processed sample.
+ * The samples of the input devices can be older than the current tick (see `LV_INDEV_QUEUE_SIZE`).
+ * @param prev_tick a previous time stamp (e.g. the time of an earlier sample)
+ * @return the elapsed milliseconds. 0 if `prev_tick` is later than the processed sample.
+ */
+static uint32_t indev_elaps(uint32_t prev_tick)
+{
+    int32_t elaps = (int32_t)(indev_time - prev_tick);
+
+    return elaps > 0 ? (uint32_t)elaps : 0;
+}
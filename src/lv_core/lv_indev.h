@@ -148,6 +148,21 @@ lv_task_t * lv_indev_get_read_task(lv_disp_t * indev);
  */
 lv_obj_t * lv_indev_get_obj_act(void);
 
+/**
+ * Mark the index of the clickable objects outdated (see `LV_INDEV_HIT_INDEX_GRID`).
+ * Called by the object library when an object is created, deleted, hidden, reordered, moved to an other parent
+ * or its clickability is changed.
+ */
+void lv_indev_invalidate_hit_index(void);
+
+/**
+ * Update the clickable area of an object and its children in the index of its screen
+ * (see `LV_INDEV_HIT_INDEX_GRID`). Called by the object library when an object is moved or resized
+ * or its extended click area is changed.
+ * @param obj pointer to an object
+ */
+void lv_indev_update_hit_index(lv_obj_t * obj);
+
 /**********************
  *      MACROS
  **********************/
@@ -11,6 +11,8 @@
 #include "lv_refr.h"
 #include "lv_group.h"
 #include "lv_disp.h"
+#include "lv_prof.h"
+#include "lv_cmdq.h"
 #include "../lv_core/lv_debug.h"
 #include "../lv_themes/lv_theme.h"
 #include "../lv_draw/lv_draw.h"
@@ -28,9 +30,17 @@
 #include LV_GC_INCLUDE
 #endif /* LV_ENABLE_GC */
 
+#if LV_MEM_TRACE
+/*The call site is saved by the caller's macro. Here the real function is used.*/
+#undef lv_obj_allocate_ext_attr
+#endif
+
 /*********************
  *      DEFINES
  *********************/
+#ifndef LV_OBJ_STYLE_INDEX_SIZE
+#define LV_OBJ_STYLE_INDEX_SIZE 32 /*Number of buckets in the style index*/
+#endif
 #define LV_OBJX_NAME "lv_obj"
 #define LV_OBJ_DEF_WIDTH (LV_DPI)
 #define LV_OBJ_DEF_HEIGHT (2 * LV_DPI / 3)
@@ -50,6 +60,15 @@ typedef struct _lv_event_temp_data
  **********************/
 static void refresh_children_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff);
 static void report_style_mod_core(void * style_p, lv_obj_t * obj);
+#if LV_USE_OBJ_CHILD_ARRAY
+static bool child_arr_ins(lv_obj_t * par, lv_obj_t * obj, uint16_t id);
+static void child_arr_rem(lv_obj_t * par, lv_obj_t * obj);
+#endif
+#if LV_USE_OBJ_STYLE_INDEX
+static lv_obj_t ** style_index_get_bucket(const lv_style_t * style);
+static void style_index_add(lv_obj_t * obj);
+static void style_index_rem(lv_obj_t * obj);
+#endif
 static void refresh_children_style(lv_obj_t * obj);
 static void delete_children(lv_obj_t * obj);
 static void base_dir_refr_children(lv_obj_t * obj);
@@ -96,18 +115,32 @@ void lv_init(void)
 
 #if LV_USE_ANIMATION
     lv_anim_core_init();
+
+    /*Move and resize the objects with one invalidation if both coordinates are animated*/
+    lv_anim_add_batch((lv_anim_exec_xcb_t)lv_obj_set_x, (lv_anim_exec_xcb_t)lv_obj_set_y,
+                      (lv_anim_exec2_xcb_t)lv_obj_set_pos);
+    lv_anim_add_batch((lv_anim_exec_xcb_t)lv_obj_set_width, (lv_anim_exec_xcb_t)lv_obj_set_height,
+                      (lv_anim_exec2_xcb_t)lv_obj_set_size);
 #endif
 
 #if LV_USE_GROUP
     lv_group_init();
 #endif
 
+#if LV_USE_CMDQ
+    lv_cmdq_init();
+#endif
+
     /*Init. the sstyles*/
     lv_style_init();
 
     /*Initialize the screen refresh system*/
     lv_refr_init();
 
+#if LV_USE_PROF
+    lv_prof_init();
+#endif
+
     lv_ll_init(&LV_GC_ROOT(_lv_disp_ll), sizeof(lv_disp_t));
     lv_ll_init(&LV_GC_ROOT(_lv_indev_ll), sizeof(lv_indev_t));
 
@@ -117,6 +150,14 @@ void lv_init(void)
     lv_img_decoder_init();
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 
+#if LV_USE_OBJ_STYLE_INDEX
+    /*If it fails `lv_obj_report_style_mod` will search all objects*/
+    LV_GC_ROOT(_lv_obj_style_index) = lv_mem_alloc(LV_OBJ_STYLE_INDEX_SIZE * sizeof(lv_obj_t *));
+    if(LV_GC_ROOT(_lv_obj_style_index)) {
+        memset(LV_GC_ROOT(_lv_obj_style_index), 0, LV_OBJ_STYLE_INDEX_SIZE * sizeof(lv_obj_t *));
+    }
+#endif
+
     lv_initialized = true;
     LV_LOG_INFO("lv_init ready");
 }
@@ -164,7 +205,13 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         if(new_obj == NULL) return NULL;
 
         new_obj->par = NULL; /*Screens has no a parent*/
+#if LV_USE_OBJ_CHILD_ARRAY
+        new_obj->child_arr = NULL;
+        new_obj->child_cnt = 0;
+        new_obj->child_id  = 0;
+#else
         lv_ll_init(&(new_obj->child_ll), sizeof(lv_obj_t));
+#endif
 
         /*Set the callbacks*/
         new_obj->signal_cb = lv_obj_signal;
@@ -203,6 +250,12 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         } else {
             new_obj->style_p = &lv_style_scr;
         }
+#if LV_USE_OBJ_STYLE_CACHE
+        new_obj->style_cache = NULL;
+#endif
+#if LV_USE_OBJ_STYLE_INDEX
+        style_index_add(new_obj);
+#endif
 
         /*Init. user date*/
 #if LV_USE_USER_DATA
@@ -219,6 +272,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->drag_parent  = 0;
         new_obj->hidden       = 0;
         new_obj->top          = 0;
+        new_obj->layer_cache  = 0;
+        new_obj->scroll_blit  = 0;
         new_obj->protect      = LV_PROTECT_NONE;
         new_obj->opa_scale_en = 0;
         new_obj->opa_scale    = LV_OPA_COVER;
@@ -240,12 +295,28 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         LV_LOG_TRACE("Object create started");
         LV_ASSERT_OBJ(parent, LV_OBJX_NAME);
 
+#if LV_USE_OBJ_CHILD_ARRAY
+        new_obj = lv_mem_alloc(sizeof(lv_obj_t));
+        LV_ASSERT_MEM(new_obj);
+        if(new_obj == NULL) return NULL;
+
+        /*Add the new object to the top*/
+        if(child_arr_ins(parent, new_obj, parent->child_cnt) == false) {
+            lv_mem_free(new_obj);
+            return NULL;
+        }
+
+        new_obj->par       = parent; /*Set the parent*/
+        new_obj->child_arr = NULL;
+        new_obj->child_cnt = 0;
+#else
         new_obj = lv_ll_ins_head(&parent->child_ll);
         LV_ASSERT_MEM(new_obj);
         if(new_obj == NULL) return NULL;
 
         new_obj->par = parent; /*Set the parent*/
         lv_ll_init(&(new_obj->child_ll), sizeof(lv_obj_t));
+#endif
 
         /*Set the callbacks*/
         new_obj->signal_cb = lv_obj_signal;
@@ -294,6 +365,12 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         } else {
             new_obj->style_p = &lv_style_plain_color;
         }
+#if LV_USE_OBJ_STYLE_CACHE
+        new_obj->style_cache = NULL;
+#endif
+#if LV_USE_OBJ_STYLE_INDEX
+        style_index_add(new_obj);
+#endif
 
 #if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
         memset(&new_obj->ext_click_pad, 0, sizeof(new_obj->ext_click_pad));
@@ -321,6 +398,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->drag_parent  = 0;
         new_obj->hidden       = 0;
         new_obj->top          = 0;
+        new_obj->layer_cache  = 0;
+        new_obj->scroll_blit  = 0;
         new_obj->protect      = LV_PROTECT_NONE;
         new_obj->opa_scale    = LV_OPA_COVER;
         new_obj->opa_scale_en = 0;
@@ -376,7 +455,13 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         new_obj->protect      = copy->protect;
         new_obj->opa_scale    = copy->opa_scale;
 
+#if LV_USE_OBJ_STYLE_INDEX
+        style_index_rem(new_obj);
         new_obj->style_p = copy->style_p;
+        style_index_add(new_obj);
+#else
+        new_obj->style_p = copy->style_p;
+#endif
 
 #if LV_USE_GROUP
         /*Add to the same group*/
@@ -395,6 +480,8 @@ lv_obj_t * lv_obj_create(lv_obj_t * parent, const lv_obj_t * copy)
         LV_LOG_INFO("Object create ready");
     }
 
+    lv_indev_invalidate_hit_index();
+
     /*Send a signal to the parent to notify it about the new child*/
     if(parent != NULL) {
         parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, new_obj);
@@ -430,10 +517,10 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
     /*Recursively delete the children*/
     lv_obj_t * i;
     lv_obj_t * i_next;
-    i = lv_ll_get_head(&(obj->child_ll));
+    i = LV_OBJ_CHILD_TOP(obj);
     while(i != NULL) {
         /*Get the next object before delete this*/
-        i_next = lv_ll_get_next(&(obj->child_ll), i);
+        i_next = LV_OBJ_CHILD_BELOW(obj, i);
 
         /*Call the recursive del to the child too*/
         delete_children(i);
@@ -447,6 +534,10 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
 
     lv_event_mark_deleted(obj);
 
+#if LV_USE_CMDQ
+    lv_cmdq_remove_obj(obj);
+#endif
+
     /* Reset all input devices if the object to delete is used*/
     lv_indev_t * indev = lv_indev_get_next(NULL);
     while(indev) {
@@ -469,19 +560,36 @@ lv_res_t lv_obj_del(lv_obj_t * obj)
      * Now clean up the object specific data*/
     obj->signal_cb(obj, LV_SIGNAL_CLEANUP, NULL);
 
+#if LV_USE_OBJ_STYLE_INDEX
+    style_index_rem(obj);
+#endif
+
+#if LV_USE_OBJ_LAYER_CACHE
+    if(obj->layer_cache) lv_refr_set_layer_cache(obj, false);
+#endif
+
     /*Remove the object from parent's children list*/
     lv_obj_t * par = lv_obj_get_parent(obj);
     if(par == NULL) { /*It is a screen*/
         lv_disp_t * d = lv_obj_get_disp(obj);
         lv_ll_rem(&d->scr_ll, obj);
     } else {
+#if LV_USE_OBJ_CHILD_ARRAY
+        child_arr_rem(par, obj);
+#else
         lv_ll_rem(&(par->child_ll), obj);
+#endif
     }
 
     /*Delete the base objects*/
+#if LV_USE_OBJ_CHILD_ARRAY
+    lv_mem_free(obj->child_arr);
+#endif
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
     lv_mem_free(obj); /*Free the object itself*/
 
+    lv_indev_invalidate_hit_index();
+
     /*Send a signal to the parent to notify it about the child delete*/
     if(par != NULL) {
         par->signal_cb(par, LV_SIGNAL_CHILD_CHG, NULL);
@@ -563,7 +671,12 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
             par = lv_obj_get_parent(par);
         }
 
-        if(is_common) lv_inv_area(disp, &area_trunc);
+        if(is_common) {
+            lv_inv_area(disp, &area_trunc);
+#if LV_USE_OBJ_LAYER_CACHE
+            lv_refr_inv_layer_cache(obj, &area_trunc);
+#endif
+        }
     }
 }
 
@@ -623,8 +736,19 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
 
     lv_obj_t * old_par = obj->par;
 
+#if LV_USE_OBJ_CHILD_ARRAY
+    uint16_t old_id = obj->child_id;
+    child_arr_rem(old_par, obj);
+    if(child_arr_ins(parent, obj, parent->child_cnt) == false) {
+        child_arr_ins(old_par, obj, old_id); /*The old array is large enough*/
+        return;
+    }
+#else
     lv_ll_chg_list(&obj->par->child_ll, &parent->child_ll, obj, true);
+#endif
     obj->par = parent;
+    lv_indev_invalidate_hit_index();
+    lv_obj_clean_style_cache(obj); /*The inherited styles might be different*/
     lv_obj_set_pos(obj, old_pos.x, old_pos.y);
 
     /*Notify the original parent because one of its children is lost*/
@@ -647,11 +771,17 @@ void lv_obj_move_foreground(lv_obj_t * obj)
     lv_obj_t * parent = lv_obj_get_parent(obj);
 
     /*Do nothing of already in the foreground*/
-    if(lv_ll_get_head(&parent->child_ll) == obj) return;
+    if(LV_OBJ_CHILD_TOP(parent) == obj) return;
 
     lv_obj_invalidate(parent);
 
+#if LV_USE_OBJ_CHILD_ARRAY
+    child_arr_rem(parent, obj);
+    child_arr_ins(parent, obj, parent->child_cnt);
+#else
     lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, true);
+#endif
+    lv_indev_invalidate_hit_index();
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -670,11 +800,17 @@ void lv_obj_move_background(lv_obj_t * obj)
     lv_obj_t * parent = lv_obj_get_parent(obj);
 
     /*Do nothing of already in the background*/
-    if(lv_ll_get_tail(&parent->child_ll) == obj) return;
+    if(LV_OBJ_CHILD_BOTTOM(parent) == obj) return;
 
     lv_obj_invalidate(parent);
 
+#if LV_USE_OBJ_CHILD_ARRAY
+    child_arr_rem(parent, obj);
+    child_arr_ins(parent, obj, 0);
+#else
     lv_ll_chg_list(&parent->child_ll, &parent->child_ll, obj, false);
+#endif
+    lv_indev_invalidate_hit_index();
 
     /*Notify the new parent about the child*/
     parent->signal_cb(parent, LV_SIGNAL_CHILD_CHG, obj);
@@ -713,7 +849,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     if(diff.x == 0 && diff.y == 0) return;
 
     /*Invalidate the original area*/
-    lv_obj_invalidate(obj);
+    if(obj->scroll_blit == 0) lv_obj_invalidate(obj);
 
     /*Save the original coordinates*/
     lv_area_t ori;
@@ -725,6 +861,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     obj->coords.y2 += diff.y;
 
     refresh_children_position(obj, diff.x, diff.y);
+    lv_indev_update_hit_index(obj);
 
     /*Inform the object about its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_CORD_CHG, &ori);
@@ -733,7 +870,7 @@ void lv_obj_set_pos(lv_obj_t * obj, lv_coord_t x, lv_coord_t y)
     par->signal_cb(par, LV_SIGNAL_CHILD_CHG, obj);
 
     /*Invalidate the new area*/
-    lv_obj_invalidate(obj);
+    if(obj->scroll_blit == 0) lv_obj_invalidate(obj);
 }
 
 /**
@@ -792,6 +929,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
     } else {
         obj->coords.x2 = obj->coords.x1 + w - 1;
     }
+    lv_indev_update_hit_index(obj);
 
     /*Send a signal to the object with its new coordinates*/
     obj->signal_cb(obj, LV_SIGNAL_CORD_CHG, &ori);
@@ -802,7 +940,7 @@ void lv_obj_set_size(lv_obj_t * obj, lv_coord_t w, lv_coord_t h)
 
     /*Tell the children the parent's size has changed*/
     lv_obj_t * i;
-    LV_LL_READ(obj->child_ll, i)
+    LV_OBJ_CHILD_READ(obj, i)
     {
         i->signal_cb(i, LV_SIGNAL_PARENT_SIZE_CHG, NULL);
     }
@@ -1201,9 +1339,11 @@ void lv_obj_set_ext_click_area(lv_obj_t * obj, lv_coord_t left, lv_coord_t right
     obj->ext_click_pad.x2 = right;
     obj->ext_click_pad.y1 = top;
     obj->ext_click_pad.y2 = bottom;
+    lv_indev_update_hit_index(obj);
 #elif LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
     obj->ext_click_pad_hor = LV_MATH_MAX(left, right);
     obj->ext_click_pad_ver = LV_MATH_MAX(top, bottom);
+    lv_indev_update_hit_index(obj);
 #else
     (void)obj;    /*Unused*/
     (void)left;   /*Unused*/
@@ -1227,7 +1367,17 @@ void lv_obj_set_style(lv_obj_t * obj, const lv_style_t * style)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
     LV_ASSERT_STYLE(style);
 
+#if LV_USE_OBJ_STYLE_INDEX
+    /*Keep the position in the index if the style is the same.
+     * It's important when a style is set while reporting its modification*/
+    if(obj->style_p != style) {
+        style_index_rem(obj);
+        obj->style_p = style;
+        style_index_add(obj);
+    }
+#else
     obj->style_p = style;
+#endif
 
     /*Send a signal about style change to every children with NULL style*/
     refresh_children_style(obj);
@@ -1244,6 +1394,10 @@ void lv_obj_refresh_style(lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+#if LV_USE_OBJ_STYLE_CACHE
+    obj->style_cache = NULL; /*The parent's style or its `glass` attribute might be changed*/
+#endif
+
     lv_obj_invalidate(obj);
     obj->signal_cb(obj, LV_SIGNAL_STYLE_CHG, NULL);
     lv_obj_invalidate(obj);
@@ -1258,6 +1412,23 @@ void lv_obj_report_style_mod(lv_style_t * style)
 {
     LV_ASSERT_STYLE(style);
 
+#if LV_USE_OBJ_STYLE_INDEX
+    /*Refresh only the users of the style*/
+    if(style != NULL && LV_GC_ROOT(_lv_obj_style_index) != NULL) {
+        lv_obj_t * i = *style_index_get_bucket(style);
+        while(i) {
+            lv_obj_t * i_next = i->style_next;
+            if(i->style_p == style) {
+                /*Screens' children are refreshed only if their style was modified*/
+                if(i->par) refresh_children_style(i);
+                lv_obj_refresh_style(i);
+            }
+            i = i_next;
+        }
+        return;
+    }
+#endif
+
     lv_disp_t * d = lv_disp_get_next(NULL);
 
     while(d) {
@@ -1274,6 +1445,26 @@ void lv_obj_report_style_mod(lv_style_t * style)
     }
 }
 
+/**
+ * Clean the cached styles of an object and its children. They will be resolved again when used.
+ * Called by the library when the parent or the focus state of an object changes.
+ * @param obj pointer to an object
+ */
+void lv_obj_clean_style_cache(lv_obj_t * obj)
+{
+#if LV_USE_OBJ_STYLE_CACHE
+    obj->style_cache = NULL;
+
+    lv_obj_t * child;
+    LV_OBJ_CHILD_READ(obj, child)
+    {
+        lv_obj_clean_style_cache(child);
+    }
+#else
+    (void)obj; /*Unused*/
+#endif
+}
+
 /*-----------------
  * Attribute set
  *----------------*/
@@ -1290,6 +1481,7 @@ void lv_obj_set_hidden(lv_obj_t * obj, bool en)
     if(!obj->hidden) lv_obj_invalidate(obj); /*Invalidate when not hidden (hidden objects are ignored) */
 
     obj->hidden = en == false ? 0 : 1;
+    lv_indev_invalidate_hit_index();
 
     if(!obj->hidden) lv_obj_invalidate(obj); /*Invalidate when not hidden (hidden objects are ignored) */
 
@@ -1307,6 +1499,7 @@ void lv_obj_set_click(lv_obj_t * obj, bool en)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     obj->click = (en == true ? 1 : 0);
+    lv_indev_invalidate_hit_index();
 }
 
 /**
@@ -1431,6 +1624,26 @@ void lv_obj_set_opa_scale(lv_obj_t * obj, lv_opa_t opa_scale)
     lv_obj_invalidate(obj);
 }
 
+#if LV_USE_OBJ_LAYER_CACHE
+/**
+ * Save the rendered image of an object and its children and draw it instead of the objects
+ * while they are not invalidated. Useful for complex but static parts of the screen.
+ * Needs `width x height x sizeof(lv_color_t)` bytes memory. Not used with `set_px_cb`.
+ * @param obj pointer to an object
+ * @param en true: enable the layer cache; false: disable it and free the saved image
+ */
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    if(obj->layer_cache == (en ? 1 : 0)) return;
+
+    if(lv_refr_set_layer_cache(obj, en) == false) return;
+    obj->layer_cache = en ? 1 : 0;
+    lv_obj_invalidate(obj);
+}
+#endif
+
 /**
  * Set a bit or bits in the protect filed
  * @param obj pointer to an object
@@ -1713,9 +1926,9 @@ lv_obj_t * lv_obj_get_child(const lv_obj_t * obj, const lv_obj_t * child)
     lv_obj_t * result = NULL;
 
     if(child == NULL) {
-        result = lv_ll_get_head(&obj->child_ll);
+        result = LV_OBJ_CHILD_TOP(obj);
     } else {
-        result = lv_ll_get_next(&obj->child_ll, child);
+        result = LV_OBJ_CHILD_BELOW(obj, child);
     }
 
     return result;
@@ -1735,9 +1948,9 @@ lv_obj_t * lv_obj_get_child_back(const lv_obj_t * obj, const lv_obj_t * child)
     lv_obj_t * result = NULL;
 
     if(child == NULL) {
-        result = lv_ll_get_tail(&obj->child_ll);
+        result = LV_OBJ_CHILD_BOTTOM(obj);
     } else {
-        result = lv_ll_get_prev(&obj->child_ll, child);
+        result = LV_OBJ_CHILD_ABOVE(obj, child);
     }
 
     return result;
@@ -1752,12 +1965,16 @@ uint16_t lv_obj_count_children(const lv_obj_t * obj)
 {
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
+#if LV_USE_OBJ_CHILD_ARRAY
+    return obj->child_cnt;
+#else
     lv_obj_t * i;
     uint16_t cnt = 0;
 
     LV_LL_READ(obj->child_ll, i) cnt++;
 
     return cnt;
+#endif
 }
 
 /** Recursively count the children of an object
@@ -1771,7 +1988,7 @@ uint16_t lv_obj_count_children_recursive(const lv_obj_t * obj)
     lv_obj_t * i;
     uint16_t cnt = 0;
 
-    LV_LL_READ(obj->child_ll, i)
+    LV_OBJ_CHILD_READ(obj, i)
     {
         cnt++;                                     /*Count the child*/
         cnt += lv_obj_count_children_recursive(i); /*recursively count children's children*/
@@ -2024,7 +2241,13 @@ const lv_style_t * lv_obj_get_style(const lv_obj_t * obj)
     LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
 
     const lv_style_t * style_act = obj->style_p;
+#if LV_USE_OBJ_STYLE_CACHE
+    bool cache = true;
+#endif
     if(style_act == NULL) {
+#if LV_USE_OBJ_STYLE_CACHE
+        if(obj->style_cache) return obj->style_cache;
+#endif
         lv_obj_t * par = obj->par;
 
         while(par) {
@@ -2037,6 +2260,9 @@ const lv_style_t * lv_obj_get_style(const lv_obj_t * obj)
                     lv_group_t * g = lv_obj_get_group(par);
                     if(lv_group_get_focused(g) == par) {
                         style_act = lv_group_mod_style(g, par->style_p);
+#if LV_USE_OBJ_STYLE_CACHE
+                        cache = false;
+#endif
                     } else {
                         style_act = par->style_p;
                     }
@@ -2051,12 +2277,25 @@ const lv_style_t * lv_obj_get_style(const lv_obj_t * obj)
     if(obj->group_p) {
         if(lv_group_get_focused(obj->group_p) == obj) {
             style_act = lv_group_mod_style(obj->group_p, style_act);
+#if LV_USE_OBJ_STYLE_CACHE
+            cache = false;
+#endif
         }
     }
 #endif
 
     if(style_act == NULL) style_act = &lv_style_plain;
 
+#if LV_USE_OBJ_STYLE_CACHE
+    /*Cache only the inherited styles: the own style is returned directly anyway
+     * and some objects temporarily replace it while they are drawn.
+     * The focused styles are not cached because they are created in the group's `style_tmp` again every time*/
+    if(obj->style_p == NULL && cache) {
+        lv_obj_t * obj_cache   = (lv_obj_t *)obj; /*Only the cache is modified*/
+        obj_cache->style_cache = style_act;
+    }
+#endif
+
     return style_act;
 }
 
@@ -2209,6 +2448,20 @@ lv_opa_t lv_obj_get_opa_scale(const lv_obj_t * obj)
     return LV_OPA_COVER;
 }
 
+#if LV_USE_OBJ_LAYER_CACHE
+/**
+ * Get whether the layer cache is enabled on an object
+ * @param obj pointer to an object
+ * @return true: the layer cache is enabled
+ */
+bool lv_obj_get_layer_cache(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, LV_OBJX_NAME);
+
+    return obj->layer_cache == 0 ? false : true;
+}
+#endif
+
 /**
  * Get the protect field of an object
  * @param obj pointer to an object
@@ -2502,7 +2755,7 @@ static lv_res_t lv_obj_signal(lv_obj_t * obj, lv_signal_t sign, void * param)
 static void refresh_children_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coord_t y_diff)
 {
     lv_obj_t * i;
-    LV_LL_READ(obj->child_ll, i)
+    LV_OBJ_CHILD_READ(obj, i)
     {
         i->coords.x1 += x_diff;
         i->coords.y1 += y_diff;
@@ -2521,7 +2774,7 @@ static void refresh_children_position(lv_obj_t * obj, lv_coord_t x_diff, lv_coor
 static void report_style_mod_core(void * style_p, lv_obj_t * obj)
 {
     lv_obj_t * i;
-    LV_LL_READ(obj->child_ll, i)
+    LV_OBJ_CHILD_READ(obj, i)
     {
         if(i->style_p == style_p || style_p == NULL) {
             refresh_children_style(i);
@@ -2532,6 +2785,109 @@ static void report_style_mod_core(void * style_p, lv_obj_t * obj)
     }
 }
 
+#if LV_USE_OBJ_CHILD_ARRAY
+/**
+ * Insert an object into the children array of a parent
+ * @param par pointer to the parent
+ * @param obj pointer to the object to insert
+ * @param id index of the object in the array. `par->child_cnt` to add it to the top
+ * @return true: success; false: out of memory
+ */
+static bool child_arr_ins(lv_obj_t * par, lv_obj_t * obj, uint16_t id)
+{
+    uint32_t size = lv_mem_get_size(par->child_arr) / sizeof(lv_obj_t *);
+
+    /*Grow the array if required. Keep the old one if there is no enough memory*/
+    if(par->child_cnt >= size) {
+        size = par->child_cnt + (par->child_cnt >> 1) + 4;
+        lv_obj_t ** new_arr = lv_mem_alloc(size * sizeof(lv_obj_t *));
+        LV_ASSERT_MEM(new_arr);
+        if(new_arr == NULL) return false;
+
+        if(par->child_arr) {
+            memcpy(new_arr, par->child_arr, par->child_cnt * sizeof(lv_obj_t *));
+            lv_mem_free(par->child_arr);
+        }
+        par->child_arr = new_arr;
+    }
+
+    memmove(&par->child_arr[id + 1], &par->child_arr[id], (par->child_cnt - id) * sizeof(lv_obj_t *));
+    par->child_arr[id] = obj;
+    par->child_cnt++;
+
+    /*Update the index of the moved children too*/
+    uint16_t i;
+    for(i = id; i < par->child_cnt; i++) par->child_arr[i]->child_id = i;
+
+    return true;
+}
+
+/**
+ * Remove an object from the children array of its parent.
+ * The array is not shrunk so the object can be inserted again without allocation.
+ * @param par pointer to the parent
+ * @param obj pointer to a child of `par`
+ */
+static void child_arr_rem(lv_obj_t * par, lv_obj_t * obj)
+{
+    uint16_t id = obj->child_id;
+
+    par->child_cnt--;
+    memmove(&par->child_arr[id], &par->child_arr[id + 1], (par->child_cnt - id) * sizeof(lv_obj_t *));
+
+    uint16_t i;
+    for(i = id; i < par->child_cnt; i++) par->child_arr[i]->child_id = i;
+}
+#endif
+
+#if LV_USE_OBJ_STYLE_INDEX
+/**
+ * Get the bucket of the style index in which the users of a style are stored
+ * @param style pointer to a style
+ * @return pointer to the first object of the bucket
+ */
+static lv_obj_t ** style_index_get_bucket(const lv_style_t * style)
+{
+    lv_obj_t ** index = LV_GC_ROOT(_lv_obj_style_index);
+
+    /*The styles are at least word aligned so ignore the lower bits*/
+    return &index[((lv_uintptr_t)style >> 3) % LV_OBJ_STYLE_INDEX_SIZE];
+}
+
+/**
+ * Add an object to the style index according to its current style
+ * @param obj pointer to an object
+ */
+static void style_index_add(lv_obj_t * obj)
+{
+    obj->style_next = NULL;
+    obj->style_prev = NULL;
+    if(obj->style_p == NULL || LV_GC_ROOT(_lv_obj_style_index) == NULL) return;
+
+    lv_obj_t ** bucket = style_index_get_bucket(obj->style_p);
+    obj->style_next    = *bucket;
+    if(*bucket) (*bucket)->style_prev = obj;
+    *bucket = obj;
+}
+
+/**
+ * Remove an object from the style index. Should be called before its style is changed.
+ * @param obj pointer to an object
+ */
+static void style_index_rem(lv_obj_t * obj)
+{
+    if(obj->style_p == NULL || LV_GC_ROOT(_lv_obj_style_index) == NULL) return;
+
+    if(obj->style_prev) obj->style_prev->style_next = obj->style_next;
+    else *style_index_get_bucket(obj->style_p) = obj->style_next;
+
+    if(obj->style_next) obj->style_next->style_prev = obj->style_prev;
+
+    obj->style_next = NULL;
+    obj->style_prev = NULL;
+}
+#endif
+
 /**
  * Recursively refresh the style of the children. Go deeper until a not NULL style is found
  * because the NULL styles are inherited from the parent
@@ -2560,7 +2916,7 @@ static void delete_children(lv_obj_t * obj)
 {
     lv_obj_t * i;
     lv_obj_t * i_next;
-    i = lv_ll_get_head(&(obj->child_ll));
+    i = LV_OBJ_CHILD_TOP(obj);
 
     /*Remove from the group; remove before transversing children so that
      * the object still has access to all children during the
@@ -2572,7 +2928,7 @@ static void delete_children(lv_obj_t * obj)
 
     while(i != NULL) {
         /*Get the next object before delete this*/
-        i_next = lv_ll_get_next(&(obj->child_ll), i);
+        i_next = LV_OBJ_CHILD_BELOW(obj, i);
 
         /*Call the recursive del to the child too*/
         delete_children(i);
@@ -2586,6 +2942,10 @@ static void delete_children(lv_obj_t * obj)
 
     lv_event_mark_deleted(obj);
 
+#if LV_USE_CMDQ
+    lv_cmdq_remove_obj(obj);
+#endif
+
     /*Remove the animations from this object*/
 #if LV_USE_ANIMATION
     lv_anim_del(obj, NULL);
@@ -2613,9 +2973,22 @@ static void delete_children(lv_obj_t * obj)
     /* Clean up the object specific data*/
     obj->signal_cb(obj, LV_SIGNAL_CLEANUP, NULL);
 
+#if LV_USE_OBJ_STYLE_INDEX
+    style_index_rem(obj);
+#endif
+
+#if LV_USE_OBJ_LAYER_CACHE
+    if(obj->layer_cache) lv_refr_set_layer_cache(obj, false);
+#endif
+
     /*Remove the object from parent's children list*/
     lv_obj_t * par = lv_obj_get_parent(obj);
+#if LV_USE_OBJ_CHILD_ARRAY
+    child_arr_rem(par, obj);
+    lv_mem_free(obj->child_arr);
+#else
     lv_ll_rem(&(par->child_ll), obj);
+#endif
 
     /*Delete the base objects*/
     if(obj->ext_attr != NULL) lv_mem_free(obj->ext_attr);
@@ -186,29 +186,24 @@ typedef uint8_t lv_drag_dir_t;
 
 typedef struct _lv_obj_t
 {
+    /*Frequently used fields first to keep them close to each other*/
     struct _lv_obj_t * par; /**< Pointer to the parent object*/
+#if LV_USE_OBJ_CHILD_ARRAY
+    struct _lv_obj_t ** child_arr; /**< The children in drawing order (the last is on the top)*/
+#else
     lv_ll_t child_ll;       /**< Linked list to store the children objects*/
+#endif
 
     lv_area_t coords; /**< Coordinates of the object (x1, y1, x2, y2)*/
 
-    lv_event_cb_t event_cb; /**< Event callback function */
-    lv_signal_cb_t signal_cb; /**< Object type specific signal function*/
     lv_design_cb_t design_cb; /**< Object type specific design function*/
+    lv_signal_cb_t signal_cb; /**< Object type specific signal function*/
 
     void * ext_attr;            /**< Object type specific extended data*/
     const lv_style_t * style_p; /**< Pointer to the object's style*/
 
-#if LV_USE_GROUP != 0
-    void * group_p; /**< Pointer to the group of the object*/
-#endif
-
-#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
-    uint8_t ext_click_pad_hor; /**< Extra click padding in horizontal direction */
-    uint8_t ext_click_pad_ver; /**< Extra click padding in vertical direction */
-#endif
-
-#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
-    lv_area_t ext_click_pad;   /**< Extra click padding area. */
+#if LV_USE_OBJ_STYLE_CACHE
+    const lv_style_t * style_cache; /**< The inherited style returned by `lv_obj_get_style`. NULL: not resolved yet*/
 #endif
 
     /*Attributes and states*/
@@ -222,13 +217,42 @@ typedef struct _lv_obj_t
     uint8_t parent_event : 1;   /**< 1: Send the object's events to the parent too. */
     lv_drag_dir_t drag_dir : 2; /**<  Which directions the object can be dragged in */
     lv_bidi_dir_t base_dir : 2; /**< Base direction of texts related to this object */
-    uint8_t reserved : 3;       /**<  Reserved for future use*/
+    uint8_t layer_cache : 1;    /**< 1: Draw the object and its children from a saved image if possible*/
+    uint8_t scroll_blit : 1;    /**< 1: Not invalidated when moved. Its `LV_SIGNAL_CORD_CHG` handles it
+                                     (e.g. to move the rendered pixels and redraw only the uncovered parts)*/
+    uint8_t reserved : 1;       /**<  Reserved for future use*/
     uint8_t protect;            /**< Automatically happening actions can be prevented. 'OR'ed values from
                                    `lv_protect_t`*/
     lv_opa_t opa_scale;         /**< Scale down the opacity by this factor. Effects all children as well*/
 
     lv_coord_t ext_draw_pad; /**< EXTtend the size in every direction for drawing. */
 
+#if LV_USE_OBJ_CHILD_ARRAY
+    uint16_t child_cnt; /**< Number of elements in `child_arr`*/
+    uint16_t child_id;  /**< Index of the object in the parent's `child_arr`*/
+#endif
+
+    /*Rarely used fields*/
+    lv_event_cb_t event_cb; /**< Event callback function */
+
+#if LV_USE_GROUP != 0
+    void * group_p; /**< Pointer to the group of the object*/
+#endif
+
+#if LV_USE_OBJ_STYLE_INDEX
+    struct _lv_obj_t * style_next; /**< Next object in the style index with a similar style*/
+    struct _lv_obj_t * style_prev; /**< Previous object in the style index with a similar style*/
+#endif
+
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_TINY
+    uint8_t ext_click_pad_hor; /**< Extra click padding in horizontal direction */
+    uint8_t ext_click_pad_ver; /**< Extra click padding in vertical direction */
+#endif
+
+#if LV_USE_EXT_CLICK_AREA == LV_EXT_CLICK_AREA_FULL
+    lv_area_t ext_click_pad;   /**< Extra click padding area. */
+#endif
+
 #if LV_USE_OBJ_REALIGN
     lv_reailgn_t realign;       /**< Information about the last call to ::lv_obj_align. */
 #endif
@@ -470,6 +494,13 @@ void lv_obj_refresh_style(lv_obj_t * obj);
  */
 void lv_obj_report_style_mod(lv_style_t * style);
 
+/**
+ * Clean the cached styles of an object and its children. They will be resolved again when used.
+ * Called by the library when the parent or the focus state of an object changes.
+ * @param obj pointer to an object
+ */
+void lv_obj_clean_style_cache(lv_obj_t * obj);
+
 /*-----------------
  * Attribute set
  *----------------*/
@@ -550,6 +581,17 @@ void lv_obj_set_opa_scale_enable(lv_obj_t * obj, bool en);
  */
 void lv_obj_set_opa_scale(lv_obj_t * obj, lv_opa_t opa_scale);
 
+#if LV_USE_OBJ_LAYER_CACHE
+/**
+ * Save the rendered image of an object and its children and draw it instead of the objects
+ * while they are not invalidated. Useful for complex but static parts of the screen.
+ * Needs `width x height x sizeof(lv_color_t)` bytes memory. Not used with `set_px_cb`.
+ * @param obj pointer to an object
+ * @param en true: enable the layer cache; false: disable it and free the saved image
+ */
+void lv_obj_set_layer_cache(lv_obj_t * obj, bool en);
+#endif
+
 /**
  * Set a bit or bits in the protect filed
  * @param obj pointer to an object
@@ -889,6 +931,15 @@ lv_opa_t lv_obj_get_opa_scale_enable(const lv_obj_t * obj);
  */
 lv_opa_t lv_obj_get_opa_scale(const lv_obj_t * obj);
 
+#if LV_USE_OBJ_LAYER_CACHE
+/**
+ * Get whether the layer cache is enabled on an object
+ * @param obj pointer to an object
+ * @return true: the layer cache is enabled
+ */
+bool lv_obj_get_layer_cache(const lv_obj_t * obj);
+#endif
+
 /**
  * Get the protect field of an object
  * @param obj pointer to an object
@@ -1018,6 +1069,35 @@ lv_res_t lv_obj_handle_get_type_signal(lv_obj_type_t * buf, const char * name);
  */
 #define LV_EVENT_CB_DECLARE(name) void name(lv_obj_t * obj, lv_event_t e)
 
+/*
+ * Walk the children of an object without checking the parent.
+ * TOP is the lastly created (drawn as last) child, BOTTOM is the oldest child.
+ * Use `lv_obj_get_child()` and `lv_obj_get_child_back()` in the applications.
+ */
+#if LV_USE_OBJ_CHILD_ARRAY
+#define LV_OBJ_CHILD_TOP(obj) ((obj)->child_cnt ? (obj)->child_arr[(obj)->child_cnt - 1] : NULL)
+#define LV_OBJ_CHILD_BOTTOM(obj) ((obj)->child_cnt ? (obj)->child_arr[0] : NULL)
+#define LV_OBJ_CHILD_BELOW(obj, child) ((child)->child_id ? (obj)->child_arr[(child)->child_id - 1] : NULL)
+#define LV_OBJ_CHILD_ABOVE(obj, child)                                                                                 \
+    ((child)->child_id + 1 < (obj)->child_cnt ? (obj)->child_arr[(child)->child_id + 1] : NULL)
+#else
+#define LV_OBJ_CHILD_TOP(obj) ((lv_obj_t *)lv_ll_get_head(&(obj)->child_ll))
+#define LV_OBJ_CHILD_BOTTOM(obj) ((lv_obj_t *)lv_ll_get_tail(&(obj)->child_ll))
+#define LV_OBJ_CHILD_BELOW(obj, child) ((lv_obj_t *)lv_ll_get_next(&(obj)->child_ll, child))
+#define LV_OBJ_CHILD_ABOVE(obj, child) ((lv_obj_t *)lv_ll_get_prev(&(obj)->child_ll, child))
+#endif
+
+/*Iterate the children from the top to the bottom (like `LV_LL_READ` on a linked list)*/
+#define LV_OBJ_CHILD_READ(obj, i) for(i = LV_OBJ_CHILD_TOP(obj); i != NULL; i = LV_OBJ_CHILD_BELOW(obj, i))
+
+/*Iterate the children from the bottom to the top, i.e. in drawing order*/
+#define LV_OBJ_CHILD_READ_BACK(obj, i) for(i = LV_OBJ_CHILD_BOTTOM(obj); i != NULL; i = LV_OBJ_CHILD_ABOVE(obj, i))
+
+#if LV_MEM_TRACE
+/*Trace the extended data at the object types (e.g. in `lv_btn.c`) instead of in `lv_obj.c`*/
+#define lv_obj_allocate_ext_attr(obj, ext_size) (lv_mem_trace_site(__FILE__, __LINE__), lv_obj_allocate_ext_attr(obj, ext_size))
+#endif
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -0,0 +1,364 @@
+/**
+ * @file lv_prof.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_prof.h"
+#if LV_USE_PROF
+
+#include <string.h>
+#include "../lv_hal/lv_hal_tick.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_printf.h"
+#include "../lv_core/lv_debug.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+enum {
+    LV_PROF_CAT_FRAME,
+    LV_PROF_CAT_OBJ,
+    LV_PROF_CAT_DRAW,
+    LV_PROF_CAT_FLUSH,
+};
+typedef uint8_t lv_prof_cat_t;
+
+/*A recorded trace event*/
+typedef struct
+{
+    const char * name;
+    uint32_t start;
+    uint32_t dur;
+    uint32_t px; /*Number of pixels for frames and draw primitives*/
+    lv_prof_cat_t cat;
+} lv_prof_event_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_prof_type_stat_t * lv_prof_get_type(const lv_obj_t * obj);
+static void lv_prof_trace_add(const char * name, lv_prof_cat_t cat, uint32_t start, uint32_t dur, uint32_t px);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_prof_time_cb_t custom_time_cb;
+static lv_prof_frame_cb_t custom_frame_cb;
+static lv_prof_frame_t frame_act;
+static lv_prof_frame_t frame_last;
+static bool frame_ip;
+static uint32_t trace_cnt;
+static uint32_t trace_max;
+static uint32_t trace_dropped;
+
+static const char * const draw_names[_LV_PROF_DRAW_NUM] = {"lv_draw_rect", "lv_draw_label", "lv_draw_img",
+                                                           "lv_draw_line", "lv_draw_arc"};
+static const char * const cat_names[] = {"frame", "obj", "draw", "flush"};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the profiler
+ */
+void lv_prof_init(void)
+{
+    custom_time_cb  = NULL;
+    custom_frame_cb = NULL;
+    frame_ip        = false;
+    memset(&frame_last, 0, sizeof(lv_prof_frame_t));
+
+    LV_GC_ROOT(_lv_prof_trace) = NULL;
+    trace_cnt                  = 0;
+    trace_max                  = 0;
+    trace_dropped              = 0;
+}
+
+/**
+ * Set a microsecond resolution clock. By default `lv_tick_get()` is used which is too coarse
+ * to measure the objects and draw primitives.
+ * @param time_cb a function returning the current time in microseconds. NULL to use the tick.
+ */
+void lv_prof_set_time_cb(lv_prof_time_cb_t time_cb)
+{
+    custom_time_cb = time_cb;
+}
+
+/**
+ * Set a function to call when the measurement of a frame is ready
+ * @param frame_cb the callback. NULL to not use it.
+ */
+void lv_prof_set_frame_cb(lv_prof_frame_cb_t frame_cb)
+{
+    custom_frame_cb = frame_cb;
+}
+
+/**
+ * Get the statistics of the last refreshed frame
+ * @return pointer to the statistics. Its content is updated on every refresh.
+ */
+const lv_prof_frame_t * lv_prof_get_frame(void)
+{
+    return &frame_last;
+}
+
+/**
+ * Start recording every object drawing, draw primitive and flush as a trace event
+ * @param event_max max. number of events to record. The later events are dropped.
+ * @return true: started; false: out of memory
+ */
+bool lv_prof_trace_start(uint32_t event_max)
+{
+    lv_prof_trace_stop();
+
+    LV_GC_ROOT(_lv_prof_trace) = lv_mem_alloc(event_max * sizeof(lv_prof_event_t));
+    LV_ASSERT_MEM(LV_GC_ROOT(_lv_prof_trace));
+    if(LV_GC_ROOT(_lv_prof_trace) == NULL) return false;
+
+    trace_max = event_max;
+    return true;
+}
+
+/**
+ * Stop recording and free the trace
+ */
+void lv_prof_trace_stop(void)
+{
+    if(LV_GC_ROOT(_lv_prof_trace)) lv_mem_free(LV_GC_ROOT(_lv_prof_trace));
+
+    LV_GC_ROOT(_lv_prof_trace) = NULL;
+    trace_cnt                  = 0;
+    trace_max                  = 0;
+    trace_dropped              = 0;
+}
+
+/**
+ * Dump the recorded trace in the Chrome Trace Event format (JSON).
+ * It can be opened with `chrome://tracing` or other trace viewers.
+ * @param write_cb called with the parts of the JSON text
+ * @param user_data passed to `write_cb`
+ */
+void lv_prof_trace_dump(lv_prof_write_cb_t write_cb, void * user_data)
+{
+    char buf[160];
+    const lv_prof_event_t * events = LV_GC_ROOT(_lv_prof_trace);
+
+    write_cb("{\"traceEvents\":[\n", user_data);
+
+    uint32_t i;
+    for(i = 0; i < trace_cnt; i++) {
+        const lv_prof_event_t * e = &events[i];
+        lv_snprintf(buf, sizeof(buf), "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":0,\"tid\":0",
+                    i == 0 ? "" : ",\n", e->name, cat_names[e->cat], (unsigned long)e->start, (unsigned long)e->dur);
+        write_cb(buf, user_data);
+
+        if(e->cat == LV_PROF_CAT_FRAME || e->cat == LV_PROF_CAT_DRAW) {
+            lv_snprintf(buf, sizeof(buf), ",\"args\":{\"px\":%lu}", (unsigned long)e->px);
+            write_cb(buf, user_data);
+        }
+        write_cb("}", user_data);
+    }
+
+    lv_snprintf(buf, sizeof(buf), "\n],\"displayTimeUnit\":\"ms\",\"otherData\":{\"dropped\":%lu}}\n",
+                (unsigned long)trace_dropped);
+    write_cb(buf, user_data);
+}
+
+/**
+ * Get the current time
+ * @return the current time in microseconds
+ */
+uint32_t lv_prof_get_time(void)
+{
+    if(custom_time_cb) return custom_time_cb();
+
+    return lv_tick_get() * 1000;
+}
+
+/**
+ * Start measuring the refresh of a display
+ * @param disp pointer to the refreshed display
+ */
+void lv_prof_frame_start(lv_disp_t * disp)
+{
+    memset(&frame_act, 0, sizeof(lv_prof_frame_t));
+    frame_act.disp  = disp;
+    frame_act.start = lv_prof_get_time();
+    frame_ip        = true;
+}
+
+/**
+ * Finish measuring the refresh started with `lv_prof_frame_start()`
+ */
+void lv_prof_frame_end(void)
+{
+    if(frame_ip == false) return;
+    frame_ip = false;
+
+    /*Nothing was refreshed*/
+    if(frame_act.inv_cnt == 0) return;
+
+    frame_act.time = lv_prof_get_time() - frame_act.start;
+    lv_prof_trace_add("refresh", LV_PROF_CAT_FRAME, frame_act.start, frame_act.time, frame_act.px);
+
+    memcpy(&frame_last, &frame_act, sizeof(lv_prof_frame_t));
+    if(custom_frame_cb) custom_frame_cb(&frame_last);
+}
+
+/**
+ * Save the result of joining the invalidated areas
+ * @param disp pointer to the refreshed display with joined areas
+ */
+void lv_prof_join(const lv_disp_t * disp)
+{
+    frame_act.inv_cnt = disp->inv_p;
+
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i]) continue;
+
+        frame_act.area_cnt++;
+        frame_act.px += lv_area_get_size(&disp->inv_areas[i]);
+    }
+}
+
+/**
+ * Save the time of flushing
+ * @param start when the flushing or waiting for it was started (`lv_prof_get_time()`)
+ */
+void lv_prof_flush(uint32_t start)
+{
+    if(frame_ip == false) return;
+
+    uint32_t dur = lv_prof_get_time() - start;
+    frame_act.flush_time += dur;
+    lv_prof_trace_add("flush", LV_PROF_CAT_FLUSH, start, dur, 0);
+}
+
+/**
+ * Save the time of a `design_cb` call
+ * @param obj pointer to the drawn object
+ * @param start when `design_cb` was called (`lv_prof_get_time()`)
+ */
+void lv_prof_design(const lv_obj_t * obj, uint32_t start)
+{
+    if(frame_ip == false) return;
+
+    uint32_t dur = lv_prof_get_time() - start;
+
+    /*If there is no more space for a new type trace it as a base object*/
+    const char * name            = "lv_obj";
+    lv_prof_type_stat_t * t_stat = lv_prof_get_type(obj);
+    if(t_stat) {
+        t_stat->time += dur;
+        t_stat->cnt++;
+        name = t_stat->type;
+    }
+
+    lv_prof_trace_add(name, LV_PROF_CAT_OBJ, start, dur, 0);
+}
+
+/**
+ * Save the time of a draw primitive
+ * @param draw the type of the primitive
+ * @param start when the drawing was started (`lv_prof_get_time()`)
+ * @param coords the area of the primitive
+ * @param mask the area to draw on
+ */
+void lv_prof_draw(lv_prof_draw_t draw, uint32_t start, const lv_area_t * coords, const lv_area_t * mask)
+{
+    if(frame_ip == false) return;
+
+    uint32_t dur = lv_prof_get_time() - start;
+    uint32_t px  = 0;
+    lv_area_t draw_area;
+    if(lv_area_intersect(&draw_area, coords, mask)) px = lv_area_get_size(&draw_area);
+
+    lv_prof_draw_stat_t * d_stat = &frame_act.draw[draw];
+    d_stat->time += dur;
+    d_stat->cnt++;
+    d_stat->px += px;
+
+    lv_prof_trace_add(draw_names[draw], LV_PROF_CAT_DRAW, start, dur, px);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get the statistics of the type of an object in the current frame. Add it if not exists yet.
+ * @param obj pointer to an object
+ * @return pointer to the statistics or NULL if there is no space for a new type
+ */
+static lv_prof_type_stat_t * lv_prof_get_type(const lv_obj_t * obj)
+{
+    uint16_t i;
+    for(i = 0; i < frame_act.type_cnt; i++) {
+        if(frame_act.type[i].design_cb == obj->design_cb) return &frame_act.type[i];
+    }
+
+    if(frame_act.type_cnt >= LV_PROF_TYPE_MAX) return NULL;
+
+    lv_prof_type_stat_t * t_stat = &frame_act.type[frame_act.type_cnt];
+    frame_act.type_cnt++;
+    t_stat->design_cb = obj->design_cb;
+    t_stat->type      = "lv_obj";
+
+    /*Use the name of the first ancestor with type (e.g. a page's scrollable has no type)*/
+    lv_obj_type_t types;
+    lv_obj_get_type(obj, &types);
+    for(i = 0; i < LV_MAX_ANCESTOR_NUM && types.type[i] != NULL; i++) {
+        if(types.type[i][0] != '\0') {
+            t_stat->type = types.type[i];
+            break;
+        }
+    }
+
+    return t_stat;
+}
+
+/**
+ * Add an event to the trace if it's recorded
+ * @param name name of the event
+ * @param cat category of the event
+ * @param start start time of the event [us]
+ * @param dur duration of the event [us]
+ * @param px number of pixels related to the event
+ */
+static void lv_prof_trace_add(const char * name, lv_prof_cat_t cat, uint32_t start, uint32_t dur, uint32_t px)
+{
+    if(LV_GC_ROOT(_lv_prof_trace) == NULL) return;
+
+    if(trace_cnt >= trace_max) {
+        trace_dropped++;
+        return;
+    }
+
+    lv_prof_event_t * e = &((lv_prof_event_t *)LV_GC_ROOT(_lv_prof_trace))[trace_cnt];
+    e->name             = name;
+    e->cat              = cat;
+    e->start            = start;
+    e->dur              = dur;
+    e->px               = px;
+    trace_cnt++;
+}
+
+#endif /*LV_USE_PROF*/
@@ -0,0 +1,187 @@
+/**
+ * @file lv_prof.h
+ * Measure where the rendering time is spent
+ */
+
+#ifndef LV_PROF_H
+#define LV_PROF_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+
+#if LV_USE_PROF
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The measured draw primitives*/
+enum {
+    LV_PROF_DRAW_RECT,
+    LV_PROF_DRAW_LABEL,
+    LV_PROF_DRAW_IMG,
+    LV_PROF_DRAW_LINE,
+    LV_PROF_DRAW_ARC,
+    _LV_PROF_DRAW_NUM
+};
+typedef uint8_t lv_prof_draw_t;
+
+/** Statistics of a draw primitive in a frame*/
+typedef struct
+{
+    uint32_t time; /**< Time spent in the draw function [us]*/
+    uint32_t cnt;  /**< Number of calls*/
+    uint32_t px;   /**< Number of pixels on the area of the drawn primitives (truncated to the mask)*/
+} lv_prof_draw_stat_t;
+
+/** Statistics of an object type in a frame*/
+typedef struct
+{
+    lv_design_cb_t design_cb; /**< The design function of the object type*/
+    const char * type;        /**< Name of the type, e.g. "lv_btn"*/
+    uint32_t time;            /**< Time spent in `design_cb` without the children [us]*/
+    uint32_t cnt;             /**< Number of `design_cb` calls*/
+} lv_prof_type_stat_t;
+
+/** Statistics of a refresh of a display*/
+typedef struct
+{
+    lv_disp_t * disp;    /**< The refreshed display*/
+    uint32_t start;      /**< Start of the refresh [us]*/
+    uint32_t time;       /**< Duration of the refresh [us]*/
+    uint32_t flush_time; /**< Time spent in `flush_cb` and waiting for the flushing to be ready [us]*/
+    uint32_t px;         /**< Number of redrawn pixels (size of the joined areas)*/
+    uint16_t inv_cnt;    /**< Number of invalidated areas*/
+    uint16_t area_cnt;   /**< Number of areas remained after joining the invalidated areas*/
+    lv_prof_draw_stat_t draw[_LV_PROF_DRAW_NUM]; /**< Indexed by `lv_prof_draw_t`*/
+    lv_prof_type_stat_t type[LV_PROF_TYPE_MAX];  /**< The drawn object types*/
+    uint16_t type_cnt;                           /**< Number of used elements in `type`*/
+} lv_prof_frame_t;
+
+/** Get the current time in microseconds*/
+typedef uint32_t (*lv_prof_time_cb_t)(void);
+
+/** Called when a frame is measured*/
+typedef void (*lv_prof_frame_cb_t)(const lv_prof_frame_t * frame);
+
+/** Write a part of the dumped trace*/
+typedef void (*lv_prof_write_cb_t)(const char * txt, void * user_data);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the profiler
+ */
+void lv_prof_init(void);
+
+/**
+ * Set a microsecond resolution clock. By default `lv_tick_get()` is used which is too coarse
+ * to measure the objects and draw primitives.
+ * @param time_cb a function returning the current time in microseconds. NULL to use the tick.
+ */
+void lv_prof_set_time_cb(lv_prof_time_cb_t time_cb);
+
+/**
+ * Set a function to call when the measurement of a frame is ready
+ * @param frame_cb the callback. NULL to not use it.
+ */
+void lv_prof_set_frame_cb(lv_prof_frame_cb_t frame_cb);
+
+/**
+ * Get the statistics of the last refreshed frame
+ * @return pointer to the statistics. Its content is updated on every refresh.
+ */
+const lv_prof_frame_t * lv_prof_get_frame(void);
+
+/**
+ * Start recording every object drawing, draw primitive and flush as a trace event
+ * @param event_max max. number of events to record. The later events are dropped.
+ * @return true: started; false: out of memory
+ */
+bool lv_prof_trace_start(uint32_t event_max);
+
+/**
+ * Stop recording and free the trace
+ */
+void lv_prof_trace_stop(void);
+
+/**
+ * Dump the recorded trace in the Chrome Trace Event format (JSON).
+ * It can be opened with `chrome://tracing` or other trace viewers.
+ * @param write_cb called with the parts of the JSON text
+ * @param user_data passed to `write_cb`
+ */
+void lv_prof_trace_dump(lv_prof_write_cb_t write_cb, void * user_data);
+
+/*-------------------------
+ * Used by the library
+ *-------------------------*/
+
+/**
+ * Get the current time
+ * @return the current time in microseconds
+ */
+uint32_t lv_prof_get_time(void);
+
+/**
+ * Start measuring the refresh of a display
+ * @param disp pointer to the refreshed display
+ */
+void lv_prof_frame_start(lv_disp_t * disp);
+
+/**
+ * Finish measuring the refresh started with `lv_prof_frame_start()`
+ */
+void lv_prof_frame_end(void);
+
+/**
+ * Save the result of joining the invalidated areas
+ * @param disp pointer to the refreshed display with joined areas
+ */
+void lv_prof_join(const lv_disp_t * disp);
+
+/**
+ * Save the time of flushing
+ * @param start when the flushing or waiting for it was started (`lv_prof_get_time()`)
+ */
+void lv_prof_flush(uint32_t start);
+
+/**
+ * Save the time of a `design_cb` call
+ * @param obj pointer to the drawn object
+ * @param start when `design_cb` was called (`lv_prof_get_time()`)
+ */
+void lv_prof_design(const lv_obj_t * obj, uint32_t start);
+
+/**
+ * Save the time of a draw primitive
+ * @param draw the type of the primitive
+ * @param start when the drawing was started (`lv_prof_get_time()`)
+ * @param coords the area of the primitive
+ * @param mask the area to draw on
+ */
+void lv_prof_draw(lv_prof_draw_t draw, uint32_t start, const lv_area_t * coords, const lv_area_t * mask);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PROF*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_PROF_H*/
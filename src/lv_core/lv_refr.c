@@ -9,12 +9,19 @@
 #include <stddef.h>
 #include "lv_refr.h"
 #include "lv_disp.h"
+#include "lv_prof.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "../lv_hal/lv_hal_disp.h"
 #include "../lv_misc/lv_task.h"
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_gc.h"
+#include "../lv_misc/lv_math.h"
+#include "../lv_misc/lv_anim.h"
 #include "../lv_draw/lv_draw.h"
+#include "../lv_core/lv_debug.h"
+#if LV_USE_CONT
+#include "../lv_objx/lv_cont.h"
+#endif
 
 #if defined(LV_GC_INCLUDE)
 #include LV_GC_INCLUDE
@@ -26,9 +33,52 @@
 /* Draw translucent random colored areas on the invalidated (redrawn) areas*/
 #define MASK_AREA_DEBUG 0
 
+#if LV_USE_PARALLEL_REFR
+#if LV_MEM_CUSTOM == 0
+#error "LV_USE_PARALLEL_REFR requires LV_MEM_CUSTOM 1 with a thread safe allocator"
+#endif
+#if LV_ENABLE_GC
+#error "LV_USE_PARALLEL_REFR is not supported with LV_ENABLE_GC"
+#endif
+#if LV_USE_PROF
+#error "LV_USE_PARALLEL_REFR is not supported with LV_USE_PROF"
+#endif
+#if LV_MEM_TRACE
+#error "LV_USE_PARALLEL_REFR is not supported with LV_MEM_TRACE"
+#endif
+#if LV_USE_FRAME_SYNC
+#error "LV_USE_PARALLEL_REFR is not supported with LV_USE_FRAME_SYNC"
+#endif
+#endif
+
+/*The deferred layouts are refreshed before rendering. Not with parallel refresh because the objects can't
+ *be modified while only a read lock is held (`lv_task_handler()` refreshes them before the refresh tasks)*/
+#define REFR_LAYOUT_FLUSH (LV_USE_CONT && LV_CONT_DEFER_LAYOUT && LV_USE_PARALLEL_REFR == 0)
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_REFR_OCCLUDER_MAX > 0
+/*An opaque object which hides the objects drawn before it*/
+typedef struct
+{
+    lv_obj_t * obj;
+    lv_area_t area; /*The area covered by `obj`*/
+    uint8_t drawn : 1; /*1: `obj` is already drawn so it doesn't cover the objects drawn from now*/
+} lv_refr_occluder_t;
+#endif
+
+#if LV_USE_OBJ_LAYER_CACHE
+/*The saved image of an object and its children*/
+typedef struct
+{
+    lv_obj_t * obj;
+    lv_img_dsc_t img;   /*The object as it was drawn. `img.data` is NULL until the first drawing*/
+    lv_area_t area;     /*Coordinates of the image: the object's coordinates with `ext_draw_pad`*/
+    lv_area_t inv_area; /*The part of the image which is invalidated or not saved yet*/
+    uint8_t inv : 1;    /*1: `inv_area` is used*/
+} lv_refr_layer_cache_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -41,12 +91,49 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p);
 static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p);
 static void lv_refr_vdb_flush(void);
+static void lv_refr_flush_wait(lv_disp_buf_t * vdb);
+#if LV_USE_FLUSH_BATCH
+static bool lv_refr_is_batched(void);
+#endif
+#if LV_REFR_OCCLUDER_MAX > 0
+static void lv_refr_occluders_collect(lv_obj_t * top_p, const lv_area_t * mask_p);
+static void lv_refr_occluders_collect_obj(lv_obj_t * obj, const lv_area_t * mask_p);
+static bool lv_refr_occluders_apply(lv_obj_t * obj, lv_area_t * mask_p);
+#endif
+#if LV_USE_OBJ_LAYER_CACHE
+static lv_refr_layer_cache_t * lv_refr_layer_cache_get(const lv_obj_t * obj);
+static bool lv_refr_layer_cache_is_inv(lv_refr_layer_cache_t * cache, const lv_area_t * area_p);
+static bool lv_refr_layer_cache_is_any_inv(const lv_area_t * area_p);
+static bool lv_refr_layer_cache_covers(const lv_obj_t * obj, const lv_area_t * area_p);
+static void lv_refr_layer_cache_save(lv_refr_layer_cache_t * cache, const lv_area_t * mask_p);
+static void lv_refr_layer_cache_get_area(const lv_obj_t * obj, lv_area_t * area_p);
+static bool lv_refr_obj_is_above(const lv_obj_t * obj, const lv_obj_t * base);
+#endif
+#if LV_USE_SCROLL_BLIT
+static bool lv_refr_scroll(lv_area_t * dest_p);
+static bool lv_refr_scroll_is_covered(const lv_obj_t * obj, const lv_area_t * area_p);
+#endif
+#if LV_USE_FRAME_SYNC
+static uint32_t lv_refr_get_present_time(void);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static uint32_t px_num;
-static lv_disp_t * disp_refr; /*Display being refreshed*/
+/*The state of the refreshing is per thread with `LV_USE_PARALLEL_REFR`,
+ *so every display refreshed from an other thread has its own*/
+static LV_REFR_LOCAL uint32_t px_num;
+static LV_REFR_LOCAL lv_disp_t * disp_refr; /*Display being refreshed*/
+#if LV_REFR_OCCLUDER_MAX > 0
+static LV_REFR_LOCAL lv_refr_occluder_t occluders[LV_REFR_OCCLUDER_MAX];
+static LV_REFR_LOCAL uint8_t occluder_cnt;
+#endif
+#if LV_USE_FLUSH_BATCH
+static LV_REFR_LOCAL lv_disp_flush_rect_t flush_batch[LV_FLUSH_BATCH_MAX];
+static LV_REFR_LOCAL uint16_t flush_batch_cnt;
+static LV_REFR_LOCAL uint32_t flush_batch_px;      /*Number of pixels used by the batched areas in the VDB*/
+static LV_REFR_LOCAL lv_color_t * flush_batch_buf; /*The VDB the areas are rendered to*/
+#endif
 
 /**********************
  *      MACROS
@@ -61,7 +148,9 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
  */
 void lv_refr_init(void)
 {
-    /*Nothing to do*/
+#if LV_USE_OBJ_LAYER_CACHE
+    lv_ll_init(&LV_GC_ROOT(_lv_layer_cache_ll), sizeof(lv_refr_layer_cache_t));
+#endif
 }
 
 /**
@@ -69,16 +158,31 @@ void lv_refr_init(void)
  * Normally the redrawing is periodically executed in `lv_task_handler` but a long blocking process
  * can prevent the call of `lv_task_handler`. In this case if the the GUI is updated in the process
  * (e.g. progress bar) this function can be called when the screen should be updated.
+ * With `LV_USE_PARALLEL_REFR` every display can be refreshed from its own thread with this function.
+ * Disable the display's `refr_task` then (`lv_task_set_prio(disp->refr_task, LV_TASK_PRIO_OFF)`)
+ * and hold a read lock of the objects during the call. The objects can be modified (e.g. in
+ * `lv_task_handler()`) only while a write lock is held.
+ * With `LV_USE_FRAME_SYNC` it doesn't wait for the vertical sync.
  * @param disp pointer to display to refresh. NULL to refresh all displays.
  */
 void lv_refr_now(lv_disp_t * disp)
 {
+#if REFR_LAYOUT_FLUSH
+    lv_cont_layout_flush(); /*Don't draw outdated coordinates*/
+#endif
+
     if(disp) {
+#if LV_USE_FRAME_SYNC
+        disp->vsync_pending = 1;
+#endif
         lv_disp_refr_task(disp->refr_task);
     } else {
         lv_disp_t * d;
         d = lv_disp_get_next(NULL);
         while(d) {
+#if LV_USE_FRAME_SYNC
+            d->vsync_pending = 1;
+#endif
             lv_disp_refr_task(d->refr_task);
             d = lv_disp_get_next(d);
         }
@@ -99,6 +203,9 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Clear the invalidate buffer if the parameter is NULL*/
     if(area_p == NULL) {
         disp->inv_p = 0;
+#if LV_USE_SCROLL_BLIT
+        disp->scroll_p = 0;
+#endif
         return;
     }
 
@@ -134,6 +241,167 @@ void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     }
 }
 
+#if LV_USE_OBJ_LAYER_CACHE
+/**
+ * Enable or disable saving the rendered image of an object. Used by `lv_obj_set_layer_cache()`.
+ * @param obj pointer to an object
+ * @param en true: enable; false: disable and free the saved image
+ * @return true: success; false: out of memory
+ */
+bool lv_refr_set_layer_cache(lv_obj_t * obj, bool en)
+{
+    lv_refr_layer_cache_t * cache = lv_refr_layer_cache_get(obj);
+
+    if(en) {
+        if(cache) return true;
+
+        /*The image is allocated when the object is drawn first*/
+        cache = lv_ll_ins_head(&LV_GC_ROOT(_lv_layer_cache_ll));
+        LV_ASSERT_MEM(cache);
+        if(cache == NULL) return false;
+
+        memset(cache, 0, sizeof(lv_refr_layer_cache_t));
+        cache->obj           = obj;
+        cache->img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    } else if(cache) {
+        lv_mem_free((void *)cache->img.data);
+        lv_ll_rem(&LV_GC_ROOT(_lv_layer_cache_ll), cache);
+        lv_mem_free(cache);
+    }
+
+    return true;
+}
+
+/**
+ * Mark an area of the saved object images invalid if it was invalidated by an object
+ * drawn below or inside the cached object. Used by `lv_obj_invalidate_area()`.
+ * @param obj pointer to the invalidated object
+ * @param area_p the invalidated area
+ */
+void lv_refr_inv_layer_cache(const lv_obj_t * obj, const lv_area_t * area_p)
+{
+    lv_refr_layer_cache_t * cache;
+    LV_LL_READ(LV_GC_ROOT(_lv_layer_cache_ll), cache)
+    {
+        /*Without image the whole object will be drawn anyway*/
+        if(cache->img.data == NULL) continue;
+        if(lv_area_is_on(area_p, &cache->area) == false) continue;
+
+        /*The objects drawn later are drawn onto the image so they don't change it*/
+        if(lv_refr_obj_is_above(obj, cache->obj)) continue;
+
+        if(cache->inv) {
+            lv_area_join(&cache->inv_area, &cache->inv_area, area_p);
+        } else {
+            lv_area_copy(&cache->inv_area, area_p);
+            cache->inv = 1;
+        }
+    }
+}
+#endif
+
+#if LV_USE_SCROLL_BLIT
+/**
+ * Move the already rendered content of an area in the next refresh instead of redrawing it.
+ * Only the uncovered parts and the invalidated areas (on their original and moved position) are redrawn.
+ * Used by `lv_page` to scroll.
+ * @param obj pointer to the moved object. The objects drawn after it can't be on `area_p`.
+ * @param area_p the area to move. Everything drawn on it has to move together with `obj`.
+ * @param x_ofs move the content horizontally with this value
+ * @param y_ofs move the content vertically with this value
+ * @return true: the content will be moved; false: it can't be moved, the area should be invalidated
+ */
+bool lv_refr_scroll_area(const lv_obj_t * obj, const lv_area_t * area_p, lv_coord_t x_ofs, lv_coord_t y_ofs)
+{
+    if(lv_obj_get_hidden(obj)) return false;
+
+    lv_obj_t * obj_scr = lv_obj_get_screen(obj);
+    lv_disp_t * disp   = lv_obj_get_disp(obj_scr);
+    if(obj_scr != lv_disp_get_scr_act(disp) && obj_scr != lv_disp_get_layer_top(disp) &&
+       obj_scr != lv_disp_get_layer_sys(disp)) {
+        return false;
+    }
+
+    /*The rendered pixels are available only in a true double buffer or on the display*/
+    if(lv_disp_is_true_double_buf(disp) == false && disp->driver.copy_area_cb == NULL) return false;
+
+    /*Truncate the area to the visible part*/
+    lv_area_t area;
+    area.x1 = 0;
+    area.y1 = 0;
+    area.x2 = lv_disp_get_hor_res(disp) - 1;
+    area.y2 = lv_disp_get_ver_res(disp) - 1;
+    if(lv_area_intersect(&area, &area, area_p) == false) return false;
+
+    const lv_obj_t * par;
+    for(par = obj->par; par != NULL; par = par->par) {
+        if(lv_area_intersect(&area, &area, &par->coords) == false) return false;
+        if(lv_obj_get_hidden(par)) return false;
+    }
+
+    /*Only one area can be moved in a refresh*/
+    if(disp->scroll_p && memcmp(&area, &disp->scroll_area, sizeof(lv_area_t)) != 0) return false;
+
+    /*Nothing to save if the whole area is redrawn anyway*/
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(lv_area_is_in(&area, &disp->inv_areas[i])) return false;
+    }
+
+    if(lv_refr_scroll_is_covered(obj, &area)) return false;
+
+#if LV_USE_OBJ_LAYER_CACHE
+    /*The saved images are updated only on the redrawn areas*/
+    lv_refr_layer_cache_t * cache;
+    LV_LL_READ(LV_GC_ROOT(_lv_layer_cache_ll), cache)
+    {
+        if(cache->img.data && lv_area_is_on(&cache->area, &area)) return false;
+    }
+#endif
+
+    /*The invalidated areas are moved with the content. Redraw them on the new position too.
+     * (The areas added here are already on their new position)*/
+    uint16_t inv_p = disp->inv_p;
+    lv_area_t inv_area;
+    for(i = 0; i < inv_p; i++) {
+        if(lv_area_intersect(&inv_area, &disp->inv_areas[i], &area) == false) continue;
+
+        inv_area.x1 += x_ofs;
+        inv_area.y1 += y_ofs;
+        inv_area.x2 += x_ofs;
+        inv_area.y2 += y_ofs;
+        if(lv_area_intersect(&inv_area, &inv_area, &area)) lv_inv_area(disp, &inv_area);
+    }
+
+    /*Redraw the uncovered parts*/
+    if(y_ofs != 0) {
+        lv_area_copy(&inv_area, &area);
+        if(y_ofs > 0) inv_area.y2 = LV_MATH_MIN(area.y1 + y_ofs - 1, area.y2);
+        else inv_area.y1 = LV_MATH_MAX(area.y2 + y_ofs + 1, area.y1);
+        lv_inv_area(disp, &inv_area);
+    }
+
+    if(x_ofs != 0) {
+        lv_area_copy(&inv_area, &area);
+        if(x_ofs > 0) inv_area.x2 = LV_MATH_MIN(area.x1 + x_ofs - 1, area.x2);
+        else inv_area.x1 = LV_MATH_MAX(area.x2 + x_ofs + 1, area.x1);
+        lv_inv_area(disp, &inv_area);
+    }
+
+    if(disp->scroll_p == 0) {
+        lv_area_copy(&disp->scroll_area, &area);
+        disp->scroll_x = 0;
+        disp->scroll_y = 0;
+        disp->scroll_p = 1;
+    }
+
+    disp->scroll_x += x_ofs;
+    disp->scroll_y += y_ofs;
+
+    return true;
+}
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
@@ -166,10 +434,47 @@ void lv_disp_refr_task(lv_task_t * task)
 
     disp_refr = task->user_data;
 
+#if LV_USE_FRAME_SYNC
+    /*Start rendering right after the vertical sync if the display signals it*/
+    if(disp_refr->driver.vsync) {
+        if(disp_refr->vsync_pending == 0) return;
+        disp_refr->vsync_pending = 0;
+    }
+
+#if LV_USE_ANIMATION
+    /*Step the animations to the time when the new frame will be visible*/
+    lv_anim_refr_now(lv_refr_get_present_time());
+#endif
+#endif
+
+#if REFR_LAYOUT_FLUSH
+    /*Refresh the deferred layouts (also the ones changed by the animations) before drawing*/
+    lv_cont_layout_flush();
+#endif
+
+#if LV_USE_PROF
+    lv_prof_frame_start(disp_refr);
+#endif
+
+#if LV_USE_SCROLL_BLIT
+    /*Move the still valid pixels before redrawing the rest*/
+    lv_area_t scroll_area;
+    bool scrolled = lv_refr_scroll(&scroll_area);
+#endif
+
     lv_refr_join_area();
 
+#if LV_USE_PROF
+    lv_prof_join(disp_refr);
+#endif
+
     lv_refr_areas();
 
+#if LV_USE_FLUSH_BATCH
+    /*Flush the areas remained in the batch*/
+    if(lv_refr_is_batched()) lv_refr_vdb_flush();
+#endif
+
     /*If refresh happened ...*/
     if(disp_refr->inv_p != 0) {
         /*In true double buffered mode copy the refreshed areas to the new VDB to keep it up to
@@ -183,8 +488,7 @@ void lv_disp_refr_task(lv_task_t * task)
             /* With true double buffering the flushing should be only the address change of the
              * current frame buffer. Wait until the address change is ready and copy the changed
              * content to the other frame buffer (new active VDB) to keep the buffers synchronized*/
-            while(vdb->flushing)
-                ;
+            lv_refr_flush_wait(vdb);
 
             uint8_t * buf_act = (uint8_t *)vdb->buf_act;
             uint8_t * buf_ina = (uint8_t *)vdb->buf_act == vdb->buf1 ? vdb->buf2 : vdb->buf1;
@@ -204,6 +508,20 @@ void lv_disp_refr_task(lv_task_t * task)
                     }
                 }
             }
+
+#if LV_USE_SCROLL_BLIT
+            /*The moved pixels are changed too*/
+            if(scrolled) {
+                lv_coord_t y;
+                uint32_t start_offs  = (hres * scroll_area.y1 + scroll_area.x1) * sizeof(lv_color_t);
+                uint32_t line_length = lv_area_get_width(&scroll_area) * sizeof(lv_color_t);
+
+                for(y = scroll_area.y1; y <= scroll_area.y2; y++) {
+                    memcpy(buf_act + start_offs, buf_ina + start_offs, line_length);
+                    start_offs += hres * sizeof(lv_color_t);
+                }
+            }
+#endif
         } /*End of true double buffer handling*/
 
         /*Clean up*/
@@ -211,6 +529,10 @@ void lv_disp_refr_task(lv_task_t * task)
         memset(disp_refr->inv_area_joined, 0, sizeof(disp_refr->inv_area_joined));
         disp_refr->inv_p = 0;
 
+#if LV_USE_FRAME_SYNC
+        disp_refr->render_time = lv_tick_elaps(start);
+#endif
+
         /*Call monitor cb if present*/
         if(disp_refr->driver.monitor_cb) {
             disp_refr->driver.monitor_cb(&disp_refr->driver, lv_tick_elaps(start), px_num);
@@ -219,6 +541,10 @@ void lv_disp_refr_task(lv_task_t * task)
 
     lv_draw_free_buf();
 
+#if LV_USE_PROF
+    lv_prof_frame_end();
+#endif
+
     LV_LOG_TRACE("lv_refr_task: ready");
 }
 
@@ -376,12 +702,36 @@ static void lv_refr_area_part(const lv_area_t * area_p)
 
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
+#if LV_USE_FLUSH_BATCH
+    bool batched = lv_refr_is_batched();
+    if(batched) {
+        /*Flush the batch if this part doesn't fit after the already rendered ones*/
+        if(flush_batch_cnt > 0 && (flush_batch_px + lv_area_get_size(&vdb->area) > vdb->size ||
+                                   flush_batch_cnt >= LV_FLUSH_BATCH_MAX)) {
+            lv_refr_vdb_flush();
+        }
+
+        /*A new batch is started*/
+        if(flush_batch_cnt == 0) {
+            if(lv_disp_is_double_buf(disp_refr) == false) lv_refr_flush_wait(vdb);
+            flush_batch_buf = vdb->buf_act;
+        }
+
+        /*Render the part after the previous ones*/
+        vdb->buf_act = flush_batch_buf + flush_batch_px;
+    }
+    /*In non double buffered mode, before rendering the next part wait until the previous image is
+     * flushed*/
+    else if(lv_disp_is_double_buf(disp_refr) == false) {
+        lv_refr_flush_wait(vdb);
+    }
+#else
     /*In non double buffered mode, before rendering the next part wait until the previous image is
      * flushed*/
     if(lv_disp_is_double_buf(disp_refr) == false) {
-        while(vdb->flushing)
-            ;
+        lv_refr_flush_wait(vdb);
     }
+#endif
 
     lv_obj_t * top_p;
 
@@ -393,13 +743,39 @@ static void lv_refr_area_part(const lv_area_t * area_p)
     /*Get the most top object which is not covered by others*/
     top_p = lv_refr_get_top_obj(&start_mask, lv_disp_get_scr_act(disp_refr));
 
+#if LV_REFR_OCCLUDER_MAX > 0
+    /*Find the opaque objects above the top object to not draw the objects hidden by them*/
+    lv_refr_occluders_collect(top_p, &start_mask);
+#if LV_USE_OBJ_LAYER_CACHE
+    /*The cached objects need to be fully drawn to save their image*/
+    if(lv_refr_layer_cache_is_any_inv(&start_mask)) occluder_cnt = 0;
+#endif
+#endif
+
     /*Do the refreshing from the top object*/
     lv_refr_obj_and_children(top_p, &start_mask);
 
+#if LV_REFR_OCCLUDER_MAX > 0
+    /*The layers are drawn without occlusion culling*/
+    occluder_cnt = 0;
+#endif
+
     /*Also refresh top and sys layer unconditionally*/
     lv_refr_obj_and_children(lv_disp_get_layer_top(disp_refr), &start_mask);
     lv_refr_obj_and_children(lv_disp_get_layer_sys(disp_refr), &start_mask);
 
+#if LV_USE_FLUSH_BATCH
+    /*Add the rendered part to the batch instead of flushing it*/
+    if(batched) {
+        flush_batch[flush_batch_cnt].area    = vdb->area;
+        flush_batch[flush_batch_cnt].color_p = vdb->buf_act;
+        flush_batch_cnt++;
+        flush_batch_px += lv_area_get_size(&vdb->area);
+        vdb->buf_act = flush_batch_buf;
+        return;
+    }
+#endif
+
     /* In true double buffered mode flush only once when all areas were rendered.
      * In normal mode flush after every area */
     if(lv_disp_is_true_double_buf(disp_refr) == false) {
@@ -419,8 +795,20 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 
     /*If this object is fully cover the draw area check the children too */
     if(lv_area_is_in(area_p, &obj->coords) && obj->hidden == 0) {
+#if LV_USE_OBJ_LAYER_CACHE
+        /*The children of a cached object can be drawn only together with it*/
+        if(obj->layer_cache) {
+            const lv_style_t * style = lv_obj_get_style(obj);
+            if(lv_refr_layer_cache_covers(obj, area_p) ||
+               (style->body.opa == LV_OPA_COVER && obj->design_cb(obj, area_p, LV_DESIGN_COVER_CHK) != false &&
+                lv_obj_get_opa_scale(obj) == LV_OPA_COVER)) {
+                found_p = obj;
+            }
+            return found_p;
+        }
+#endif
         lv_obj_t * i;
-        LV_LL_READ(obj->child_ll, i)
+        LV_OBJ_CHILD_READ(obj, i)
         {
             found_p = lv_refr_get_top_obj(area_p, i);
 
@@ -467,16 +855,22 @@ static void lv_refr_obj_and_children(lv_obj_t * top_p, const lv_area_t * mask_p)
     /*Do until not reach the screen*/
     while(par != NULL) {
         /*object before border_p has to be redrawn*/
-        lv_obj_t * i = lv_ll_get_prev(&(par->child_ll), border_p);
+        lv_obj_t * i = LV_OBJ_CHILD_ABOVE(par, border_p);
 
         while(i != NULL) {
             /*Refresh the objects*/
             lv_refr_obj(i, mask_p);
-            i = lv_ll_get_prev(&(par->child_ll), i);
+            i = LV_OBJ_CHILD_ABOVE(par, i);
         }
 
         /*Call the post draw design function of the parents of the to object*/
+#if LV_USE_PROF
+        uint32_t prof_start = lv_prof_get_time();
+#endif
         par->design_cb(par, mask_p, LV_DESIGN_DRAW_POST);
+#if LV_USE_PROF
+        lv_prof_design(par, prof_start);
+#endif
 
         /*The new border will be there last parents,
          *so the 'younger' brothers of parent will be refreshed*/
@@ -512,12 +906,43 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
 
     /*Draw the parent and its children only if they ore on 'mask_parent'*/
     if(union_ok != false) {
+#if LV_USE_OBJ_LAYER_CACHE
+        lv_refr_layer_cache_t * cache = obj->layer_cache ? lv_refr_layer_cache_get(obj) : NULL;
+        if(cache && lv_refr_layer_cache_is_inv(cache, &obj_ext_mask) == false) {
+            /*Draw the saved image instead of the object and its children*/
+            lv_area_t img_mask;
+            lv_area_copy(&img_mask, &obj_ext_mask);
+#if LV_REFR_OCCLUDER_MAX > 0
+            if(lv_refr_occluders_apply(obj, &img_mask) == false) return;
+#endif
+            lv_draw_map(&cache->area, &img_mask, cache->img.data, LV_OPA_COVER, false, false, LV_COLOR_BLACK,
+                        LV_OPA_TRANSP);
+            return;
+        }
+#endif
 
-        /* Redraw the object */
+        /* Redraw the object if it's not hidden by an opaque object drawn later*/
+#if LV_REFR_OCCLUDER_MAX > 0
+        lv_area_t obj_main_mask;
+        lv_area_copy(&obj_main_mask, &obj_ext_mask);
+#if LV_USE_PROF
+        uint32_t prof_start = lv_prof_get_time();
+#endif
+        if(lv_refr_occluders_apply(obj, &obj_main_mask)) {
+            obj->design_cb(obj, &obj_main_mask, LV_DESIGN_DRAW_MAIN);
+        }
+#else
+#if LV_USE_PROF
+        uint32_t prof_start = lv_prof_get_time();
+#endif
         obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_MAIN);
+#endif
+#if LV_USE_PROF
+        lv_prof_design(obj, prof_start);
+#endif
 
 #if MASK_AREA_DEBUG
-        static lv_color_t debug_color = LV_COLOR_RED;
+        static LV_REFR_LOCAL lv_color_t debug_color = LV_COLOR_RED;
         lv_draw_fill(&obj_ext_mask, &obj_ext_mask, debug_color, LV_OPA_50);
         debug_color.full *= 17;
         debug_color.full += 0xA1;
@@ -529,7 +954,7 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
             lv_area_t mask_child; /*Mask from obj and its child*/
             lv_obj_t * child_p;
             lv_area_t child_area;
-            LV_LL_READ_BACK(obj->child_ll, child_p)
+            LV_OBJ_CHILD_READ_BACK(obj, child_p)
             {
                 lv_obj_get_coords(child_p, &child_area);
                 ext_size = child_p->ext_draw_pad;
@@ -550,10 +975,478 @@ static void lv_refr_obj(lv_obj_t * obj, const lv_area_t * mask_ori_p)
         }
 
         /* If all the children are redrawn make 'post draw' design */
+#if LV_USE_PROF
+        prof_start = lv_prof_get_time();
+#endif
         obj->design_cb(obj, &obj_ext_mask, LV_DESIGN_DRAW_POST);
+#if LV_USE_PROF
+        lv_prof_design(obj, prof_start);
+#endif
+
+#if LV_USE_OBJ_LAYER_CACHE
+        /*Save what was drawn to use it next time*/
+        if(cache) lv_refr_layer_cache_save(cache, &obj_ext_mask);
+#endif
+    }
+}
+
+#if LV_REFR_OCCLUDER_MAX > 0
+/**
+ * Collect the opaque objects in the order they will be drawn by `lv_refr_obj_and_children`
+ * @param top_p pointer to the object where the drawing starts
+ * @param mask_p pointer to the area to refresh
+ */
+static void lv_refr_occluders_collect(lv_obj_t * top_p, const lv_area_t * mask_p)
+{
+    occluder_cnt = 0;
+
+    if(top_p == NULL) top_p = lv_disp_get_scr_act(disp_refr);
+
+    lv_refr_occluders_collect_obj(top_p, mask_p);
+
+    /*Check the 'younger' siblings of the top object and its parents too*/
+    lv_obj_t * border_p = top_p;
+    lv_obj_t * par      = lv_obj_get_parent(top_p);
+    while(par != NULL) {
+        lv_obj_t * i = LV_OBJ_CHILD_ABOVE(par, border_p);
+        while(i != NULL) {
+            lv_refr_occluders_collect_obj(i, mask_p);
+            i = LV_OBJ_CHILD_ABOVE(par, i);
+        }
+
+        border_p = par;
+        par      = lv_obj_get_parent(par);
     }
 }
 
+/**
+ * Add an object and its children to the occluders if they fully cover their visible area.
+ * If there is no more free place replace the smallest occluder if the new one is larger.
+ * @param obj pointer to an object
+ * @param mask_p the area where `obj` is visible (truncated by its parents)
+ */
+static void lv_refr_occluders_collect_obj(lv_obj_t * obj, const lv_area_t * mask_p)
+{
+    if(obj->hidden != 0) return;
+
+    lv_area_t obj_mask;
+    if(lv_area_intersect(&obj_mask, mask_p, &obj->coords) == false) return;
+
+    const lv_style_t * style = lv_obj_get_style(obj);
+    bool cover = style->body.opa == LV_OPA_COVER && obj->design_cb(obj, &obj_mask, LV_DESIGN_COVER_CHK) != false &&
+                 lv_obj_get_opa_scale(obj) == LV_OPA_COVER;
+#if LV_USE_OBJ_LAYER_CACHE
+    /*The saved image contains the background too so it's opaque*/
+    if(obj->layer_cache && lv_refr_layer_cache_covers(obj, &obj_mask)) cover = true;
+#endif
+
+    if(cover) {
+        lv_refr_occluder_t * occ = NULL;
+        if(occluder_cnt < LV_REFR_OCCLUDER_MAX) {
+            occ = &occluders[occluder_cnt];
+            occluder_cnt++;
+        } else {
+            uint8_t i;
+            uint32_t size = lv_area_get_size(&obj_mask);
+            for(i = 0; i < LV_REFR_OCCLUDER_MAX; i++) {
+                if(lv_area_get_size(&occluders[i].area) < size) {
+                    occ  = &occluders[i];
+                    size = lv_area_get_size(&occluders[i].area);
+                }
+            }
+        }
+
+        if(occ) {
+            occ->obj   = obj;
+            occ->drawn = 0;
+            lv_area_copy(&occ->area, &obj_mask);
+        }
+    }
+
+#if LV_USE_OBJ_LAYER_CACHE
+    /*The children of a cached object are drawn only together with it*/
+    if(obj->layer_cache) return;
+#endif
+
+    lv_obj_t * child_p;
+    LV_OBJ_CHILD_READ_BACK(obj, child_p)
+    {
+        lv_refr_occluders_collect_obj(child_p, &obj_mask);
+    }
+}
+
+/**
+ * Remove the parts of an object's draw area which are covered by opaque objects drawn after it.
+ * Only the parts making the remaining area a rectangle can be removed.
+ * @param obj pointer to an object to draw
+ * @param mask_p the draw area of `obj`. Will be truncated.
+ * @return true: `obj` needs to be drawn on the truncated `mask_p`; false: `obj` is fully covered
+ */
+static bool lv_refr_occluders_apply(lv_obj_t * obj, lv_area_t * mask_p)
+{
+    uint8_t i;
+
+    /*An occluder covers only the objects drawn before it*/
+    for(i = 0; i < occluder_cnt; i++) {
+        if(occluders[i].obj == obj) occluders[i].drawn = 1;
+    }
+
+    for(i = 0; i < occluder_cnt; i++) {
+        if(occluders[i].drawn) continue;
+
+        const lv_area_t * occ = &occluders[i].area;
+        if(lv_area_is_on(occ, mask_p) == false) continue;
+
+        /*Fully covered*/
+        if(lv_area_is_in(mask_p, occ)) return false;
+
+        /*Covered on the whole width: cut the top or bottom*/
+        if(occ->x1 <= mask_p->x1 && occ->x2 >= mask_p->x2) {
+            if(occ->y1 <= mask_p->y1) mask_p->y1 = occ->y2 + 1;
+            else if(occ->y2 >= mask_p->y2) mask_p->y2 = occ->y1 - 1;
+        }
+        /*Covered on the whole height: cut the left or right*/
+        else if(occ->y1 <= mask_p->y1 && occ->y2 >= mask_p->y2) {
+            if(occ->x1 <= mask_p->x1) mask_p->x1 = occ->x2 + 1;
+            else if(occ->x2 >= mask_p->x2) mask_p->x2 = occ->x1 - 1;
+        }
+    }
+
+    return true;
+}
+#endif
+
+#if LV_USE_OBJ_LAYER_CACHE
+/**
+ * Get the layer cache of an object
+ * @param obj pointer to an object
+ * @return pointer to the layer cache or NULL if not found
+ */
+static lv_refr_layer_cache_t * lv_refr_layer_cache_get(const lv_obj_t * obj)
+{
+    lv_refr_layer_cache_t * cache;
+    LV_LL_READ(LV_GC_ROOT(_lv_layer_cache_ll), cache)
+    {
+        if(cache->obj == obj) return cache;
+    }
+
+    return NULL;
+}
+
+/**
+ * Check whether the saved image of an object can't be used on an area
+ * @param cache pointer to a layer cache
+ * @param area_p the area to draw
+ * @return true: the image is missing or outdated on `area_p`; false: the image can be drawn
+ */
+static bool lv_refr_layer_cache_is_inv(lv_refr_layer_cache_t * cache, const lv_area_t * area_p)
+{
+    if(cache->img.data == NULL) return true;
+
+    /*The object has been moved or resized since it was saved*/
+    lv_area_t obj_area;
+    lv_refr_layer_cache_get_area(cache->obj, &obj_area);
+    if(memcmp(&obj_area, &cache->area, sizeof(lv_area_t)) != 0) return true;
+
+    if(cache->inv && lv_area_is_on(area_p, &cache->inv_area)) return true;
+
+    return false;
+}
+
+/**
+ * Check whether any cached object needs to be saved again on an area of the refreshed display
+ * @param area_p the area to draw
+ * @return true: at least one cached object will be drawn normally on `area_p`
+ */
+static bool lv_refr_layer_cache_is_any_inv(const lv_area_t * area_p)
+{
+    lv_obj_t * scr_act   = lv_disp_get_scr_act(disp_refr);
+    lv_obj_t * layer_top = lv_disp_get_layer_top(disp_refr);
+    lv_obj_t * layer_sys = lv_disp_get_layer_sys(disp_refr);
+
+    lv_refr_layer_cache_t * cache;
+    lv_area_t obj_area;
+    LV_LL_READ(LV_GC_ROOT(_lv_layer_cache_ll), cache)
+    {
+        lv_refr_layer_cache_get_area(cache->obj, &obj_area);
+        if(lv_area_is_on(area_p, &obj_area) == false) continue;
+
+        lv_obj_t * scr = lv_obj_get_screen(cache->obj);
+        if(scr != scr_act && scr != layer_top && scr != layer_sys) continue;
+
+        if(lv_refr_layer_cache_is_inv(cache, area_p)) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Check whether an object has a saved image which can be drawn on an area
+ * @param obj pointer to an object
+ * @param area_p the area to draw
+ * @return true: the saved image will be drawn, which fully covers `area_p`
+ */
+static bool lv_refr_layer_cache_covers(const lv_obj_t * obj, const lv_area_t * area_p)
+{
+    lv_refr_layer_cache_t * cache = lv_refr_layer_cache_get(obj);
+    if(cache == NULL) return false;
+
+    return lv_refr_layer_cache_is_inv(cache, area_p) ? false : true;
+}
+
+/**
+ * Copy the drawn pixels of a cached object from the VDB to its image
+ * @param cache pointer to a layer cache
+ * @param mask_p the area where the object was drawn
+ */
+static void lv_refr_layer_cache_save(lv_refr_layer_cache_t * cache, const lv_area_t * mask_p)
+{
+    /*The VDB has unknown format*/
+    if(disp_refr->driver.set_px_cb) return;
+
+    lv_area_t obj_area;
+    lv_refr_layer_cache_get_area(cache->obj, &obj_area);
+
+    /*Allocate a new image if the object was resized. Reuse the old if it's large enough*/
+    if(cache->img.data == NULL || memcmp(&obj_area, &cache->area, sizeof(lv_area_t)) != 0) {
+        uint32_t size = lv_area_get_size(&obj_area) * sizeof(lv_color_t);
+        if(lv_mem_get_size(cache->img.data) < size) {
+            lv_mem_free((void *)cache->img.data);
+            cache->img.data = lv_mem_alloc(size);
+            if(cache->img.data == NULL) {
+                LV_LOG_WARN("lv_refr_layer_cache_save: out of memory, the object is drawn normally");
+                return;
+            }
+        }
+
+        lv_area_copy(&cache->area, &obj_area);
+        cache->img.header.w  = lv_area_get_width(&obj_area);
+        cache->img.header.h  = lv_area_get_height(&obj_area);
+        cache->img.data_size = size;
+
+        /*The image is used only when all of its visible part has been saved. It can take more refreshes
+         * if an other object covers the cached object or only some parts of it are refreshed.*/
+        lv_area_t vis_area;
+        vis_area.x1 = 0;
+        vis_area.y1 = 0;
+        vis_area.x2 = lv_disp_get_hor_res(disp_refr) - 1;
+        vis_area.y2 = lv_disp_get_ver_res(disp_refr) - 1;
+        bool vis = lv_area_intersect(&vis_area, &vis_area, &obj_area);
+        const lv_obj_t * par;
+        for(par = cache->obj->par; par != NULL && vis; par = par->par) {
+            vis = lv_area_intersect(&vis_area, &vis_area, &par->coords);
+        }
+
+        lv_area_copy(&cache->inv_area, &vis_area);
+        cache->inv = vis ? 1 : 0;
+    }
+
+    lv_disp_buf_t * vdb  = lv_disp_get_buf(disp_refr);
+    lv_coord_t vdb_w     = lv_area_get_width(&vdb->area);
+    lv_coord_t img_w     = cache->img.header.w;
+    uint32_t line_length = lv_area_get_width(mask_p) * sizeof(lv_color_t);
+
+    lv_color_t * img_buf = (lv_color_t *)cache->img.data;
+    img_buf += (uint32_t)img_w * (mask_p->y1 - cache->area.y1) + (mask_p->x1 - cache->area.x1);
+
+    lv_color_t * vdb_buf = vdb->buf_act;
+    vdb_buf += (uint32_t)vdb_w * (mask_p->y1 - vdb->area.y1) + (mask_p->x1 - vdb->area.x1);
+
+    lv_coord_t y;
+    for(y = mask_p->y1; y <= mask_p->y2; y++) {
+        memcpy(img_buf, vdb_buf, line_length);
+        img_buf += img_w;
+        vdb_buf += vdb_w;
+    }
+
+    /*Remove the saved part from the invalid area. Keep the whole area if the rest is not a rectangle
+     * (the object is drawn normally and saved there again)*/
+    if(cache->inv == 0) return;
+
+    lv_area_t * inv = &cache->inv_area;
+    if(lv_area_is_in(inv, mask_p)) {
+        cache->inv = 0;
+    } else if(mask_p->x1 <= inv->x1 && mask_p->x2 >= inv->x2) {
+        if(mask_p->y1 <= inv->y1 && mask_p->y2 >= inv->y1) inv->y1 = mask_p->y2 + 1;
+        else if(mask_p->y1 <= inv->y2 && mask_p->y2 >= inv->y2) inv->y2 = mask_p->y1 - 1;
+    } else if(mask_p->y1 <= inv->y1 && mask_p->y2 >= inv->y2) {
+        if(mask_p->x1 <= inv->x1 && mask_p->x2 >= inv->x1) inv->x1 = mask_p->x2 + 1;
+        else if(mask_p->x1 <= inv->x2 && mask_p->x2 >= inv->x2) inv->x2 = mask_p->x1 - 1;
+    }
+}
+
+/**
+ * Get the area of an object where it and its children can draw
+ * @param obj pointer to an object
+ * @param area_p store the object's coordinates extended with `ext_draw_pad` here
+ */
+static void lv_refr_layer_cache_get_area(const lv_obj_t * obj, lv_area_t * area_p)
+{
+    lv_coord_t ext_size = obj->ext_draw_pad;
+    lv_obj_get_coords(obj, area_p);
+    area_p->x1 -= ext_size;
+    area_p->y1 -= ext_size;
+    area_p->x2 += ext_size;
+    area_p->y2 += ext_size;
+}
+
+/**
+ * Check whether an object is drawn after an other object and it's not its child.
+ * @param obj pointer to an object
+ * @param base pointer to an object
+ * @return true: `obj` is drawn onto `base` so it doesn't change how `base` looks
+ */
+static bool lv_refr_obj_is_above(const lv_obj_t * obj, const lv_obj_t * base)
+{
+    const lv_obj_t * obj_scr  = lv_obj_get_screen(obj);
+    const lv_obj_t * base_scr = lv_obj_get_screen(base);
+
+    /*The top layer is drawn after the screens and the system layer is the last*/
+    if(obj_scr != base_scr) {
+        lv_disp_t * disp = lv_obj_get_disp(base_scr);
+        if(lv_obj_get_disp(obj_scr) != disp) return true;
+        if(obj_scr == lv_disp_get_layer_sys(disp)) return true;
+        if(obj_scr == lv_disp_get_layer_top(disp) && base_scr != lv_disp_get_layer_sys(disp)) return true;
+        return false;
+    }
+
+    /*Go to the same depth. If an object is found in the other's parents they are not siblings*/
+    uint16_t obj_depth  = 0;
+    uint16_t base_depth = 0;
+    const lv_obj_t * i;
+    for(i = obj; i->par; i = i->par) obj_depth++;
+    for(i = base; i->par; i = i->par) base_depth++;
+
+    for(; obj_depth > base_depth; obj_depth--) obj = obj->par;
+    for(; base_depth > obj_depth; base_depth--) base = base->par;
+    if(obj == base) return false;
+
+    /*Find the ancestors which are siblings*/
+    while(obj->par != base->par) {
+        obj  = obj->par;
+        base = base->par;
+    }
+
+    /*The younger siblings are drawn later*/
+    for(i = LV_OBJ_CHILD_ABOVE(base->par, base); i != NULL; i = LV_OBJ_CHILD_ABOVE(base->par, i)) {
+        if(i == obj) return true;
+    }
+
+    return false;
+}
+#endif
+
+#if LV_USE_SCROLL_BLIT
+/**
+ * Move the rendered content of the refreshed display's scroll area (see `lv_refr_scroll_area()`)
+ * @param dest_p store the area of the moved pixels here
+ * @return true: the pixels are moved in the active VDB; false: no pixels or they are moved on the display
+ */
+static bool lv_refr_scroll(lv_area_t * dest_p)
+{
+    if(disp_refr->scroll_p == 0) return false;
+    disp_refr->scroll_p = 0;
+
+    lv_coord_t x_ofs = disp_refr->scroll_x;
+    lv_coord_t y_ofs = disp_refr->scroll_y;
+    if(x_ofs == 0 && y_ofs == 0) return false;
+
+    /*The part of the scroll area which remains visible after moving*/
+    const lv_area_t * area = &disp_refr->scroll_area;
+    dest_p->x1 = area->x1 + x_ofs;
+    dest_p->y1 = area->y1 + y_ofs;
+    dest_p->x2 = area->x2 + x_ofs;
+    dest_p->y2 = area->y2 + y_ofs;
+    if(lv_area_intersect(dest_p, dest_p, area) == false) return false;
+
+    /*Wait until the last flushing is ready to move what is really on the display*/
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
+    lv_refr_flush_wait(vdb);
+
+    if(lv_disp_is_true_double_buf(disp_refr) == false) {
+        lv_area_t src;
+        src.x1 = dest_p->x1 - x_ofs;
+        src.y1 = dest_p->y1 - y_ofs;
+        src.x2 = dest_p->x2 - x_ofs;
+        src.y2 = dest_p->y2 - y_ofs;
+        disp_refr->driver.copy_area_cb(&disp_refr->driver, &src, x_ofs, y_ofs);
+        return false;
+    }
+
+    /*Move the lines in the frame buffer. Go from the end if moving down to not overwrite the source.*/
+    uint8_t * buf        = (uint8_t *)vdb->buf_act;
+    lv_coord_t hres      = lv_disp_get_hor_res(disp_refr);
+    int32_t line_step    = hres * sizeof(lv_color_t);
+    uint32_t line_length = lv_area_get_width(dest_p) * sizeof(lv_color_t);
+    lv_coord_t y_start   = y_ofs > 0 ? dest_p->y2 : dest_p->y1;
+    int32_t dest_offs    = (hres * y_start + dest_p->x1) * sizeof(lv_color_t);
+    int32_t src_offs     = dest_offs - (hres * y_ofs + x_ofs) * (int32_t)sizeof(lv_color_t);
+    if(y_ofs > 0) line_step = -line_step;
+
+    lv_coord_t y;
+    for(y = dest_p->y1; y <= dest_p->y2; y++) {
+        memmove(buf + dest_offs, buf + src_offs, line_length);
+        dest_offs += line_step;
+        src_offs += line_step;
+    }
+
+    return true;
+}
+
+/**
+ * Check whether an object drawn after an other object is on an area
+ * @param obj pointer to an object
+ * @param area_p an area
+ * @return true: `area_p` is covered by a later drawn object; false: only `obj` and the objects below it are there
+ */
+static bool lv_refr_scroll_is_covered(const lv_obj_t * obj, const lv_area_t * area_p)
+{
+    lv_disp_t * disp = lv_obj_get_disp(obj);
+    lv_obj_t * layers[2];
+    uint8_t layer_cnt = 0;
+    lv_area_t ext_area;
+    const lv_obj_t * i;
+
+    /*The younger siblings of the object and its parents*/
+    for(; obj->par != NULL; obj = obj->par) {
+        for(i = LV_OBJ_CHILD_ABOVE(obj->par, obj); i != NULL; i = LV_OBJ_CHILD_ABOVE(obj->par, i)) {
+            if(i->hidden) continue;
+
+            lv_area_copy(&ext_area, &i->coords);
+            ext_area.x1 -= i->ext_draw_pad;
+            ext_area.y1 -= i->ext_draw_pad;
+            ext_area.x2 += i->ext_draw_pad;
+            ext_area.y2 += i->ext_draw_pad;
+            if(lv_area_is_on(&ext_area, area_p)) return true;
+        }
+    }
+
+    /*`obj` is a screen now. The top layer is drawn after the screens and the system layer is the last*/
+    if(obj != lv_disp_get_layer_sys(disp)) {
+        if(obj != lv_disp_get_layer_top(disp)) layers[layer_cnt++] = lv_disp_get_layer_top(disp);
+        layers[layer_cnt++] = lv_disp_get_layer_sys(disp);
+    }
+
+    while(layer_cnt > 0) {
+        layer_cnt--;
+        lv_obj_t * child;
+        LV_OBJ_CHILD_READ(layers[layer_cnt], child)
+        {
+            if(child->hidden) continue;
+
+            lv_area_copy(&ext_area, &child->coords);
+            ext_area.x1 -= child->ext_draw_pad;
+            ext_area.y1 -= child->ext_draw_pad;
+            ext_area.x2 += child->ext_draw_pad;
+            ext_area.y2 += child->ext_draw_pad;
+            if(lv_area_is_on(&ext_area, area_p)) return true;
+        }
+    }
+
+    return false;
+}
+#endif
+
 /**
  * Flush the content of the VDB
  */
@@ -561,18 +1454,35 @@ static void lv_refr_vdb_flush(void)
 {
     lv_disp_buf_t * vdb = lv_disp_get_buf(disp_refr);
 
+#if LV_USE_FLUSH_BATCH
+    bool batched = lv_refr_is_batched();
+    if(batched && flush_batch_cnt == 0) return;
+#endif
+
     /*In double buffered mode wait until the other buffer is flushed before flushing the current
      * one*/
     if(lv_disp_is_double_buf(disp_refr)) {
-        while(vdb->flushing)
-            ;
+        lv_refr_flush_wait(vdb);
     }
 
     vdb->flushing = 1;
 
     /*Flush the rendered content to the display*/
     lv_disp_t * disp = lv_refr_get_disp_refreshing();
+#if LV_USE_PROF
+    uint32_t prof_start = lv_prof_get_time();
+#endif
+#if LV_USE_FLUSH_BATCH
+    if(batched) {
+        disp->driver.flush_batch_cb(&disp->driver, flush_batch, flush_batch_cnt);
+        flush_batch_cnt = 0;
+        flush_batch_px  = 0;
+    } else
+#endif
     if(disp->driver.flush_cb) disp->driver.flush_cb(&disp->driver, &vdb->area, vdb->buf_act);
+#if LV_USE_PROF
+    lv_prof_flush(prof_start);
+#endif
 
     if(vdb->buf1 && vdb->buf2) {
         if(vdb->buf_act == vdb->buf1)
@@ -581,3 +1491,66 @@ static void lv_refr_vdb_flush(void)
             vdb->buf_act = vdb->buf1;
     }
 }
+
+/**
+ * Wait until the display buffer is flushed
+ * @param vdb pointer to the display buffer
+ */
+static void lv_refr_flush_wait(lv_disp_buf_t * vdb)
+{
+#if LV_USE_PROF
+    if(vdb->flushing == 0) return;
+    uint32_t prof_start = lv_prof_get_time();
+#endif
+
+    while(vdb->flushing)
+        ;
+
+#if LV_USE_PROF
+    lv_prof_flush(prof_start);
+#endif
+}
+
+#if LV_USE_FLUSH_BATCH
+/**
+ * Tell whether the rendered areas of the refreshed display are flushed in batches
+ * @return true: `flush_batch_cb` is used
+ */
+static bool lv_refr_is_batched(void)
+{
+    if(disp_refr->driver.flush_batch_cb == NULL) return false;
+    if(lv_disp_is_true_double_buf(disp_refr)) return false;
+
+    return true;
+}
+#endif
+
+#if LV_USE_FRAME_SYNC
+/**
+ * Predict when the frame rendered now will be visible on the refreshed display
+ * @return the expected time in `lv_tick_get()` time
+ */
+static uint32_t lv_refr_get_present_time(void)
+{
+    /*Suppose rendering takes as long as last time*/
+    uint32_t ready = lv_tick_get() + disp_refr->render_time;
+    if(disp_refr->driver.vsync == 0) return ready;
+
+    /*`lv_disp_vsync()` can interrupt here. It writes the time last so if the time didn't change
+     *the period belongs to it*/
+    uint32_t vsync_time;
+    uint32_t period;
+    do {
+        vsync_time = disp_refr->vsync_time;
+        period     = disp_refr->vsync_period;
+    } while(vsync_time != disp_refr->vsync_time);
+
+    if(period == 0) return ready;
+
+    /*The frame will be shown on the first vertical sync after it's ready*/
+    int32_t since = (int32_t)(ready - vsync_time);
+    if(since < 0) since = 0;
+
+    return vsync_time + (since / period + 1) * period;
+}
+#endif
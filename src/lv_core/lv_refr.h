@@ -50,6 +50,10 @@ void lv_refr_init(void);
  * Normally the redrawing is periodically executed in `lv_task_handler` but a long blocking process
  * can prevent the call of `lv_task_handler`. In this case if the the GUI is updated in the process
  * (e.g. progress bar) this function can be called when the screen should be updated.
+ * With `LV_USE_PARALLEL_REFR` every display can be refreshed from its own thread with this function.
+ * Disable the display's `refr_task` then (`lv_task_set_prio(disp->refr_task, LV_TASK_PRIO_OFF)`)
+ * and hold a read lock of the objects during the call. The objects can be modified (e.g. in
+ * `lv_task_handler()`) only while a write lock is held.
  * @param disp pointer to display to refresh. NULL to refresh all displays.
  */
 void lv_refr_now(lv_disp_t * disp);
@@ -62,6 +66,38 @@ void lv_refr_now(lv_disp_t * disp);
  */
 void lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p);
 
+#if LV_USE_OBJ_LAYER_CACHE
+/**
+ * Enable or disable saving the rendered image of an object. Used by `lv_obj_set_layer_cache()`.
+ * @param obj pointer to an object
+ * @param en true: enable; false: disable and free the saved image
+ * @return true: success; false: out of memory
+ */
+bool lv_refr_set_layer_cache(lv_obj_t * obj, bool en);
+
+/**
+ * Mark an area of the saved object images invalid if it was invalidated by an object
+ * drawn below or inside the cached object. Used by `lv_obj_invalidate_area()`.
+ * @param obj pointer to the invalidated object
+ * @param area_p the invalidated area
+ */
+void lv_refr_inv_layer_cache(const lv_obj_t * obj, const lv_area_t * area_p);
+#endif
+
+#if LV_USE_SCROLL_BLIT
+/**
+ * Move the already rendered content of an area in the next refresh instead of redrawing it.
+ * Only the uncovered parts and the invalidated areas (on their original and moved position) are redrawn.
+ * Used by `lv_page` to scroll.
+ * @param obj pointer to the moved object. The objects drawn after it can't be on `area_p`.
+ * @param area_p the area to move. Everything drawn on it has to move together with `obj`.
+ * @param x_ofs move the content horizontally with this value
+ * @param y_ofs move the content vertically with this value
+ * @return true: the content will be moved; false: it can't be moved, the area should be invalidated
+ */
+bool lv_refr_scroll_area(const lv_obj_t * obj, const lv_area_t * area_p, lv_coord_t x_ofs, lv_coord_t y_ofs);
+#endif
+
 /**
  * Get the display which is being refreshed
  * @return the display being refreshed
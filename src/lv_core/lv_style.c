@@ -75,6 +75,7 @@ void lv_style_init(void)
     lv_style_scr.body.opa            = LV_OPA_COVER;
     lv_style_scr.body.main_color     = LV_COLOR_WHITE;
     lv_style_scr.body.grad_color     = LV_COLOR_WHITE;
+    lv_style_scr.body.grad_dir       = LV_GRAD_DIR_VER;
     lv_style_scr.body.radius         = 0;
     lv_style_scr.body.padding.left   = 0;
     lv_style_scr.body.padding.right  = 0;
@@ -271,12 +272,14 @@ void lv_style_mix(const lv_style_t * start, const lv_style_t * end, lv_style_t *
         res->glass            = start->glass;
         res->text.font        = start->text.font;
         res->body.shadow.type = start->body.shadow.type;
+        res->body.grad_dir    = start->body.grad_dir;
         res->line.rounded     = start->line.rounded;
     } else {
         res->body.border.part = end->body.border.part;
         res->glass            = end->glass;
         res->text.font        = end->text.font;
         res->body.shadow.type = end->body.shadow.type;
+        res->body.grad_dir    = end->body.grad_dir;
         res->line.rounded     = end->line.rounded;
     }
 }
@@ -50,6 +50,13 @@ enum {
 };
 typedef uint8_t lv_shadow_type_t;
 
+/*Gradient directions*/
+enum {
+    LV_GRAD_DIR_VER = 0, /**< From `main_color` at the top to `grad_color` at the bottom*/
+    LV_GRAD_DIR_HOR,     /**< From `main_color` on the left to `grad_color` on the right*/
+};
+typedef uint8_t lv_grad_dir_t;
+
 /**
  * Objects in LittlevGL can be assigned a style - which holds information about
  * how the object should be drawn.
@@ -68,6 +75,7 @@ typedef struct
         lv_color_t grad_color; /**< Second color. If not equal to `main_color` a gradient will be drawn for the background. */
         lv_coord_t radius; /**< Object's corner radius. You can use #LV_RADIUS_CIRCLE if you want to draw a circle. */
         lv_opa_t opa; /**< Object's opacity (0-255). */
+        lv_grad_dir_t grad_dir; /**< Direction of the gradient from `main_color` to `grad_color` */
 
         struct
         {
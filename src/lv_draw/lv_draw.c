@@ -24,6 +24,14 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_USE_PARALLEL_REFR
+/*Every refresh thread has its own buffer*/
+#define DRAW_BUF draw_buf
+#define DRAW_MASK_BUF draw_mask_buf
+#else
+#define DRAW_BUF LV_GC_ROOT(_lv_draw_buf)
+#define DRAW_MASK_BUF LV_GC_ROOT(_lv_draw_mask_buf)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -36,7 +44,12 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
-static uint32_t draw_buf_size = 0;
+#if LV_USE_PARALLEL_REFR
+static LV_REFR_LOCAL void * draw_buf = NULL;
+static LV_REFR_LOCAL void * draw_mask_buf = NULL;
+#endif
+static LV_REFR_LOCAL uint32_t draw_buf_size = 0;
+static LV_REFR_LOCAL uint32_t draw_mask_buf_size = 0;
 
 /**********************
  *      MACROS
@@ -53,33 +66,58 @@ static uint32_t draw_buf_size = 0;
  */
 void * lv_draw_get_buf(uint32_t size)
 {
-    if(size <= draw_buf_size) return LV_GC_ROOT(_lv_draw_buf);
+    if(size <= draw_buf_size) return DRAW_BUF;
 
     LV_LOG_TRACE("lv_draw_get_buf: allocate");
 
     draw_buf_size = size;
 
-    if(LV_GC_ROOT(_lv_draw_buf) == NULL) {
-        LV_GC_ROOT(_lv_draw_buf) = lv_mem_alloc(size);
-        LV_ASSERT_MEM(LV_GC_ROOT(_lv_draw_buf));
-        return LV_GC_ROOT(_lv_draw_buf);
+    if(DRAW_BUF == NULL) {
+        DRAW_BUF = lv_mem_alloc(size);
+        LV_ASSERT_MEM(DRAW_BUF);
+        return DRAW_BUF;
     }
 
-    LV_GC_ROOT(_lv_draw_buf) = lv_mem_realloc(LV_GC_ROOT(_lv_draw_buf), size);
-    LV_ASSERT_MEM(LV_GC_ROOT(_lv_draw_buf));
-    return LV_GC_ROOT(_lv_draw_buf);
+    DRAW_BUF = lv_mem_realloc(DRAW_BUF, size);
+    LV_ASSERT_MEM(DRAW_BUF);
+    return DRAW_BUF;
+}
+
+/**
+ * Give a buffer for the coverage masks (e.g. of the letters of a line).
+ * It can be used together with the buffer of `lv_draw_get_buf`. Its content is not kept.
+ * @param size the required size
+ * @return pointer to the buffer or NULL if it can't be allocated
+ */
+void * lv_draw_get_mask_buf(uint32_t size)
+{
+    if(size <= draw_mask_buf_size) return DRAW_MASK_BUF;
+
+    LV_LOG_TRACE("lv_draw_get_mask_buf: allocate");
+
+    /*Not asserted: the callers can draw without the mask*/
+    lv_mem_free(DRAW_MASK_BUF);
+    DRAW_MASK_BUF      = lv_mem_alloc(size);
+    draw_mask_buf_size = DRAW_MASK_BUF ? size : 0;
+    return DRAW_MASK_BUF;
 }
 
 /**
- * Free the draw buffer
+ * Free the draw buffers
  */
 void lv_draw_free_buf(void)
 {
-    if(LV_GC_ROOT(_lv_draw_buf)) {
-        lv_mem_free(LV_GC_ROOT(_lv_draw_buf));
-        LV_GC_ROOT(_lv_draw_buf) = NULL;
+    if(DRAW_BUF) {
+        lv_mem_free(DRAW_BUF);
+        DRAW_BUF      = NULL;
         draw_buf_size = 0;
     }
+
+    if(DRAW_MASK_BUF) {
+        lv_mem_free(DRAW_MASK_BUF);
+        DRAW_MASK_BUF      = NULL;
+        draw_mask_buf_size = 0;
+    }
 }
 
 #if LV_ANTIALIAS
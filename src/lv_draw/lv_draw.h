@@ -26,6 +26,12 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*Prefix of the static variables used during rendering. With `LV_USE_PARALLEL_REFR` they are stored per thread.*/
+#if LV_USE_PARALLEL_REFR
+#define LV_REFR_LOCAL LV_ATTRIBUTE_THREAD_LOCAL
+#else
+#define LV_REFR_LOCAL
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -43,7 +49,15 @@ extern "C" {
 void * lv_draw_get_buf(uint32_t size);
 
 /**
- * Free the draw buffer
+ * Give a buffer for the coverage masks (e.g. of the letters of a line).
+ * It can be used together with the buffer of `lv_draw_get_buf`. Its content is not kept.
+ * @param size the required size
+ * @return pointer to the buffer or NULL if it can't be allocated
+ */
+void * lv_draw_get_mask_buf(uint32_t size);
+
+/**
+ * Free the draw buffers
  */
 void lv_draw_free_buf(void);
 
@@ -96,6 +110,8 @@ void lv_draw_aa_hor_seg(lv_coord_t x, lv_coord_t y, lv_coord_t length, const lv_
  *********************/
 #include "lv_draw_basic.h"
 #include "lv_draw_rect.h"
+#include "lv_draw_grad.h"
+#include "lv_draw_raster.h"
 #include "lv_draw_label.h"
 #include "lv_draw_img.h"
 #include "lv_draw_line.h"
@@ -1,6 +1,8 @@
 CSRCS += lv_draw_basic.c
 CSRCS += lv_draw.c
 CSRCS += lv_draw_rect.c
+CSRCS += lv_draw_grad.c
+CSRCS += lv_draw_raster.c
 CSRCS += lv_draw_label.c
 CSRCS += lv_draw_line.c
 CSRCS += lv_draw_img.c
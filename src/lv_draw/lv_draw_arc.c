@@ -8,6 +8,8 @@
  *********************/
 #include "lv_draw_arc.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_core/lv_prof.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -20,12 +22,17 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_DRAW_RASTER
+static void cap_to(lv_raster_path_t * path, int32_t cx, int32_t cy, int32_t r_mid, int32_t r_cap, int16_t angle,
+                   int16_t start_angle);
+#else
 static void ver_line(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_coord_t len, lv_color_t color,
                      lv_opa_t opa);
 static void hor_line(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_coord_t len, lv_color_t color,
                      lv_opa_t opa);
 static bool deg_test_norm(uint16_t deg, uint16_t start, uint16_t end);
 static bool deg_test_inv(uint16_t deg, uint16_t start, uint16_t end);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -47,12 +54,63 @@ static bool deg_test_inv(uint16_t deg, uint16_t start, uint16_t end);
  * @param mask the arc will be drawn only in this mask
  * @param start_angle the start angle of the arc (0 deg on the bottom, 90 deg on the right)
  * @param end_angle the end angle of the arc
- * @param style style of the arc (`body.thickness`, `body.main_color`, `body.opa` is used)
+ * @param style style of the arc (`line.width`, `line.color`, `line.rounded`, `body.opa` is used)
  * @param opa_scale scale down all opacities by the factor
  */
 void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, const lv_area_t * mask,
                  uint16_t start_angle, uint16_t end_angle, const lv_style_t * style, lv_opa_t opa_scale)
 {
+#if LV_USE_PROF
+    uint32_t prof_start = lv_prof_get_time();
+    lv_area_t prof_coords;
+    prof_coords.x1 = center_x - radius;
+    prof_coords.y1 = center_y - radius;
+    prof_coords.x2 = center_x + radius;
+    prof_coords.y2 = center_y + radius;
+#endif
+
+#if LV_USE_DRAW_RASTER
+    lv_coord_t thickness = style->line.width;
+    if(thickness > radius) thickness = radius;
+
+    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+    bool aa      = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
+
+    /*The center is the middle of the center pixel*/
+    int32_t cx    = LV_RASTER_PX(center_x);
+    int32_t cy    = LV_RASTER_PX(center_y);
+    int32_t r_out = (int32_t)radius * LV_RASTER_ONE;
+    int32_t r_in  = (int32_t)(radius - thickness) * LV_RASTER_ONE;
+
+    int16_t start = start_angle;
+    int16_t end   = end_angle;
+    if(end < start) end += 360;
+
+    lv_raster_path_t path;
+    lv_raster_path_init(&path);
+
+    if(end - start >= 360) {
+        /*A full ring. The inner circle in the opposite direction cuts the hole.*/
+        lv_raster_arc_to(&path, cx, cy, r_out, 0, 360);
+        if(r_in > 0) {
+            lv_raster_close(&path);
+            lv_raster_arc_to(&path, cx, cy, r_in, 360, 0);
+        }
+    } else if(r_in > 0) {
+        /*Go along the outer edge, the end, the inner edge backward and the start*/
+        int32_t r_cap = (r_out - r_in) / 2;
+        lv_raster_arc_to(&path, cx, cy, r_out, start, end);
+        if(style->line.rounded) cap_to(&path, cx, cy, r_out - r_cap, r_cap, end, end);
+        lv_raster_arc_to(&path, cx, cy, r_in, end, start);
+        if(style->line.rounded) cap_to(&path, cx, cy, r_out - r_cap, r_cap, start, start + 180);
+    } else {
+        /*A pie*/
+        lv_raster_arc_to(&path, cx, cy, r_out, start, end);
+        lv_raster_line_to(&path, cx, cy);
+    }
+
+    lv_raster_fill(&path, mask, style->line.color, opa, aa);
+#else
     lv_coord_t thickness = style->line.width;
     if(thickness > radius) thickness = radius;
 
@@ -213,11 +271,39 @@ void lv_draw_arc(lv_coord_t center_x, lv_coord_t center_y, uint16_t radius, cons
             hor_line(center_x - x_end[3], center_y - yi, mask, LV_MATH_ABS(x_end[3] - x_start[3]), color, opa);
         }
     }
+#endif
+
+#if LV_USE_PROF
+    lv_prof_draw(LV_PROF_DRAW_ARC, prof_start, &prof_coords, mask);
+#endif
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_USE_DRAW_RASTER
+/**
+ * Add a round end of an arc to a path: a half circle from the outer edge to the inner edge or back
+ * @param path pointer to a path whose last point is on an edge of the arc at `angle`
+ * @param cx x coordinate of the arc's center
+ * @param cy y coordinate of the arc's center
+ * @param r_mid radius of the middle of the arc
+ * @param r_cap half of the arc's thickness
+ * @param angle angle of the end
+ * @param start_angle `angle`: go from the outer to the inner edge; `angle + 180`: go from the inner to the outer edge
+ */
+static void cap_to(lv_raster_path_t * path, int32_t cx, int32_t cy, int32_t r_mid, int32_t r_cap, int16_t angle,
+                   int16_t start_angle)
+{
+    int32_t cap_x = cx + (((int64_t)r_mid * lv_trigo_sin(angle)) >> LV_TRIGO_SHIFT);
+    int32_t cap_y = cy + (((int64_t)r_mid * lv_trigo_sin(angle + 90)) >> LV_TRIGO_SHIFT);
+
+    lv_raster_arc_to(path, cap_x, cap_y, r_cap, start_angle, start_angle + 180);
+}
+
+#else
+
 static void ver_line(lv_coord_t x, lv_coord_t y, const lv_area_t * mask, lv_coord_t len, lv_color_t color, lv_opa_t opa)
 {
     lv_area_t area;
@@ -249,3 +335,4 @@ static bool deg_test_inv(uint16_t deg, uint16_t start, uint16_t end)
     } else
         return false;
 }
+#endif
@@ -15,6 +15,7 @@
 #include "../lv_misc/lv_area.h"
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_log.h"
+#include "../lv_misc/lv_math.h"
 
 #include <stddef.h>
 #include "lv_draw.h"
@@ -52,6 +53,12 @@ static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa,
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*clang-format off*/
+static const uint8_t bpp1_opa_table[2]  = {0, 255};          /*Opacity mapping with bpp = 1 (Just for compatibility)*/
+static const uint8_t bpp2_opa_table[4]  = {0, 85, 170, 255}; /*Opacity mapping with bpp = 2*/
+static const uint8_t bpp4_opa_table[16] = {0,  17, 34,  51,  /*Opacity mapping with bpp = 4*/
+                                           68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
+/*clang-format on*/
 
 /**********************
  *      MACROS
@@ -153,8 +160,8 @@ void lv_draw_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_
     vdb_buf_tmp += vdb_width * vdb_rel_a.y1;
 
 #if LV_USE_GPU
-    static LV_ATTRIBUTE_MEM_ALIGN lv_color_t color_array_tmp[LV_HOR_RES_MAX]; /*Used by 'lv_disp_mem_blend'*/
-    static lv_coord_t last_width = -1;
+    static LV_REFR_LOCAL LV_ATTRIBUTE_MEM_ALIGN lv_color_t color_array_tmp[LV_HOR_RES_MAX]; /*Used by 'lv_disp_mem_blend'*/
+    static LV_REFR_LOCAL lv_coord_t last_width = -1;
 
     lv_coord_t w = lv_area_get_width(&vdb_rel_a);
     /*Don't use hw. acc. for every small fill (because of the init overhead)*/
@@ -233,13 +240,6 @@ void lv_draw_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_
 void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv_font_t * font_p, uint32_t letter,
                     lv_color_t color, lv_opa_t opa)
 {
-    /*clang-format off*/
-    const uint8_t bpp1_opa_table[2]  = {0, 255};          /*Opacity mapping with bpp = 1 (Just for compatibility)*/
-    const uint8_t bpp2_opa_table[4]  = {0, 85, 170, 255}; /*Opacity mapping with bpp = 2*/
-    const uint8_t bpp4_opa_table[16] = {0,  17, 34,  51,  /*Opacity mapping with bpp = 4*/
-                                        68, 85, 102, 119, 136, 153, 170, 187, 204, 221, 238, 255};
-    /*clang-format on*/
-
     if(opa < LV_OPA_MIN) return;
     if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
 
@@ -448,6 +448,208 @@ void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv
     }
 }
 
+/**
+ * Render the opacity map of a letter into an 8 bit mask instead of drawing it.
+ * The letters rendered into the same mask can be drawn in one step with `lv_draw_mask_blend`.
+ * @param pos_p left-top coordinate of the letter
+ * @param mask_p the letter will be rendered only on this area
+ * @param font_p pointer to font
+ * @param letter a letter to render
+ * @param buf pointer to the mask. 1 byte for every pixel or 3 bytes with sub-pixel rendered fonts.
+ * @param buf_area area of `buf` on the screen
+ * @param res_area the area of the rendered pixels is stored here. `x2 < x1` if nothing was rendered.
+ * @return false: the visible part of the letter is not in `buf_area` so it was not rendered
+ */
+bool lv_draw_letter_mask(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv_font_t * font_p, uint32_t letter,
+                         lv_opa_t * buf, const lv_area_t * buf_area, lv_area_t * res_area)
+{
+    res_area->x1 = 0;
+    res_area->x2 = -1;
+    res_area->y1 = 0;
+    res_area->y2 = -1;
+
+    if(font_p == NULL) {
+        LV_LOG_WARN("Font: character's bitmap not found");
+        return true;
+    }
+
+    lv_font_glyph_dsc_t g;
+    bool g_ret = lv_font_get_glyph_dsc(font_p, &g, letter, '\0');
+    if(g_ret == false) return true;
+
+    /*bpp = 3 should be converted to bpp = 4 in lv_font_get_glyph_bitmap */
+    if(g.bpp == 3) g.bpp = 4;
+
+    const uint8_t * bpp_opa_table;
+    switch(g.bpp) {
+        case 1: bpp_opa_table = bpp1_opa_table; break;
+        case 2: bpp_opa_table = bpp2_opa_table; break;
+        case 4: bpp_opa_table = bpp4_opa_table; break;
+        case 8: bpp_opa_table = NULL; break; /*No opa table, pixel value will be used directly*/
+        default: return true;                /*Invalid bpp. Can't render the letter*/
+    }
+
+    lv_coord_t pos_x = pos_p->x + g.ofs_x;
+    lv_coord_t pos_y = pos_p->y + (font_p->line_height - font_p->base_line) - g.box_h - g.ofs_y;
+
+    /*Columns are counted in sub-pixels with sub-pixel rendering*/
+    int32_t px_size = font_p->subpx == LV_FONT_SUBPX_NONE ? 1 : 3;
+
+    /* Calculate the col/row start/end on the map*/
+    int32_t col_start = pos_x >= mask_p->x1 ? 0 : (mask_p->x1 - pos_x) * px_size;
+    int32_t col_end   = LV_MATH_MIN(g.box_w, (mask_p->x2 - pos_x + 1) * px_size);
+    int32_t row_start = pos_y >= mask_p->y1 ? 0 : mask_p->y1 - pos_y;
+    int32_t row_end   = LV_MATH_MIN(g.box_h, mask_p->y2 - pos_y + 1);
+
+    /*The letter is out of the mask*/
+    if(col_start >= col_end || row_start >= row_end) return true;
+
+    lv_area_t draw_area;
+    draw_area.x1 = pos_x + col_start / px_size;
+    draw_area.x2 = pos_x + (col_end - 1) / px_size;
+    draw_area.y1 = pos_y + row_start;
+    draw_area.y2 = pos_y + row_end - 1;
+    if(lv_area_is_in(&draw_area, buf_area) == false) return false;
+
+    const uint8_t * map_p = lv_font_get_glyph_bitmap(font_p, letter);
+    if(map_p == NULL) return true;
+
+    uint32_t width_bit   = g.box_w * g.bpp; /*Letter width in bits*/
+    uint8_t px_mask      = (1 << g.bpp) - 1;
+    int32_t buf_stride   = lv_area_get_width(buf_area) * px_size;
+    lv_opa_t * buf_row   = buf + (draw_area.y1 - buf_area->y1) * buf_stride + (pos_x - buf_area->x1) * px_size;
+    int32_t row;
+    int32_t col;
+
+    for(row = row_start; row < row_end; row++) {
+        uint32_t bit_ofs     = row * width_bit + col_start * g.bpp;
+        const uint8_t * src  = map_p + (bit_ofs >> 3);
+        uint8_t shift        = 8 - g.bpp - (bit_ofs & 0x7); /*Position of the current pixel from the LSB*/
+
+        for(col = col_start; col < col_end; col++) {
+            uint8_t letter_px = (*src >> shift) & px_mask;
+            if(letter_px != 0) {
+                lv_opa_t px_opa = bpp_opa_table ? bpp_opa_table[letter_px] : letter_px;
+                lv_opa_t * d    = &buf_row[col];
+
+                /*Combine with the overlapping letters as if they were drawn after each other*/
+                if(*d == 0) *d = px_opa;
+                else *d = 255 - (((uint16_t)(255 - *d) * (255 - px_opa)) >> 8);
+            }
+
+            if(shift >= g.bpp) {
+                shift -= g.bpp;
+            } else {
+                shift = 8 - g.bpp;
+                src++;
+            }
+        }
+
+        buf_row += buf_stride;
+    }
+
+    lv_area_copy(res_area, &draw_area);
+    return true;
+}
+
+/**
+ * Blend a color into the Virtual Display Buffer through an 8 bit mask and clear the used part of the mask
+ * @param buf pointer to a mask rendered by `lv_draw_letter_mask`
+ * @param buf_area area of `buf` on the screen
+ * @param blend_area blend only this area. It has to be in `buf_area` and in the VDB.
+ * @param color the color to blend
+ * @param opa opacity of the color (0..255)
+ * @param subpx true: `buf` has 3 bytes (the opacity of the sub-pixels) for every pixel
+ */
+void lv_draw_mask_blend(lv_opa_t * buf, const lv_area_t * buf_area, const lv_area_t * blend_area, lv_color_t color,
+                        lv_opa_t opa, bool subpx)
+{
+    lv_disp_t * disp    = lv_refr_get_disp_refreshing();
+    lv_disp_buf_t * vdb = lv_disp_get_buf(disp);
+
+    if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+
+    bool scr_transp = false;
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+    scr_transp = disp->driver.screen_transp;
+#endif
+
+    lv_coord_t vdb_width = lv_area_get_width(&vdb->area);
+    lv_coord_t w         = lv_area_get_width(blend_area);
+    int32_t px_size      = subpx ? 3 : 1;
+    int32_t buf_stride   = lv_area_get_width(buf_area) * px_size;
+    lv_opa_t * buf_row   = buf + (blend_area->y1 - buf_area->y1) * buf_stride + (blend_area->x1 - buf_area->x1) * px_size;
+    lv_color_t * vdb_row = (lv_color_t *)vdb->buf_act + (blend_area->y1 - vdb->area.y1) * vdb_width + blend_area->x1 - vdb->area.x1;
+    uint8_t txt_rgb[3]   = {LV_COLOR_GET_R(color), LV_COLOR_GET_G(color), LV_COLOR_GET_B(color)};
+    lv_coord_t row;
+    lv_coord_t col;
+
+    for(row = blend_area->y1; row <= blend_area->y2; row++) {
+        if(opa < LV_OPA_MIN) {
+            /*Nothing to draw but the mask still needs to be cleared*/
+        } else if(subpx == false) {
+            for(col = 0; col < w; col++) {
+                lv_opa_t px_opa = buf_row[col];
+                if(px_opa == 0) continue;
+
+                if(opa != LV_OPA_COVER) px_opa = (uint16_t)((uint16_t)px_opa * opa) >> 8;
+
+                if(disp->driver.set_px_cb) {
+                    disp->driver.set_px_cb(&disp->driver, (uint8_t *)vdb->buf_act, vdb_width,
+                                           blend_area->x1 + col - vdb->area.x1, row - vdb->area.y1, color, px_opa);
+                } else if(vdb_row[col].full != color.full) {
+                    if(px_opa > LV_OPA_MAX) {
+                        vdb_row[col] = color;
+                    } else if(px_opa > LV_OPA_MIN) {
+                        if(scr_transp == false) {
+                            vdb_row[col] = lv_color_mix(color, vdb_row[col], px_opa);
+                        } else {
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+                            vdb_row[col] = color_mix_2_alpha(vdb_row[col], vdb_row[col].ch.alpha, color, px_opa);
+#endif
+                        }
+                    }
+                }
+            }
+        } else {
+            for(col = 0; col < w; col++) {
+                lv_opa_t * font_rgb = &buf_row[col * 3];
+                if(font_rgb[0] == 0 && font_rgb[1] == 0 && font_rgb[2] == 0) continue;
+
+                if(opa != LV_OPA_COVER) {
+                    font_rgb[0] = (uint16_t)((uint16_t)font_rgb[0] * opa) >> 8;
+                    font_rgb[1] = (uint16_t)((uint16_t)font_rgb[1] * opa) >> 8;
+                    font_rgb[2] = (uint16_t)((uint16_t)font_rgb[2] * opa) >> 8;
+                }
+
+                lv_color_t * vdb_px = &vdb_row[col];
+                if(scr_transp == false) {
+                    lv_color_t res_color;
+                    uint8_t bg_rgb[3] = {LV_COLOR_GET_R(*vdb_px), LV_COLOR_GET_G(*vdb_px), LV_COLOR_GET_B(*vdb_px)};
+
+#if LV_FONT_SUBPX_BGR
+                    LV_COLOR_SET_B(res_color, (uint16_t)((uint16_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[2] * (255 - font_rgb[0]))) >> 8);
+                    LV_COLOR_SET_R(res_color, (uint16_t)((uint16_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[0] * (255 - font_rgb[2]))) >> 8);
+#else
+                    LV_COLOR_SET_R(res_color, (uint16_t)((uint16_t)txt_rgb[0] * font_rgb[0] + (bg_rgb[0] * (255 - font_rgb[0]))) >> 8);
+                    LV_COLOR_SET_B(res_color, (uint16_t)((uint16_t)txt_rgb[2] * font_rgb[2] + (bg_rgb[2] * (255 - font_rgb[2]))) >> 8);
+#endif
+                    LV_COLOR_SET_G(res_color, (uint16_t)((uint16_t)txt_rgb[1] * font_rgb[1] + (bg_rgb[1] * (255 - font_rgb[1]))) >> 8);
+                    vdb_px->full = res_color.full;
+                } else {
+#if LV_COLOR_DEPTH == 32 && LV_COLOR_SCREEN_TRANSP
+                    *vdb_px = color_mix_2_alpha(*vdb_px, vdb_px->ch.alpha, color, font_rgb[1]);
+#endif
+                }
+            }
+        }
+
+        memset(buf_row, 0, w * px_size);
+        buf_row += buf_stride;
+        vdb_row += vdb_width;
+    }
+}
+
 /**
  * Draw a color map to the display (image)
  * @param cords_p coordinates the color map
@@ -754,11 +956,11 @@ static inline lv_color_t color_mix_2_alpha(lv_color_t bg_color, lv_opa_t bg_opa,
     /*Both colors have alpha. Expensive calculation need to be applied*/
     else {
         /*Save the parameters and the result. If they will be asked again don't compute again*/
-        static lv_opa_t fg_opa_save     = 0;
-        static lv_opa_t bg_opa_save     = 0;
-        static lv_color_t fg_color_save = {{0}};
-        static lv_color_t bg_color_save = {{0}};
-        static lv_color_t c             = {{0}};
+        static LV_REFR_LOCAL lv_opa_t fg_opa_save     = 0;
+        static LV_REFR_LOCAL lv_opa_t bg_opa_save     = 0;
+        static LV_REFR_LOCAL lv_color_t fg_color_save = {{0}};
+        static LV_REFR_LOCAL lv_color_t bg_color_save = {{0}};
+        static LV_REFR_LOCAL lv_color_t c             = {{0}};
 
         if(fg_opa != fg_opa_save || bg_opa != bg_opa_save || fg_color.full != fg_color_save.full ||
            bg_color.full != bg_color_save.full) {
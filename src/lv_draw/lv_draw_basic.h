@@ -57,6 +57,33 @@ void lv_draw_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, lv_color_
 void lv_draw_letter(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv_font_t * font_p, uint32_t letter,
                     lv_color_t color, lv_opa_t opa);
 
+/**
+ * Render the opacity map of a letter into an 8 bit mask instead of drawing it.
+ * The letters rendered into the same mask can be drawn in one step with `lv_draw_mask_blend`.
+ * @param pos_p left-top coordinate of the letter
+ * @param mask_p the letter will be rendered only on this area
+ * @param font_p pointer to font
+ * @param letter a letter to render
+ * @param buf pointer to the mask. 1 byte for every pixel or 3 bytes with sub-pixel rendered fonts.
+ * @param buf_area area of `buf` on the screen
+ * @param res_area the area of the rendered pixels is stored here. `x2 < x1` if nothing was rendered.
+ * @return false: the visible part of the letter is not in `buf_area` so it was not rendered
+ */
+bool lv_draw_letter_mask(const lv_point_t * pos_p, const lv_area_t * mask_p, const lv_font_t * font_p, uint32_t letter,
+                         lv_opa_t * buf, const lv_area_t * buf_area, lv_area_t * res_area);
+
+/**
+ * Blend a color into the Virtual Display Buffer through an 8 bit mask and clear the used part of the mask
+ * @param buf pointer to a mask rendered by `lv_draw_letter_mask`
+ * @param buf_area area of `buf` on the screen
+ * @param blend_area blend only this area. It has to be in `buf_area` and in the VDB.
+ * @param color the color to blend
+ * @param opa opacity of the color (0..255)
+ * @param subpx true: `buf` has 3 bytes (the opacity of the sub-pixels) for every pixel
+ */
+void lv_draw_mask_blend(lv_opa_t * buf, const lv_area_t * buf_area, const lv_area_t * blend_area, lv_color_t color,
+                        lv_opa_t opa, bool subpx);
+
 /**
  * Draw a color map to the display (image)
  * @param cords_p coordinates the color map
@@ -0,0 +1,342 @@
+/**
+ * @file lv_draw_grad.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_draw_grad.h"
+#include "../lv_misc/lv_mem.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Don't cache the color ramps which would require more memory than this [bytes]*/
+#define GRAD_CACHE_ENTRY_MAX_SIZE (4 * 1024)
+
+#if LV_GRAD_DITHER && LV_COLOR_DEPTH != 1
+#define GRAD_DITHER 1
+#define GRAD_RAMP_STEP 4 /*Store a color for every column (or row) of the dither matrix*/
+#else
+#define GRAD_DITHER 0
+#define GRAD_RAMP_STEP 1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*The colors of a gradient along its direction*/
+typedef struct
+{
+    const lv_color_t * ramp; /*`len * GRAD_RAMP_STEP` pre-calculated colors or NULL to calculate them on the fly*/
+    lv_color_t main_color;
+    lv_color_t grad_color;
+    lv_coord_t len;
+} lv_grad_t;
+
+#if LV_GRAD_CACHE_SIZE > 0
+/*A cached color ramp*/
+typedef struct
+{
+    lv_color_t * colors; /*`len * GRAD_RAMP_STEP` colors (NULL: unused entry)*/
+    uint32_t last_use;   /*Stamp of the last use to find the least recently used entry*/
+    lv_color_t main_color;
+    lv_color_t grad_color;
+    lv_coord_t len;
+} lv_grad_cache_entry_t;
+#endif
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_color_t grad_get(const lv_grad_t * grad, lv_coord_t i, uint8_t k);
+static lv_color_t grad_calc(lv_color_t main_color, lv_color_t grad_color, lv_coord_t len, lv_coord_t i, uint8_t k);
+#if LV_GRAD_CACHE_SIZE > 0
+static const lv_color_t * grad_cache_get(lv_color_t main_color, lv_color_t grad_color, lv_coord_t len);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+#if LV_GRAD_CACHE_SIZE > 0
+static uint32_t grad_cache_stamp;
+#endif
+
+#if GRAD_DITHER
+/*4x4 ordered (Bayer) dither matrix*/
+static const uint8_t dither_matrix[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Fill an area with a part of a gradient
+ * @param cords_p the area to fill
+ * @param mask_p fill only on this area
+ * @param grad_p the area of the whole gradient. `main_color` is on its top/left edge,
+ *               `grad_color` is on its bottom/right edge.
+ * @param main_color the starting color of the gradient
+ * @param grad_color the ending color of the gradient
+ * @param dir direction of the gradient
+ * @param opa opacity of the area (0..255)
+ */
+void lv_draw_grad_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_area_t * grad_p,
+                       lv_color_t main_color, lv_color_t grad_color, lv_grad_dir_t dir, lv_opa_t opa)
+{
+    if(opa < LV_OPA_MIN) return;
+
+    /*Draw only the rows and columns on the mask*/
+    lv_area_t res_a;
+    if(lv_area_intersect(&res_a, cords_p, mask_p) == false) return;
+
+    if(main_color.full == grad_color.full) {
+        lv_draw_fill(&res_a, mask_p, main_color, opa);
+        return;
+    }
+
+    lv_grad_t grad;
+    grad.main_color = main_color;
+    grad.grad_color = grad_color;
+    grad.len        = dir == LV_GRAD_DIR_HOR ? lv_area_get_width(grad_p) : lv_area_get_height(grad_p);
+#if LV_GRAD_CACHE_SIZE > 0
+    /*The ramp cache is shared by the displays*/
+    LV_REFR_SHARED_LOCK();
+    grad.ramp = grad_cache_get(main_color, grad_color, grad.len);
+#else
+    grad.ramp = NULL;
+#endif
+
+    lv_area_t line_a;
+    line_a.x1 = res_a.x1;
+    line_a.x2 = res_a.x2;
+    lv_coord_t y;
+
+#if GRAD_DITHER == 0
+    /*The rows of a vertical gradient have one color. Fill the neighboring rows with the same color at once.*/
+    if(dir == LV_GRAD_DIR_VER) {
+        lv_color_t act_color = grad_get(&grad, res_a.y1 - grad_p->y1, 0);
+        line_a.y1            = res_a.y1;
+        for(y = res_a.y1 + 1; y <= res_a.y2; y++) {
+            lv_color_t color = grad_get(&grad, y - grad_p->y1, 0);
+            if(color.full != act_color.full) {
+                line_a.y2 = y - 1;
+                lv_draw_fill(&line_a, &res_a, act_color, opa);
+                line_a.y1 = y;
+                act_color = color;
+            }
+        }
+
+        line_a.y2 = res_a.y2;
+        lv_draw_fill(&line_a, &res_a, act_color, opa);
+#if LV_GRAD_CACHE_SIZE > 0
+        LV_REFR_SHARED_UNLOCK();
+#endif
+        return;
+    }
+#endif
+
+    /*Else blend the rows as color maps*/
+    lv_color_t * line_buf = lv_draw_get_buf(lv_area_get_width(&res_a) * sizeof(lv_color_t));
+    bool line_ready       = false;
+    for(y = res_a.y1; y <= res_a.y2; y++) {
+        if(line_ready == false) {
+            lv_coord_t x;
+            if(dir == LV_GRAD_DIR_HOR) {
+                for(x = res_a.x1; x <= res_a.x2; x++) {
+                    line_buf[x - res_a.x1] = grad_get(&grad, x - grad_p->x1, (y - grad_p->y1) & 0x3);
+                }
+            } else {
+                for(x = res_a.x1; x <= res_a.x2; x++) {
+                    line_buf[x - res_a.x1] = grad_get(&grad, y - grad_p->y1, (x - grad_p->x1) & 0x3);
+                }
+            }
+#if GRAD_DITHER == 0
+            /*Without dithering all rows of a horizontal gradient are the same*/
+            line_ready = true;
+#endif
+        }
+
+        line_a.y1 = y;
+        line_a.y2 = y;
+        lv_draw_map(&line_a, &res_a, (const uint8_t *)line_buf, opa, false, false, LV_COLOR_BLACK, LV_OPA_TRANSP);
+    }
+#if LV_GRAD_CACHE_SIZE > 0
+    LV_REFR_SHARED_UNLOCK();
+#endif
+}
+
+/**
+ * Get the color of a gradient in a point (without dithering)
+ * @param grad_p the area of the whole gradient
+ * @param main_color the starting color of the gradient
+ * @param grad_color the ending color of the gradient
+ * @param dir direction of the gradient
+ * @param x x coordinate of the point
+ * @param y y coordinate of the point
+ * @return the color of the gradient in the point
+ */
+lv_color_t lv_draw_grad_get_color(const lv_area_t * grad_p, lv_color_t main_color, lv_color_t grad_color,
+                                  lv_grad_dir_t dir, lv_coord_t x, lv_coord_t y)
+{
+    lv_coord_t len;
+    lv_coord_t i;
+    if(dir == LV_GRAD_DIR_HOR) {
+        len = lv_area_get_width(grad_p);
+        i   = x - grad_p->x1;
+    } else {
+        len = lv_area_get_height(grad_p);
+        i   = y - grad_p->y1;
+    }
+
+    if(i < 0) i = 0;
+    if(i >= len) i = len - 1;
+
+    uint8_t mix = (uint32_t)((uint32_t)(len - 1 - i) * 255) / len;
+    return lv_color_mix(main_color, grad_color, mix);
+}
+
+/**
+ * Free the cached gradient color ramps.
+ * They will be calculated and cached again when they are drawn.
+ */
+void lv_draw_grad_cache_clean(void)
+{
+#if LV_GRAD_CACHE_SIZE > 0
+    lv_grad_cache_entry_t * cache = LV_GC_ROOT(_lv_grad_cache_array);
+    if(cache == NULL) return;
+
+    uint16_t i;
+    for(i = 0; i < LV_GRAD_CACHE_SIZE; i++) {
+        if(cache[i].colors) lv_mem_free(cache[i].colors);
+    }
+
+    lv_mem_free(cache);
+    LV_GC_ROOT(_lv_grad_cache_array) = NULL;
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Get a color of a gradient
+ * @param grad pointer to a gradient descriptor
+ * @param i index of the color along the gradient (distance from the top/left edge)
+ * @param k column (or row) of the dither matrix [0..3]. Ignored without dithering.
+ * @return the color
+ */
+static lv_color_t grad_get(const lv_grad_t * grad, lv_coord_t i, uint8_t k)
+{
+    if(i < 0) i = 0;
+    if(i >= grad->len) i = grad->len - 1;
+
+    if(grad->ramp) return grad->ramp[i * GRAD_RAMP_STEP + (k & (GRAD_RAMP_STEP - 1))];
+
+    return grad_calc(grad->main_color, grad->grad_color, grad->len, i, k);
+}
+
+/**
+ * Calculate a color of a gradient
+ * @param main_color the starting color of the gradient
+ * @param grad_color the ending color of the gradient
+ * @param len length of the gradient
+ * @param i index of the color along the gradient [0..len-1]
+ * @param k column (or row) of the dither matrix [0..3]. Ignored without dithering.
+ * @return the color
+ */
+static lv_color_t grad_calc(lv_color_t main_color, lv_color_t grad_color, lv_coord_t len, lv_coord_t i, uint8_t k)
+{
+    uint8_t mix = (uint32_t)((uint32_t)(len - 1 - i) * 255) / len;
+
+#if GRAD_DITHER
+    /*Mix like `lv_color_mix` but add a threshold from the dither matrix before dropping the fraction*/
+    uint16_t th = (dither_matrix[i & 0x3][k & 0x3] << 4) + 8;
+    lv_color_t ret;
+    LV_COLOR_SET_R(ret, (uint16_t)((uint16_t)LV_COLOR_GET_R(main_color) * mix +
+                                   LV_COLOR_GET_R(grad_color) * (255 - mix) + th) >> 8);
+    LV_COLOR_SET_G(ret, (uint16_t)((uint16_t)LV_COLOR_GET_G(main_color) * mix +
+                                   LV_COLOR_GET_G(grad_color) * (255 - mix) + th) >> 8);
+    LV_COLOR_SET_B(ret, (uint16_t)((uint16_t)LV_COLOR_GET_B(main_color) * mix +
+                                   LV_COLOR_GET_B(grad_color) * (255 - mix) + th) >> 8);
+    LV_COLOR_SET_A(ret, 0xFF);
+    return ret;
+#else
+    (void)k; /*Unused*/
+    return lv_color_mix(main_color, grad_color, mix);
+#endif
+}
+
+#if LV_GRAD_CACHE_SIZE > 0
+/**
+ * Get the pre-calculated colors of a gradient from the cache.
+ * If it's not cached yet calculate it and replace the least recently used entry with it.
+ * @param main_color the starting color of the gradient
+ * @param grad_color the ending color of the gradient
+ * @param len length of the gradient
+ * @return pointer to `len * GRAD_RAMP_STEP` colors or NULL if the gradient can't be cached
+ */
+static const lv_color_t * grad_cache_get(lv_color_t main_color, lv_color_t grad_color, lv_coord_t len)
+{
+    uint32_t size = (uint32_t)len * GRAD_RAMP_STEP * sizeof(lv_color_t);
+    if(len <= 0 || size > GRAD_CACHE_ENTRY_MAX_SIZE) return NULL;
+
+    if(LV_GC_ROOT(_lv_grad_cache_array) == NULL) {
+        LV_GC_ROOT(_lv_grad_cache_array) = lv_mem_alloc(sizeof(lv_grad_cache_entry_t) * LV_GRAD_CACHE_SIZE);
+        if(LV_GC_ROOT(_lv_grad_cache_array) == NULL) return NULL;
+        memset(LV_GC_ROOT(_lv_grad_cache_array), 0, sizeof(lv_grad_cache_entry_t) * LV_GRAD_CACHE_SIZE);
+    }
+
+    lv_grad_cache_entry_t * cache = LV_GC_ROOT(_lv_grad_cache_array);
+    grad_cache_stamp++;
+
+    /*Is the ramp cached? Else find the least recently used entry*/
+    lv_grad_cache_entry_t * entry = &cache[0];
+    uint16_t i;
+    for(i = 0; i < LV_GRAD_CACHE_SIZE; i++) {
+        if(cache[i].colors && cache[i].len == len && cache[i].main_color.full == main_color.full &&
+           cache[i].grad_color.full == grad_color.full) {
+            cache[i].last_use = grad_cache_stamp;
+            return cache[i].colors;
+        }
+
+        if(cache[i].last_use < entry->last_use) entry = &cache[i];
+    }
+
+    if(entry->colors) lv_mem_free(entry->colors);
+    memset(entry, 0, sizeof(lv_grad_cache_entry_t));
+
+    /*Don't assert here: if there is no memory for the cache the colors are simply calculated on the fly*/
+    entry->colors = lv_mem_alloc(size);
+    if(entry->colors == NULL) return NULL;
+
+    entry->main_color = main_color;
+    entry->grad_color = grad_color;
+    entry->len        = len;
+    entry->last_use   = grad_cache_stamp;
+
+    lv_coord_t c;
+    for(c = 0; c < len; c++) {
+        uint8_t k;
+        for(k = 0; k < GRAD_RAMP_STEP; k++) {
+            entry->colors[c * GRAD_RAMP_STEP + k] = grad_calc(main_color, grad_color, len, c, k);
+        }
+    }
+
+    return entry->colors;
+}
+#endif
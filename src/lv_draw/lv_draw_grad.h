@@ -0,0 +1,71 @@
+/**
+ * @file lv_draw_grad.h
+ *
+ */
+
+#ifndef LV_DRAW_GRAD_H
+#define LV_DRAW_GRAD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Fill an area with a part of a gradient
+ * @param cords_p the area to fill
+ * @param mask_p fill only on this area
+ * @param grad_p the area of the whole gradient. `main_color` is on its top/left edge,
+ *               `grad_color` is on its bottom/right edge.
+ * @param main_color the starting color of the gradient
+ * @param grad_color the ending color of the gradient
+ * @param dir direction of the gradient
+ * @param opa opacity of the area (0..255)
+ */
+void lv_draw_grad_fill(const lv_area_t * cords_p, const lv_area_t * mask_p, const lv_area_t * grad_p,
+                       lv_color_t main_color, lv_color_t grad_color, lv_grad_dir_t dir, lv_opa_t opa);
+
+/**
+ * Get the color of a gradient in a point (without dithering)
+ * @param grad_p the area of the whole gradient
+ * @param main_color the starting color of the gradient
+ * @param grad_color the ending color of the gradient
+ * @param dir direction of the gradient
+ * @param x x coordinate of the point
+ * @param y y coordinate of the point
+ * @return the color of the gradient in the point
+ */
+lv_color_t lv_draw_grad_get_color(const lv_area_t * grad_p, lv_color_t main_color, lv_color_t grad_color,
+                                  lv_grad_dir_t dir, lv_coord_t x, lv_coord_t y);
+
+/**
+ * Free the cached gradient color ramps.
+ * They will be calculated and cached again when they are drawn.
+ */
+void lv_draw_grad_cache_clean(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_GRAD_H*/
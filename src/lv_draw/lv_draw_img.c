@@ -10,6 +10,7 @@
 #include "lv_img_cache.h"
 #include "../lv_misc/lv_log.h"
 #include "../lv_misc/lv_mem.h"
+#include "../lv_core/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -55,8 +56,15 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
         return;
     }
 
+#if LV_USE_PROF
+    uint32_t prof_start = lv_prof_get_time();
+#endif
+
+    /*The image cache is shared by the displays*/
     lv_res_t res;
+    LV_REFR_SHARED_LOCK();
     res = lv_img_draw_core(coords, mask, src, style, opa_scale);
+    LV_REFR_SHARED_UNLOCK();
 
     if(res == LV_RES_INV) {
         LV_LOG_WARN("Image draw error");
@@ -64,6 +72,10 @@ void lv_draw_img(const lv_area_t * coords, const lv_area_t * mask, const void *
         lv_draw_label(coords, mask, &lv_style_plain, LV_OPA_COVER, "No\ndata", LV_TXT_FLAG_NONE, NULL,  NULL, NULL, LV_BIDI_DIR_LTR);
         return;
     }
+
+#if LV_USE_PROF
+    lv_prof_draw(LV_PROF_DRAW_IMG, prof_start, coords, mask);
+#endif
 }
 
 /**
@@ -9,6 +9,7 @@
 #include "lv_draw_label.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_bidi.h"
+#include "../lv_core/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -26,10 +27,23 @@ enum {
 };
 typedef uint8_t cmd_state_t;
 
+/*The letters of a line are rendered into a mask and blended in one step*/
+typedef struct
+{
+    lv_opa_t * buf;    /*The mask or NULL to draw the letters one by one*/
+    lv_area_t area;    /*Area of the mask on the screen*/
+    lv_area_t dirty;   /*Area of the rendered letters in the mask. Empty if `x2 < x1`.*/
+    lv_color_t color;  /*Color of the rendered letters*/
+    bool subpx;
+} letter_mask_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static uint8_t hex_char_to_num(char hex);
+static void letter_mask_draw(letter_mask_t * lm, const lv_point_t * pos, const lv_area_t * mask,
+                             const lv_font_t * font, uint32_t letter, lv_color_t color, lv_opa_t opa);
+static void letter_mask_flush(letter_mask_t * lm, lv_opa_t opa);
 
 /**********************
  *  STATIC VARIABLES
@@ -64,6 +78,10 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
     /*No need to waste processor time if string is empty*/
     if (txt[0] == '\0')  return;
 
+#if LV_USE_PROF
+    uint32_t prof_start = lv_prof_get_time();
+#endif
+
     if((flag & LV_TXT_FLAG_EXPAND) == 0) {
         /*Normally use the label's width as width*/
         w = lv_area_get_width(coords);
@@ -165,6 +183,20 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
     lv_style_copy(&sel_style, &lv_style_plain_color);
     sel_style.body.main_color = sel_style.body.grad_color = style->text.sel_color;
 
+    /*The mask is as wide as the visible part of the label and as high as a line of the font*/
+    letter_mask_t lm;
+    lv_coord_t font_h = lv_font_get_line_height(font);
+    lm.subpx          = font->subpx == LV_FONT_SUBPX_NONE ? false : true;
+    lm.area.x1        = LV_MATH_MAX(mask->x1, coords->x1 + x_ofs);
+    lm.area.x2        = LV_MATH_MIN(mask->x2, coords->x1 + x_ofs + w - 1);
+    lm.buf            = NULL;
+    lm.color          = style->text.color;
+    if(lm.area.x1 <= lm.area.x2 && font_h > 0) {
+        uint32_t buf_size = (uint32_t)lv_area_get_width(&lm.area) * font_h * (lm.subpx ? 3 : 1);
+        lm.buf            = lv_draw_get_mask_buf(buf_size); /*Without buffer the letters are drawn one by one*/
+        if(lm.buf) memset(lm.buf, 0, buf_size);
+    }
+
     /*Write out all lines*/
     while(txt[line_start] != '\0') {
         if(offset != NULL) {
@@ -175,6 +207,11 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
         i         = 0;
         uint32_t letter;
         uint32_t letter_next;
+
+        lm.area.y1  = LV_MATH_MAX(mask->y1, pos.y);
+        lm.area.y2  = LV_MATH_MIN(mask->y2, pos.y + font_h - 1);
+        lm.dirty.x1 = 0;
+        lm.dirty.x2 = -1;
 #if LV_USE_BIDI
         char *bidi_txt = lv_draw_get_buf(line_end - line_start + 1);
         lv_bidi_process_paragraph(txt + line_start, bidi_txt, line_end - line_start, bidi_dir, NULL, 0);
@@ -253,12 +290,14 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
                 }
             }
 
-            lv_draw_letter(&pos, mask, font, letter, color, opa);
+            letter_mask_draw(&lm, &pos, mask, font, letter, color, opa);
 
             if(letter_w > 0) {
                 pos.x += letter_w + style->text.letter_space;
             }
         }
+        letter_mask_flush(&lm, opa);
+
         /*Go to next line*/
         line_start = line_end;
         line_end += lv_txt_get_next_line(&txt[line_start], font, style->text.letter_space, w, flag);
@@ -282,8 +321,12 @@ void lv_draw_label(const lv_area_t * coords, const lv_area_t * mask, const lv_st
         /*Go the next line position*/
         pos.y += line_height;
 
-        if(pos.y > mask->y2) return;
+        if(pos.y > mask->y2) break;
     }
+
+#if LV_USE_PROF
+    lv_prof_draw(LV_PROF_DRAW_LABEL, prof_start, coords, mask);
+#endif
 }
 
 /**********************
@@ -317,3 +360,53 @@ static uint8_t hex_char_to_num(char hex)
 
     return result;
 }
+
+/**
+ * Render a letter into the mask of the line or draw it directly if it's not in the mask
+ * @param lm pointer to the letter mask
+ * @param pos left-top coordinate of the latter
+ * @param mask the letter will be drawn only on this area
+ * @param font pointer to font
+ * @param letter a letter to draw
+ * @param color color of letter
+ * @param opa opacity of letter (0..255)
+ */
+static void letter_mask_draw(letter_mask_t * lm, const lv_point_t * pos, const lv_area_t * mask,
+                             const lv_font_t * font, uint32_t letter, lv_color_t color, lv_opa_t opa)
+{
+    if(lm->buf == NULL || lm->area.y1 > lm->area.y2) {
+        lv_draw_letter(pos, mask, font, letter, color, opa);
+        return;
+    }
+
+    /*The mask can hold only one color*/
+    if(lm->color.full != color.full) {
+        letter_mask_flush(lm, opa);
+        lm->color = color;
+    }
+
+    lv_area_t res;
+    if(lv_draw_letter_mask(pos, mask, font, letter, lm->buf, &lm->area, &res) == false) {
+        lv_draw_letter(pos, mask, font, letter, color, opa);
+        return;
+    }
+
+    if(res.x1 > res.x2) return;
+
+    if(lm->dirty.x1 > lm->dirty.x2) lv_area_copy(&lm->dirty, &res);
+    else lv_area_join(&lm->dirty, &lm->dirty, &res);
+}
+
+/**
+ * Blend the letters rendered into the mask
+ * @param lm pointer to the letter mask
+ * @param opa opacity of the letters (0..255)
+ */
+static void letter_mask_flush(letter_mask_t * lm, lv_opa_t opa)
+{
+    if(lm->buf == NULL || lm->dirty.x1 > lm->dirty.x2) return;
+
+    lv_draw_mask_blend(lm->buf, &lm->area, &lm->dirty, lm->color, opa, lm->subpx);
+    lm->dirty.x1 = 0;
+    lm->dirty.x2 = -1;
+}
@@ -11,6 +11,7 @@
 #include "lv_draw.h"
 #include "../lv_core/lv_refr.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_core/lv_prof.h"
 
 /*********************
  *      DEFINES
@@ -50,6 +51,9 @@ static void line_draw_ver(line_draw_t * main_line, const lv_area_t * mask, const
                           lv_opa_t opa_scale);
 static void line_draw_skew(line_draw_t * main_line, bool dir_ori, const lv_area_t * mask, const lv_style_t * style,
                            lv_opa_t opa_scale);
+static void line_draw_seg(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale);
+static bool line_is_collinear(const lv_point_t * p1, const lv_point_t * p2, const lv_point_t * p3);
 static void line_init(line_draw_t * line, const lv_point_t * p1, const lv_point_t * p2);
 static bool line_next(line_draw_t * line);
 static bool line_next_y(line_draw_t * line);
@@ -78,8 +82,103 @@ static bool line_next_x(line_draw_t * line);
 void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
                   const lv_style_t * style, lv_opa_t opa_scale)
 {
+    if(style->line.width == 0) return;
+
+#if LV_USE_PROF
+    uint32_t prof_start = lv_prof_get_time();
+#endif
+
+    line_draw_seg(point1, point2, mask, style, opa_scale);
+
+#if LV_USE_PROF
+    lv_area_t coords;
+    coords.x1 = LV_MATH_MIN(point1->x, point2->x);
+    coords.y1 = LV_MATH_MIN(point1->y, point2->y);
+    coords.x2 = LV_MATH_MAX(point1->x, point2->x);
+    coords.y2 = LV_MATH_MAX(point1->y, point2->y);
+    lv_prof_draw(LV_PROF_DRAW_LINE, prof_start, &coords, mask);
+#endif
+}
 
+/**
+ * Draw a polyline (lines connecting the consecutive points)
+ * The segments are drawn one by one like with `lv_draw_line` so they have no joins:
+ * non-collinear segments simply overlap at their common point (blended twice if not opaque).
+ * Only collinear consecutive segments are merged into one line and the segments out of the mask are skipped.
+ * @param points array of points
+ * @param point_num number of points in `points`
+ * @param x_sorted true: the x coordinates of `points` are in increasing order.
+ *                 Used to find the first and last segment on the mask with binary search.
+ * @param mask the polyline will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ */
+void lv_draw_polyline(const lv_point_t * points, uint16_t point_num, bool x_sorted, const lv_area_t * mask,
+                      const lv_style_t * style, lv_opa_t opa_scale)
+{
     if(style->line.width == 0) return;
+    if(point_num < 2) return;
+
+#if LV_USE_PROF
+    uint32_t prof_start = lv_prof_get_time();
+#endif
+
+    lv_coord_t width = style->line.width;
+    uint16_t i       = 0;
+
+    /*Find the first segment whose end point can be on the mask*/
+    if(x_sorted) {
+        uint16_t i_max = point_num - 2;
+        while(i < i_max) {
+            uint16_t i_mid = (i + i_max) >> 1;
+            if(points[i_mid + 1].x < mask->x1 - width) i = i_mid + 1;
+            else i_max = i_mid;
+        }
+    }
+
+    while(i < point_num - 1) {
+        /*The remaining segments start on the right of the mask*/
+        if(x_sorted && points[i].x > mask->x2 + width) break;
+
+        /*Merge the following collinear segments*/
+        uint16_t last = i + 1;
+        while(last < point_num - 1 && line_is_collinear(&points[i], &points[last], &points[last + 1])) last++;
+
+        line_draw_seg(&points[i], &points[last], mask, style, opa_scale);
+        i = last;
+    }
+
+#if LV_USE_PROF
+    lv_area_t coords;
+    coords.x1 = points[0].x;
+    coords.y1 = points[0].y;
+    coords.x2 = points[0].x;
+    coords.y2 = points[0].y;
+    for(i = 1; i < point_num; i++) {
+        coords.x1 = LV_MATH_MIN(coords.x1, points[i].x);
+        coords.y1 = LV_MATH_MIN(coords.y1, points[i].y);
+        coords.x2 = LV_MATH_MAX(coords.x2, points[i].x);
+        coords.y2 = LV_MATH_MAX(coords.y2, points[i].y);
+    }
+    lv_prof_draw(LV_PROF_DRAW_LINE, prof_start, &coords, mask);
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Draw a line segment. The style is already checked by the caller.
+ * @param point1 first point of the line
+ * @param point2 second point of the line
+ * @param mask the line will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ */
+static void line_draw_seg(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
+                          const lv_style_t * style, lv_opa_t opa_scale)
+{
     if(point1->x == point2->x && point1->y == point2->y) return;
 
     /*Return if the points are out of the mask*/
@@ -176,10 +275,6 @@ void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv
     }
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 static void line_draw_hor(line_draw_t * main_line, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale)
 {
     lv_coord_t width      = style->line.width - 1;
@@ -570,6 +665,27 @@ static void line_draw_skew(line_draw_t * main_line, bool dir_ori, const lv_area_
     }
 }
 
+/**
+ * Tell whether the `p2`-`p3` segment continues the `p1`-`p2` segment in the same direction
+ * @param p1 start point of the first segment
+ * @param p2 common point of the segments
+ * @param p3 end point of the second segment
+ * @return true: the two segments can be drawn as one line
+ */
+static bool line_is_collinear(const lv_point_t * p1, const lv_point_t * p2, const lv_point_t * p3)
+{
+    /*The differences can be up to 17 bits so the products are calculated on 64 bits*/
+    int64_t dx1 = p2->x - p1->x;
+    int64_t dy1 = p2->y - p1->y;
+    int64_t dx2 = p3->x - p2->x;
+    int64_t dy2 = p3->y - p2->y;
+
+    if(dx1 * dy2 != dy1 * dx2) return false;     /*Not on the same line*/
+    if(dx1 * dx2 + dy1 * dy2 <= 0) return false; /*Turns back or zero length*/
+
+    return true;
+}
+
 static void line_init(line_draw_t * line, const lv_point_t * p1, const lv_point_t * p2)
 {
     line->p1.x = p1->x;
@@ -37,6 +37,22 @@ extern "C" {
 void lv_draw_line(const lv_point_t * point1, const lv_point_t * point2, const lv_area_t * mask,
                   const lv_style_t * style, lv_opa_t opa_scale);
 
+/**
+ * Draw a polyline (lines connecting the consecutive points)
+ * The segments are drawn one by one like with `lv_draw_line` so they have no joins:
+ * non-collinear segments simply overlap at their common point (blended twice if not opaque).
+ * Only collinear consecutive segments are merged into one line and the segments out of the mask are skipped.
+ * @param points array of points
+ * @param point_num number of points in `points`
+ * @param x_sorted true: the x coordinates of `points` are in increasing order.
+ *                 Used to find the first and last segment on the mask with binary search.
+ * @param mask the polyline will be drawn only on this area
+ * @param style pointer to a line's style
+ * @param opa_scale scale down all opacities by the factor
+ */
+void lv_draw_polyline(const lv_point_t * points, uint16_t point_num, bool x_sorted, const lv_area_t * mask,
+                      const lv_style_t * style, lv_opa_t opa_scale);
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,469 @@
+/**
+ * @file lv_draw_raster.c
+ * Scanline rasterizer with exact area coverage. Every row is rendered separately:
+ * the edges crossing the row add their signed height (cover) and the covered area to the cells they pass,
+ * then the cells are accumulated from left to right to get the coverage of the pixels.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_draw_raster.h"
+#include "../lv_misc/lv_math.h"
+
+#if LV_USE_DRAW_RASTER
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Allocate the edges in the draw buffer in this large steps*/
+#define RASTER_EDGE_CHUNK 32
+
+/*Max. angle between the points of an arc [deg]*/
+#define RASTER_ARC_STEP_MAX 30
+
+#define RASTER_FRACT_MASK (LV_RASTER_ONE - 1)
+#define RASTER_FULL_COVER (LV_RASTER_ONE * LV_RASTER_ONE)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*A non-horizontal edge of a path*/
+typedef struct
+{
+    int32_t x0; /*The top end point*/
+    int32_t y0;
+    int32_t x1; /*The bottom end point (y1 > y0)*/
+    int32_t y1;
+    int32_t dir; /*1: the edge goes downward; -1: upward*/
+} lv_raster_edge_t;
+
+/*The row being rasterized*/
+typedef struct
+{
+    int32_t * cover; /*Sum of the signed heights of the edges in the cells. [0] is left to the clip area.*/
+    int32_t * area;  /*Sum of `height * (x_start + x_end)` of the edges in the cells*/
+    lv_coord_t x1;   /*First column of the clip area*/
+    lv_coord_t x2;   /*Last column of the clip area*/
+} lv_raster_row_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void add_edge(lv_raster_path_t * path, int32_t x0, int32_t y0, int32_t x1, int32_t y1);
+static void add_point(lv_raster_path_t * path, int32_t x, int32_t y);
+static void row_add_edge(lv_raster_row_t * row, const lv_raster_edge_t * edge, int32_t row_y);
+static void row_add_cell(lv_raster_row_t * row, int32_t cell_x, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                         int32_t dir);
+static void row_draw(const lv_raster_row_t * row, lv_coord_t y, const lv_area_t * mask, lv_color_t color,
+                     lv_opa_t opa, bool aa);
+static void draw_span(lv_coord_t x1, lv_coord_t x2, lv_coord_t y, const lv_area_t * mask, lv_color_t color,
+                      lv_opa_t opa, uint16_t cover);
+static int32_t raster_floor(int32_t v);
+static int16_t arc_get_step(int32_t r);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Start a new, empty path
+ * @param path pointer to a path to initialize
+ */
+void lv_raster_path_init(lv_raster_path_t * path)
+{
+    memset(path, 0, sizeof(lv_raster_path_t));
+    path->x_min = INT32_MAX;
+    path->y_min = INT32_MAX;
+    path->x_max = INT32_MIN;
+    path->y_max = INT32_MIN;
+}
+
+/**
+ * Start a new contour. The current contour is closed.
+ * @param path pointer to a path
+ * @param x x coordinate of the first point [1/256 px]
+ * @param y y coordinate of the first point [1/256 px]
+ */
+void lv_raster_move_to(lv_raster_path_t * path, int32_t x, int32_t y)
+{
+    lv_raster_close(path);
+
+    path->start_x = x;
+    path->start_y = y;
+    path->last_x  = x;
+    path->last_y  = y;
+    path->open    = 1;
+    add_point(path, x, y);
+}
+
+/**
+ * Add a line segment to the current contour
+ * @param path pointer to a path
+ * @param x x coordinate of the end point [1/256 px]
+ * @param y y coordinate of the end point [1/256 px]
+ */
+void lv_raster_line_to(lv_raster_path_t * path, int32_t x, int32_t y)
+{
+    if(path->open == 0) {
+        lv_raster_move_to(path, x, y);
+        return;
+    }
+
+    add_edge(path, path->last_x, path->last_y, x, y);
+    path->last_x = x;
+    path->last_y = y;
+    add_point(path, x, y);
+}
+
+/**
+ * Add an arc to the current contour. If there is no current contour a new one is started with the arc.
+ * Angles follow `lv_draw_arc`: 0 deg on the bottom, 90 deg on the right.
+ * @param path pointer to a path
+ * @param cx x coordinate of the center [1/256 px]
+ * @param cy y coordinate of the center [1/256 px]
+ * @param r radius [1/256 px]
+ * @param start_angle the angle of the first point [deg]
+ * @param end_angle the angle of the last point [deg]. Can be smaller than `start_angle` to go backward.
+ */
+void lv_raster_arc_to(lv_raster_path_t * path, int32_t cx, int32_t cy, int32_t r, int16_t start_angle,
+                      int16_t end_angle)
+{
+    int32_t span = end_angle - start_angle;
+    int16_t step = arc_get_step(r);
+    int32_t n    = (LV_MATH_ABS(span) + step - 1) / step;
+    if(n < 1) n = 1;
+
+    int32_t i;
+    for(i = 0; i <= n; i++) {
+        int16_t angle = start_angle + (span * i) / n;
+        int32_t x     = cx + (((int64_t)r * lv_trigo_sin(angle)) >> LV_TRIGO_SHIFT);
+        int32_t y     = cy + (((int64_t)r * lv_trigo_sin(angle + 90)) >> LV_TRIGO_SHIFT);
+        lv_raster_line_to(path, x, y);
+    }
+}
+
+/**
+ * Add a rectangle with rounded corners as a new contour
+ * @param path pointer to a path
+ * @param area the rectangle (in pixels, `x2` and `y2` are included)
+ * @param radius radius of the corners (in pixels)
+ */
+void lv_raster_add_rect(lv_raster_path_t * path, const lv_area_t * area, lv_coord_t radius)
+{
+    int32_t x1 = (int32_t)area->x1 * LV_RASTER_ONE;
+    int32_t y1 = (int32_t)area->y1 * LV_RASTER_ONE;
+    int32_t x2 = (int32_t)(area->x2 + 1) * LV_RASTER_ONE;
+    int32_t y2 = (int32_t)(area->y2 + 1) * LV_RASTER_ONE;
+
+    lv_coord_t short_side = LV_MATH_MIN(lv_area_get_width(area), lv_area_get_height(area));
+    if(radius > short_side / 2) radius = short_side / 2;
+
+    lv_raster_close(path);
+
+    if(radius <= 0) {
+        lv_raster_move_to(path, x1, y1);
+        lv_raster_line_to(path, x2, y1);
+        lv_raster_line_to(path, x2, y2);
+        lv_raster_line_to(path, x1, y2);
+    } else {
+        int32_t r = (int32_t)radius * LV_RASTER_ONE;
+        lv_raster_arc_to(path, x1 + r, y1 + r, r, 270, 180); /*Left top*/
+        lv_raster_arc_to(path, x2 - r, y1 + r, r, 180, 90);  /*Right top*/
+        lv_raster_arc_to(path, x2 - r, y2 - r, r, 90, 0);    /*Right bottom*/
+        lv_raster_arc_to(path, x1 + r, y2 - r, r, 0, -90);   /*Left bottom*/
+    }
+
+    lv_raster_close(path);
+}
+
+/**
+ * Close the current contour with a line to its first point
+ * @param path pointer to a path
+ */
+void lv_raster_close(lv_raster_path_t * path)
+{
+    if(path->open == 0) return;
+
+    add_edge(path, path->last_x, path->last_y, path->start_x, path->start_y);
+    path->open = 0;
+}
+
+/**
+ * Fill the inside of a path (non-zero rule). The pixels on the edges get opacity by their coverage.
+ * @param path pointer to a path. Its current contour is closed.
+ * @param mask fill only on this area
+ * @param color color of the fill
+ * @param opa opacity of the fill
+ * @param aa true: anti-aliased edges; false: a pixel is filled if at least half of it is covered
+ */
+void lv_raster_fill(lv_raster_path_t * path, const lv_area_t * mask, lv_color_t color, lv_opa_t opa, bool aa)
+{
+    lv_raster_close(path);
+
+    if(path->edge_cnt == 0) return;
+    if(opa < LV_OPA_MIN) return;
+
+    /*Rasterize only the rows and columns of the path on the mask*/
+    lv_area_t path_area;
+    path_area.x1 = raster_floor(path->x_min);
+    path_area.y1 = raster_floor(path->y_min);
+    path_area.x2 = raster_floor(path->x_max + RASTER_FRACT_MASK) - 1;
+    path_area.y2 = raster_floor(path->y_max + RASTER_FRACT_MASK) - 1;
+
+    lv_area_t clip;
+    if(lv_area_intersect(&clip, &path_area, mask) == false) return;
+
+    /*The edges are already in the draw buffer. Put the cells after them.*/
+    uint32_t edge_size = path->edge_cnt * sizeof(lv_raster_edge_t);
+    uint32_t cell_num  = lv_area_get_width(&clip) + 1;
+    uint8_t * buf      = lv_draw_get_buf(edge_size + 2 * cell_num * sizeof(int32_t));
+
+    const lv_raster_edge_t * edges = (const lv_raster_edge_t *)buf;
+    lv_raster_row_t row;
+    row.cover = (int32_t *)&buf[edge_size];
+    row.area  = row.cover + cell_num;
+    row.x1    = clip.x1;
+    row.x2    = clip.x2;
+
+    lv_coord_t y;
+    for(y = clip.y1; y <= clip.y2; y++) {
+        memset(row.cover, 0, 2 * cell_num * sizeof(int32_t));
+
+        int32_t row_y = (int32_t)y * LV_RASTER_ONE;
+        uint32_t i;
+        for(i = 0; i < path->edge_cnt; i++) {
+            if(edges[i].y1 <= row_y || edges[i].y0 >= row_y + LV_RASTER_ONE) continue;
+            row_add_edge(&row, &edges[i], row_y);
+        }
+
+        row_draw(&row, y, &clip, color, opa, aa);
+    }
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Store an edge of the path in the draw buffer
+ * @param path pointer to a path
+ * @param x0 x coordinate of the start point
+ * @param y0 y coordinate of the start point
+ * @param x1 x coordinate of the end point
+ * @param y1 y coordinate of the end point
+ */
+static void add_edge(lv_raster_path_t * path, int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+    /*Horizontal edges don't change the coverage*/
+    if(y0 == y1) return;
+
+    uint32_t edge_max        = ((path->edge_cnt / RASTER_EDGE_CHUNK) + 1) * RASTER_EDGE_CHUNK;
+    lv_raster_edge_t * edges = lv_draw_get_buf(edge_max * sizeof(lv_raster_edge_t));
+    lv_raster_edge_t * edge  = &edges[path->edge_cnt];
+    path->edge_cnt++;
+
+    if(y0 < y1) {
+        edge->x0  = x0;
+        edge->y0  = y0;
+        edge->x1  = x1;
+        edge->y1  = y1;
+        edge->dir = 1;
+    } else {
+        edge->x0  = x1;
+        edge->y0  = y1;
+        edge->x1  = x0;
+        edge->y1  = y0;
+        edge->dir = -1;
+    }
+}
+
+/**
+ * Extend the bounding box of a path with a point
+ * @param path pointer to a path
+ * @param x x coordinate of the point
+ * @param y y coordinate of the point
+ */
+static void add_point(lv_raster_path_t * path, int32_t x, int32_t y)
+{
+    if(x < path->x_min) path->x_min = x;
+    if(x > path->x_max) path->x_max = x;
+    if(y < path->y_min) path->y_min = y;
+    if(y > path->y_max) path->y_max = y;
+}
+
+/**
+ * Add the part of an edge in a row to the cells it passes
+ * @param row pointer to the row
+ * @param edge pointer to an edge crossing the row
+ * @param row_y the top of the row
+ */
+static void row_add_edge(lv_raster_row_t * row, const lv_raster_edge_t * edge, int32_t row_y)
+{
+    /*Cut the edge to the row*/
+    int32_t ya = LV_MATH_MAX(edge->y0, row_y);
+    int32_t yb = LV_MATH_MIN(edge->y1, row_y + LV_RASTER_ONE);
+    int32_t dx = edge->x1 - edge->x0;
+    int32_t dy = edge->y1 - edge->y0;
+    int32_t xa = edge->x0 + (int32_t)(((int64_t)(ya - edge->y0) * dx) / dy);
+    int32_t xb = edge->x0 + (int32_t)(((int64_t)(yb - edge->y0) * dx) / dy);
+
+    ya -= row_y;
+    yb -= row_y;
+
+    int32_t cell_x    = raster_floor(xa);
+    int32_t cell_end  = raster_floor(xb);
+    int32_t cell_step = xb > xa ? 1 : -1;
+
+    /*Walk the cells from `xa` to `xb` and split the edge on the cell borders*/
+    while(cell_x != cell_end) {
+        int32_t border_x = (cell_step > 0 ? cell_x + 1 : cell_x) * LV_RASTER_ONE;
+        int32_t border_y = ya + (int32_t)(((int64_t)(border_x - xa) * (yb - ya)) / (xb - xa));
+        row_add_cell(row, cell_x, xa, ya, border_x, border_y, edge->dir);
+
+        xa = border_x;
+        ya = border_y;
+        cell_x += cell_step;
+    }
+
+    row_add_cell(row, cell_x, xa, ya, xb, yb, edge->dir);
+}
+
+/**
+ * Add a part of an edge which is in one cell
+ * @param row pointer to the row
+ * @param cell_x the column of the cell
+ * @param x0 x coordinate of the start of the edge part
+ * @param y0 y coordinate of the start of the edge part (relative to the row)
+ * @param x1 x coordinate of the end of the edge part
+ * @param y1 y coordinate of the end of the edge part (relative to the row)
+ * @param dir direction of the edge
+ */
+static void row_add_cell(lv_raster_row_t * row, int32_t cell_x, int32_t x0, int32_t y0, int32_t x1, int32_t y1,
+                         int32_t dir)
+{
+    /*Only the cells on the right side depend on it*/
+    if(cell_x > row->x2) return;
+
+    int32_t cover = (y1 - y0) * dir;
+
+    /*Left to the clip area it covers the whole row*/
+    if(cell_x < row->x1) {
+        row->cover[0] += cover;
+        return;
+    }
+
+    int32_t cell_start = cell_x * LV_RASTER_ONE;
+    uint32_t i         = cell_x - row->x1 + 1;
+    row->cover[i] += cover;
+    row->area[i] += cover * ((x0 - cell_start) + (x1 - cell_start));
+}
+
+/**
+ * Accumulate the cells of a row to get the coverage of the pixels and draw the runs of equally covered pixels
+ * @param row pointer to a row with the added edges
+ * @param y the y coordinate of the row
+ * @param mask draw only on this area
+ * @param color color of the fill
+ * @param opa opacity of the fill
+ * @param aa true: use the coverage as opacity; false: draw the pixels at least half covered
+ */
+static void row_draw(const lv_raster_row_t * row, lv_coord_t y, const lv_area_t * mask, lv_color_t color,
+                     lv_opa_t opa, bool aa)
+{
+    int32_t acc        = row->cover[0] * LV_RASTER_ONE;
+    lv_coord_t run_x   = row->x1;
+    uint16_t run_cover = 0;
+    lv_coord_t x;
+    for(x = row->x1; x <= row->x2; x++) {
+        uint32_t i = x - row->x1 + 1;
+
+        /*The edges in the cell cover the area right to them*/
+        int32_t px_cover = acc + row->cover[i] * LV_RASTER_ONE - row->area[i] / 2;
+        acc += row->cover[i] * LV_RASTER_ONE;
+
+        if(px_cover < 0) px_cover = -px_cover;
+        if(px_cover > RASTER_FULL_COVER) px_cover = RASTER_FULL_COVER;
+
+        uint16_t cover;
+        if(aa)
+            cover = px_cover >> LV_RASTER_SHIFT;
+        else
+            cover = px_cover >= RASTER_FULL_COVER / 2 ? LV_RASTER_ONE : 0;
+
+        if(cover != run_cover) {
+            draw_span(run_x, x - 1, y, mask, color, opa, run_cover);
+            run_x     = x;
+            run_cover = cover;
+        }
+    }
+
+    draw_span(run_x, row->x2, y, mask, color, opa, run_cover);
+}
+
+/**
+ * Draw horizontal run of pixels with the same coverage
+ * @param x1 the first pixel
+ * @param x2 the last pixel
+ * @param y the y coordinate of the run
+ * @param mask draw only on this area
+ * @param color color of the fill
+ * @param opa opacity of the fill
+ * @param cover coverage of the pixels [0..LV_RASTER_ONE]
+ */
+static void draw_span(lv_coord_t x1, lv_coord_t x2, lv_coord_t y, const lv_area_t * mask, lv_color_t color,
+                      lv_opa_t opa, uint16_t cover)
+{
+    if(cover == 0 || x1 > x2) return;
+
+    lv_area_t span;
+    span.x1 = x1;
+    span.x2 = x2;
+    span.y1 = y;
+    span.y2 = y;
+
+    lv_opa_t span_opa = cover >= LV_RASTER_ONE ? opa : (uint16_t)((uint16_t)opa * cover) >> LV_RASTER_SHIFT;
+    lv_draw_fill(&span, mask, color, span_opa);
+}
+
+/**
+ * Round down a raster coordinate to pixel
+ * @param v a coordinate [1/256 px]
+ * @return the pixel containing the coordinate
+ */
+static int32_t raster_floor(int32_t v)
+{
+    if(v >= 0) return v >> LV_RASTER_SHIFT;
+
+    return -((-v + RASTER_FRACT_MASK) >> LV_RASTER_SHIFT);
+}
+
+/**
+ * Get the angle between the points of an arc to keep the arc's error below 1/16 pixel
+ * @param r radius of the arc [1/256 px]
+ * @return the angle between the points [deg]
+ */
+static int16_t arc_get_step(int32_t r)
+{
+    /*The error of a chord is about `r * step^2 / 8` (step in radian)*/
+    uint32_t r_px = r >> LV_RASTER_SHIFT;
+    if(r_px < 1) r_px = 1;
+
+    int16_t step = 40 / lv_sqrt(r_px);
+    if(step < 1) step = 1;
+    if(step > RASTER_ARC_STEP_MAX) step = RASTER_ARC_STEP_MAX;
+
+    return step;
+}
+
+#endif /*LV_USE_DRAW_RASTER*/
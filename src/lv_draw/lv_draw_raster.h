@@ -0,0 +1,123 @@
+/**
+ * @file lv_draw_raster.h
+ * Anti-aliased scanline rasterizer for paths of line segments and arcs
+ */
+
+#ifndef LV_DRAW_RASTER_H
+#define LV_DRAW_RASTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw.h"
+
+#if LV_USE_DRAW_RASTER
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The coordinates of the paths are in 1/256 pixel units. (0;0) is the top left corner of the top left pixel.*/
+#define LV_RASTER_SHIFT 8
+#define LV_RASTER_ONE (1 << LV_RASTER_SHIFT)
+
+/*Convert a pixel coordinate to the center of the pixel in raster coordinates*/
+#define LV_RASTER_PX(c) ((int32_t)(c) * LV_RASTER_ONE + (LV_RASTER_ONE >> 1))
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A path of closed contours.
+ * The edges are stored in the draw buffer (`lv_draw_get_buf`) so only one path can be built at a time.*/
+typedef struct
+{
+    uint32_t edge_cnt; /**< Number of stored edges*/
+    int32_t x_min;     /**< Bounding box of the path*/
+    int32_t y_min;
+    int32_t x_max;
+    int32_t y_max;
+    int32_t start_x; /**< First point of the current contour*/
+    int32_t start_y;
+    int32_t last_x; /**< Last point of the current contour*/
+    int32_t last_y;
+    uint8_t open : 1; /**< 1: a contour is started*/
+} lv_raster_path_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Start a new, empty path
+ * @param path pointer to a path to initialize
+ */
+void lv_raster_path_init(lv_raster_path_t * path);
+
+/**
+ * Start a new contour. The current contour is closed.
+ * @param path pointer to a path
+ * @param x x coordinate of the first point [1/256 px]
+ * @param y y coordinate of the first point [1/256 px]
+ */
+void lv_raster_move_to(lv_raster_path_t * path, int32_t x, int32_t y);
+
+/**
+ * Add a line segment to the current contour
+ * @param path pointer to a path
+ * @param x x coordinate of the end point [1/256 px]
+ * @param y y coordinate of the end point [1/256 px]
+ */
+void lv_raster_line_to(lv_raster_path_t * path, int32_t x, int32_t y);
+
+/**
+ * Add an arc to the current contour. If there is no current contour a new one is started with the arc.
+ * Angles follow `lv_draw_arc`: 0 deg on the bottom, 90 deg on the right.
+ * @param path pointer to a path
+ * @param cx x coordinate of the center [1/256 px]
+ * @param cy y coordinate of the center [1/256 px]
+ * @param r radius [1/256 px]
+ * @param start_angle the angle of the first point [deg]
+ * @param end_angle the angle of the last point [deg]. Can be smaller than `start_angle` to go backward.
+ */
+void lv_raster_arc_to(lv_raster_path_t * path, int32_t cx, int32_t cy, int32_t r, int16_t start_angle,
+                      int16_t end_angle);
+
+/**
+ * Add a rectangle with rounded corners as a new contour
+ * @param path pointer to a path
+ * @param area the rectangle (in pixels, `x2` and `y2` are included)
+ * @param radius radius of the corners (in pixels)
+ */
+void lv_raster_add_rect(lv_raster_path_t * path, const lv_area_t * area, lv_coord_t radius);
+
+/**
+ * Close the current contour with a line to its first point
+ * @param path pointer to a path
+ */
+void lv_raster_close(lv_raster_path_t * path);
+
+/**
+ * Fill the inside of a path (non-zero rule). The pixels on the edges get opacity by their coverage.
+ * @param path pointer to a path. Its current contour is closed.
+ * @param mask fill only on this area
+ * @param color color of the fill
+ * @param opa opacity of the fill
+ * @param aa true: anti-aliased edges; false: a pixel is filled if at least half of it is covered
+ */
+void lv_raster_fill(lv_raster_path_t * path, const lv_area_t * mask, lv_color_t color, lv_opa_t opa, bool aa);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_RASTER*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_DRAW_RASTER_H*/
@@ -10,6 +10,12 @@
 #include "../lv_misc/lv_circ.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_core/lv_refr.h"
+#include "../lv_misc/lv_gc.h"
+#include "../lv_core/lv_prof.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -24,10 +30,27 @@
 /*Add extra radius with LV_SHADOW_BOTTOM to cover anti-aliased corners*/
 #define SHADOW_BOTTOM_AA_EXTRA_RADIUS 3
 
+/*Don't cache the shadow corners which would require more memory than this [bytes]*/
+#define SHADOW_CACHE_ENTRY_MAX_SIZE (4 * 1024)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE > 0
+/*The pre-calculated corner of a full shadow*/
+typedef struct
+{
+    lv_coord_t * curve_x; /*The 'x' coordinates of a quarter circle. Start of the allocated data (NULL: unused)*/
+    uint16_t * col_cnt;   /*Number of opacity values to use from every line of `blur`*/
+    lv_opa_t * blur;      /*The 2D blurred opacities. `radius + swidth + 1` lines with the same length*/
+    uint32_t last_use;    /*Stamp of the last use to find the least recently used entry*/
+    lv_coord_t radius;
+    lv_coord_t swidth;
+    lv_opa_t opa;
+} lv_shadow_cache_entry_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -49,17 +72,29 @@ static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * ma
                                   lv_opa_t opa_scale);
 static void lv_draw_shadow_full_straight(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
                                          const lv_opa_t * map);
+static void shadow_full_calc_curve(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa, lv_coord_t * curve_x,
+                                   uint32_t * line_1d_blur);
+static uint16_t shadow_full_calc_line(int16_t line, lv_coord_t radius, lv_coord_t swidth, const lv_coord_t * curve_x,
+                                      const uint32_t * line_1d_blur, lv_opa_t * line_2d_blur);
+#if LV_SHADOW_CACHE_SIZE > 0
+static lv_shadow_cache_entry_t * shadow_cache_get(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa);
+#endif
 #endif
 
 static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h);
 
 #if LV_ANTIALIAS
+static void lv_draw_rect_corner_px(const lv_area_t * coords, const lv_style_t * style, lv_coord_t x, lv_coord_t y,
+                                   const lv_area_t * mask, lv_color_t color, lv_opa_t opa);
 static lv_opa_t antialias_get_opa_circ(lv_coord_t seg, lv_coord_t px_id, lv_opa_t opa);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE > 0
+static uint32_t shadow_cache_stamp;
+#endif
 
 /**********************
  *      MACROS
@@ -80,6 +115,10 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_sty
 {
     if(lv_area_get_height(coords) < 1 || lv_area_get_width(coords) < 1) return;
 
+#if LV_USE_PROF
+    uint32_t prof_start = lv_prof_get_time();
+#endif
+
 #if LV_USE_SHADOW
     if(style->body.shadow.width != 0) {
         lv_draw_shadow(coords, mask, style, opa_scale);
@@ -106,6 +145,30 @@ void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_sty
             lv_draw_rect_border_corner(coords, mask, style, opa_scale);
         }
     }
+
+#if LV_USE_PROF
+    lv_prof_draw(LV_PROF_DRAW_RECT, prof_start, coords, mask);
+#endif
+}
+
+/**
+ * Free the cached shadow corners.
+ * They will be calculated and cached again when they are drawn.
+ */
+void lv_draw_shadow_cache_clean(void)
+{
+#if LV_USE_SHADOW && LV_SHADOW_CACHE_SIZE > 0
+    lv_shadow_cache_entry_t * cache = LV_GC_ROOT(_lv_shadow_cache_array);
+    if(cache == NULL) return;
+
+    uint16_t i;
+    for(i = 0; i < LV_SHADOW_CACHE_SIZE; i++) {
+        if(cache[i].curve_x) lv_mem_free(cache[i].curve_x);
+    }
+
+    lv_mem_free(cache);
+    LV_GC_ROOT(_lv_shadow_cache_array) = NULL;
+#endif
 }
 
 /**********************
@@ -127,7 +190,6 @@ static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * ma
 
     lv_color_t mcolor = style->body.main_color;
     lv_color_t gcolor = style->body.grad_color;
-    uint8_t mix;
     lv_coord_t height = lv_area_get_height(coords);
     lv_coord_t width  = lv_area_get_width(coords);
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
@@ -158,30 +220,20 @@ static void lv_draw_rect_main_mid(const lv_area_t * coords, const lv_area_t * ma
 
         lv_draw_fill(&work_area, mask, mcolor, opa);
     } else {
-        lv_coord_t row;
-        lv_coord_t row_start = coords->y1 + radius;
-        lv_coord_t row_end   = coords->y2 - radius;
-        lv_color_t act_color;
+        work_area.y1 = coords->y1 + radius;
+        work_area.y2 = coords->y2 - radius;
 
         if(style->body.radius != 0) {
             if(aa) {
-                row_start += 2;
-                row_end -= 2;
+                work_area.y1 += 2;
+                work_area.y2 -= 2;
             } else {
-                row_start += 1;
-                row_end -= 1;
+                work_area.y1 += 1;
+                work_area.y2 -= 1;
             }
         }
-        if(row_start < 0) row_start = 0;
 
-        for(row = row_start; row <= row_end; row++) {
-            work_area.y1 = row;
-            work_area.y2 = row;
-            mix          = (uint32_t)((uint32_t)(coords->y2 - work_area.y1) * 255) / height;
-            act_color    = lv_color_mix(mcolor, gcolor, mix);
-
-            lv_draw_fill(&work_area, mask, act_color, opa);
-        }
+        lv_draw_grad_fill(&work_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
     }
 }
 /**
@@ -199,9 +251,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
 
     lv_color_t mcolor = style->body.main_color;
     lv_color_t gcolor = style->body.grad_color;
-    lv_color_t act_color;
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
-    uint8_t mix;
     lv_coord_t height = lv_area_get_height(coords);
     lv_coord_t width  = lv_area_get_width(coords);
 
@@ -254,6 +304,7 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
     lv_color_t aa_color_hor_top;
     lv_color_t aa_color_hor_bottom;
     lv_color_t aa_color_ver;
+    uint8_t mix;
 #endif
 
     while(lv_circ_cont(&cir)) {
@@ -282,27 +333,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
                         aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
                     }
 
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                               aa_color_hor_bottom, aa_opa);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                               aa_color_hor_top, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i,
+                                           rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask, aa_color_hor_bottom, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i,
+                                           lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask, aa_color_hor_bottom, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i,
+                                           lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask, aa_color_hor_top, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i,
+                                           rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask, aa_color_hor_top, aa_opa);
 
                     mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
                     aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-                    lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask,
-                               aa_color_ver, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1,
+                                           rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1,
+                                           lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver, aa_opa);
 
                     aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-                    lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
-                    lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask,
-                               aa_color_ver, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1,
+                                           lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver, aa_opa);
+                    lv_draw_rect_corner_px(coords, style, rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1,
+                                           rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver, aa_opa);
                 }
 
                 out_x_last      = cir.x;
@@ -327,44 +378,19 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
 
         /*Draw the areas which are not disabled*/
         if(edge_top_refr != 0) {
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&edge_top_area, mask, act_color, opa);
+            lv_draw_grad_fill(&edge_top_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
         }
 
         if(mid_top_refr != 0) {
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&mid_top_area, mask, act_color, opa);
+            lv_draw_grad_fill(&mid_top_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
         }
 
         if(mid_bot_refr != 0) {
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+            lv_draw_grad_fill(&mid_bot_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
         }
 
         if(edge_bot_refr != 0) {
-
-            if(mcolor.full == gcolor.full)
-                act_color = mcolor;
-            else {
-                mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
-                act_color = lv_color_mix(mcolor, gcolor, mix);
-            }
-            lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+            lv_draw_grad_fill(&edge_bot_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
         }
 
         /*Save the current coordinates*/
@@ -383,42 +409,16 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         lv_circ_next(&cir, &cir_tmp);
     }
 
-    if(mcolor.full == gcolor.full)
-        act_color = mcolor;
-    else {
-        mix       = (uint32_t)((uint32_t)(coords->y2 - edge_top_area.y1) * 255) / height;
-        act_color = lv_color_mix(mcolor, gcolor, mix);
-    }
-    lv_draw_fill(&edge_top_area, mask, act_color, opa);
+    lv_draw_grad_fill(&edge_top_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
 
     if(edge_top_area.y1 != mid_top_area.y1) {
-
-        if(mcolor.full == gcolor.full)
-            act_color = mcolor;
-        else {
-            mix       = (uint32_t)((uint32_t)(coords->y2 - mid_top_area.y1) * 255) / height;
-            act_color = lv_color_mix(mcolor, gcolor, mix);
-        }
-        lv_draw_fill(&mid_top_area, mask, act_color, opa);
+        lv_draw_grad_fill(&mid_top_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
     }
 
-    if(mcolor.full == gcolor.full)
-        act_color = mcolor;
-    else {
-        mix       = (uint32_t)((uint32_t)(coords->y2 - mid_bot_area.y1) * 255) / height;
-        act_color = lv_color_mix(mcolor, gcolor, mix);
-    }
-    lv_draw_fill(&mid_bot_area, mask, act_color, opa);
+    lv_draw_grad_fill(&mid_bot_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
 
     if(edge_bot_area.y1 != mid_bot_area.y1) {
-
-        if(mcolor.full == gcolor.full)
-            act_color = mcolor;
-        else {
-            mix       = (uint32_t)((uint32_t)(coords->y2 - edge_bot_area.y1) * 255) / height;
-            act_color = lv_color_mix(mcolor, gcolor, mix);
-        }
-        lv_draw_fill(&edge_bot_area, mask, act_color, opa);
+        lv_draw_grad_fill(&edge_bot_area, mask, coords, mcolor, gcolor, style->body.grad_dir, opa);
     }
 
 #if LV_ANTIALIAS
@@ -428,11 +428,19 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         edge_top_area.x2 = coords->x2 - radius - 2;
         edge_top_area.y1 = coords->y1;
         edge_top_area.y2 = coords->y1;
-        lv_draw_fill(&edge_top_area, mask, style->body.main_color, opa);
+        if(style->body.grad_dir == LV_GRAD_DIR_HOR) {
+            lv_draw_grad_fill(&edge_top_area, mask, coords, mcolor, gcolor, LV_GRAD_DIR_HOR, opa);
+        } else {
+            lv_draw_fill(&edge_top_area, mask, style->body.main_color, opa);
+        }
 
         edge_top_area.y1 = coords->y2;
         edge_top_area.y2 = coords->y2;
-        lv_draw_fill(&edge_top_area, mask, style->body.grad_color, opa);
+        if(style->body.grad_dir == LV_GRAD_DIR_HOR) {
+            lv_draw_grad_fill(&edge_top_area, mask, coords, mcolor, gcolor, LV_GRAD_DIR_HOR, opa);
+        } else {
+            lv_draw_fill(&edge_top_area, mask, style->body.grad_color, opa);
+        }
 
         /*Last parts of the anti-alias*/
         out_y_seg_end       = cir.y;
@@ -449,27 +457,27 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
         lv_coord_t i;
         for(i = 0; i < seg_size; i++) {
             lv_opa_t aa_opa = opa - lv_draw_aa_get_opa(seg_size, i, opa);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i, rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i, lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask,
-                       aa_color_hor_top, aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i, lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i, rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask,
-                       aa_color_hor_bottom, aa_opa);
+            lv_draw_rect_corner_px(coords, style, rb_origo.x + LV_CIRC_OCT2_X(aa_p) + i,
+                                   rb_origo.y + LV_CIRC_OCT2_Y(aa_p) + 1, mask, aa_color_hor_top, aa_opa);
+            lv_draw_rect_corner_px(coords, style, lb_origo.x + LV_CIRC_OCT3_X(aa_p) - i,
+                                   lb_origo.y + LV_CIRC_OCT3_Y(aa_p) + 1, mask, aa_color_hor_top, aa_opa);
+            lv_draw_rect_corner_px(coords, style, lt_origo.x + LV_CIRC_OCT6_X(aa_p) - i,
+                                   lt_origo.y + LV_CIRC_OCT6_Y(aa_p) - 1, mask, aa_color_hor_bottom, aa_opa);
+            lv_draw_rect_corner_px(coords, style, rt_origo.x + LV_CIRC_OCT7_X(aa_p) + i,
+                                   rt_origo.y + LV_CIRC_OCT7_Y(aa_p) - 1, mask, aa_color_hor_bottom, aa_opa);
 
             mix          = (uint32_t)((uint32_t)(radius - out_y_seg_start + i) * 255) / height;
             aa_color_ver = lv_color_mix(mcolor, gcolor, mix);
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1, rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1, lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver,
-                       aa_opa);
+            lv_draw_rect_corner_px(coords, style, rb_origo.x + LV_CIRC_OCT1_X(aa_p) + 1,
+                                   rb_origo.y + LV_CIRC_OCT1_Y(aa_p) + i, mask, aa_color_ver, aa_opa);
+            lv_draw_rect_corner_px(coords, style, lb_origo.x + LV_CIRC_OCT4_X(aa_p) - 1,
+                                   lb_origo.y + LV_CIRC_OCT4_Y(aa_p) + i, mask, aa_color_ver, aa_opa);
 
             aa_color_ver = lv_color_mix(gcolor, mcolor, mix);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1, lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1, rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver,
-                       aa_opa);
+            lv_draw_rect_corner_px(coords, style, lt_origo.x + LV_CIRC_OCT5_X(aa_p) - 1,
+                                   lt_origo.y + LV_CIRC_OCT5_Y(aa_p) - i, mask, aa_color_ver, aa_opa);
+            lv_draw_rect_corner_px(coords, style, rt_origo.x + LV_CIRC_OCT8_X(aa_p) + 1,
+                                   rt_origo.y + LV_CIRC_OCT8_Y(aa_p) - i, mask, aa_color_ver, aa_opa);
         }
 
         /*In some cases the last pixel is not drawn*/
@@ -482,14 +490,14 @@ static void lv_draw_rect_main_corner(const lv_area_t * coords, const lv_area_t *
             aa_color_hor_bottom = lv_color_mix(mcolor, gcolor, mix);
 
             lv_opa_t aa_opa = opa >> 1;
-            lv_draw_px(rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p), mask, aa_color_hor_bottom,
-                       aa_opa);
-            lv_draw_px(lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
-            lv_draw_px(rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p), mask, aa_color_hor_top,
-                       aa_opa);
+            lv_draw_rect_corner_px(coords, style, rb_origo.x + LV_CIRC_OCT2_X(aa_p), rb_origo.y + LV_CIRC_OCT2_Y(aa_p),
+                                   mask, aa_color_hor_bottom, aa_opa);
+            lv_draw_rect_corner_px(coords, style, lb_origo.x + LV_CIRC_OCT4_X(aa_p), lb_origo.y + LV_CIRC_OCT4_Y(aa_p),
+                                   mask, aa_color_hor_bottom, aa_opa);
+            lv_draw_rect_corner_px(coords, style, lt_origo.x + LV_CIRC_OCT6_X(aa_p), lt_origo.y + LV_CIRC_OCT6_Y(aa_p),
+                                   mask, aa_color_hor_top, aa_opa);
+            lv_draw_rect_corner_px(coords, style, rt_origo.x + LV_CIRC_OCT8_X(aa_p), rt_origo.y + LV_CIRC_OCT8_Y(aa_p),
+                                   mask, aa_color_hor_top, aa_opa);
         }
     }
 #endif
@@ -1096,7 +1104,10 @@ static void lv_draw_shadow(const lv_area_t * coords, const lv_area_t * mask, con
     if(lv_area_is_in(mask, &area_tmp) != false) return;
 
     if(style->body.shadow.type == LV_SHADOW_FULL) {
+        /*The shadow cache is shared by the displays*/
+        LV_REFR_SHARED_LOCK();
         lv_draw_shadow_full(coords, mask, style, opa_scale);
+        LV_REFR_SHARED_UNLOCK();
     } else if(style->body.shadow.type == LV_SHADOW_BOTTOM) {
         lv_draw_shadow_bottom(coords, mask, style, opa_scale);
     }
@@ -1129,39 +1140,42 @@ static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask
 
     radius += aa;
 
-    /*Allocate a draw buffer the buffer required to draw the shadow*/
-    int16_t filter_width = 2 * swidth + 1;
-    uint32_t curve_x_size = ((radius + swidth + 1) + 3) & ~0x3; /*Round to 4*/
-    curve_x_size *= sizeof(lv_coord_t);
-    uint32_t line_1d_blur_size = (filter_width + 3) & ~0x3;     /*Round to 4*/
-    line_1d_blur_size *= sizeof(uint32_t);
-    uint32_t line_2d_blur_size = ((radius + swidth + 1) + 3) & ~0x3;     /*Round to 4*/
-    line_2d_blur_size *= sizeof(lv_opa_t);
-
-    uint8_t * draw_buf = lv_draw_get_buf(curve_x_size + line_1d_blur_size + line_2d_blur_size);
-
-    /*Divide the draw buffer*/
-    lv_coord_t  * curve_x = (lv_coord_t *)&draw_buf[0]; /*Stores the 'x' coordinates of a quarter circle.*/
-    uint32_t * line_1d_blur = (uint32_t *)&draw_buf[curve_x_size];
-    lv_opa_t * line_2d_blur = (lv_opa_t *)&draw_buf[curve_x_size + line_1d_blur_size];
-
-    memset(curve_x, 0, curve_x_size);
-    lv_point_t circ;
-    lv_coord_t circ_tmp;
-    lv_circ_init(&circ, &circ_tmp, radius);
-    while(lv_circ_cont(&circ)) {
-        curve_x[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
-        curve_x[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
-        lv_circ_next(&circ, &circ_tmp);
-    }
-    int16_t line;
-    /*1D Blur horizontally*/
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
-    for(line = 0; line < filter_width; line++) {
-        line_1d_blur[line] = (uint32_t)((uint32_t)(filter_width - line) * (opa * 2) << SHADOW_OPA_EXTRA_PRECISION) /
-                             (filter_width * filter_width);
+
+    const lv_coord_t * curve_x;
+    const lv_opa_t * line_2d_blur;
+    uint32_t * line_1d_blur = NULL;
+    lv_opa_t * line_2d_blur_buf = NULL;
+
+#if LV_SHADOW_CACHE_SIZE > 0
+    /*Use the pre-calculated corner if possible*/
+    lv_shadow_cache_entry_t * cached = shadow_cache_get(radius, swidth, opa);
+    if(cached) {
+        curve_x = cached->curve_x;
+    } else
+#endif
+    {
+        /*Allocate a draw buffer the buffer required to draw the shadow*/
+        int16_t filter_width = 2 * swidth + 1;
+        uint32_t curve_x_size = ((radius + swidth + 1) + 3) & ~0x3; /*Round to 4*/
+        curve_x_size *= sizeof(lv_coord_t);
+        uint32_t line_1d_blur_size = (filter_width + 3) & ~0x3;     /*Round to 4*/
+        line_1d_blur_size *= sizeof(uint32_t);
+        uint32_t line_2d_blur_size = ((radius + swidth + 1) + 3) & ~0x3;     /*Round to 4*/
+        line_2d_blur_size *= sizeof(lv_opa_t);
+
+        uint8_t * draw_buf = lv_draw_get_buf(curve_x_size + line_1d_blur_size + line_2d_blur_size);
+
+        /*Divide the draw buffer*/
+        lv_coord_t * curve_x_buf = (lv_coord_t *)&draw_buf[0]; /*Stores the 'x' coordinates of a quarter circle.*/
+        line_1d_blur = (uint32_t *)&draw_buf[curve_x_size];
+        line_2d_blur_buf = (lv_opa_t *)&draw_buf[curve_x_size + line_1d_blur_size];
+
+        shadow_full_calc_curve(radius, swidth, opa, curve_x_buf, line_1d_blur);
+        curve_x = curve_x_buf;
     }
 
+    int16_t line;
     uint16_t col;
 
     lv_point_t point_rt;
@@ -1183,43 +1197,16 @@ static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask
 
     ofs_lt.x = coords->x1 + radius + aa;
     ofs_lt.y = coords->y1 + radius + aa;
-    bool line_ready;
     for(line = 0; line <= radius + swidth; line++) { /*Check all rows and make the 1D blur to 2D*/
-        line_ready = false;
-        for(col = 0; col <= radius + swidth; col++) { /*Check all pixels in a 1D blur line (from the origo to last
-                                                         shadow pixel (radius + swidth))*/
-
-            /*Sum the opacities from the lines above and below this 'row'*/
-            int16_t line_rel;
-            uint32_t px_opa_sum = 0;
-            for(line_rel = -swidth; line_rel <= swidth; line_rel++) {
-                /*Get the relative x position of the 'line_rel' to 'line'*/
-                int16_t col_rel;
-                if(line + line_rel < 0) { /*Below the radius, here is the blur of the edge */
-                    col_rel = radius - curve_x[line] - col;
-                } else if(line + line_rel > radius) { /*Above the radius, here won't be more 1D blur*/
-                    break;
-                } else { /*Blur from the curve*/
-                    col_rel = curve_x[line + line_rel] - curve_x[line] - col;
-                }
-
-                /*Add the value of the 1D blur on 'col_rel' position*/
-                if(col_rel < -swidth) { /*Outside of the blurred area. */
-                    if(line_rel == -swidth)
-                        line_ready = true; /*If no data even on the very first line then it wont't
-                                              be anything else in this line*/
-                    break;                 /*Break anyway because only smaller 'col_rel' values will come */
-                } else if(col_rel > swidth)
-                    px_opa_sum += line_1d_blur[0]; /*Inside the not blurred area*/
-                else
-                    px_opa_sum += line_1d_blur[swidth - col_rel]; /*On the 1D blur (+ swidth to align to the center)*/
-            }
-
-            line_2d_blur[col] = px_opa_sum >> SHADOW_OPA_EXTRA_PRECISION;
-            if(line_ready) {
-                col++; /*To make this line to the last one ( drawing will go to '< col')*/
-                break;
-            }
+#if LV_SHADOW_CACHE_SIZE > 0
+        if(cached) {
+            line_2d_blur = &cached->blur[line * (radius + swidth + 1)];
+            col          = cached->col_cnt[line];
+        } else
+#endif
+        {
+            col          = shadow_full_calc_line(line, radius, swidth, curve_x, line_1d_blur, line_2d_blur_buf);
+            line_2d_blur = line_2d_blur_buf;
         }
 
         /*Flush the line*/
@@ -1268,6 +1255,156 @@ static void lv_draw_shadow_full(const lv_area_t * coords, const lv_area_t * mask
     }
 }
 
+/**
+ * Calculate the 'x' coordinates of the shadow's quarter circle and the 1D blur of a full shadow
+ * @param radius radius of the shadow's corner
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @param curve_x store the 'x' coordinates here (`radius + swidth + 1` elements)
+ * @param line_1d_blur store the 1D blur here (`2 * swidth + 1` elements)
+ */
+static void shadow_full_calc_curve(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa, lv_coord_t * curve_x,
+                                   uint32_t * line_1d_blur)
+{
+    memset(curve_x, 0, (radius + swidth + 1) * sizeof(lv_coord_t));
+    lv_point_t circ;
+    lv_coord_t circ_tmp;
+    lv_circ_init(&circ, &circ_tmp, radius);
+    while(lv_circ_cont(&circ)) {
+        curve_x[LV_CIRC_OCT1_Y(circ)] = LV_CIRC_OCT1_X(circ);
+        curve_x[LV_CIRC_OCT2_Y(circ)] = LV_CIRC_OCT2_X(circ);
+        lv_circ_next(&circ, &circ_tmp);
+    }
+
+    /*1D Blur horizontally*/
+    int16_t filter_width = 2 * swidth + 1;
+    int16_t line;
+    for(line = 0; line < filter_width; line++) {
+        line_1d_blur[line] = (uint32_t)((uint32_t)(filter_width - line) * (opa * 2) << SHADOW_OPA_EXTRA_PRECISION) /
+                             (filter_width * filter_width);
+    }
+}
+
+/**
+ * Make the 1D blur to 2D in a line of a full shadow's corner
+ * @param line index of the line from the middle point of the radius
+ * @param radius radius of the shadow's corner
+ * @param swidth width of the shadow
+ * @param curve_x the 'x' coordinates of the quarter circle
+ * @param line_1d_blur the 1D blur
+ * @param line_2d_blur store the opacities of the line here (`radius + swidth + 1` elements)
+ * @return number of elements set in `line_2d_blur`
+ */
+static uint16_t shadow_full_calc_line(int16_t line, lv_coord_t radius, lv_coord_t swidth, const lv_coord_t * curve_x,
+                                      const uint32_t * line_1d_blur, lv_opa_t * line_2d_blur)
+{
+    uint16_t col;
+    bool line_ready = false;
+    for(col = 0; col <= radius + swidth; col++) { /*Check all pixels in a 1D blur line (from the origo to last
+                                                     shadow pixel (radius + swidth))*/
+
+        /*Sum the opacities from the lines above and below this 'row'*/
+        int16_t line_rel;
+        uint32_t px_opa_sum = 0;
+        for(line_rel = -swidth; line_rel <= swidth; line_rel++) {
+            /*Get the relative x position of the 'line_rel' to 'line'*/
+            int16_t col_rel;
+            if(line + line_rel < 0) { /*Below the radius, here is the blur of the edge */
+                col_rel = radius - curve_x[line] - col;
+            } else if(line + line_rel > radius) { /*Above the radius, here won't be more 1D blur*/
+                break;
+            } else { /*Blur from the curve*/
+                col_rel = curve_x[line + line_rel] - curve_x[line] - col;
+            }
+
+            /*Add the value of the 1D blur on 'col_rel' position*/
+            if(col_rel < -swidth) { /*Outside of the blurred area. */
+                if(line_rel == -swidth)
+                    line_ready = true; /*If no data even on the very first line then it wont't
+                                          be anything else in this line*/
+                break;                 /*Break anyway because only smaller 'col_rel' values will come */
+            } else if(col_rel > swidth)
+                px_opa_sum += line_1d_blur[0]; /*Inside the not blurred area*/
+            else
+                px_opa_sum += line_1d_blur[swidth - col_rel]; /*On the 1D blur (+ swidth to align to the center)*/
+        }
+
+        line_2d_blur[col] = px_opa_sum >> SHADOW_OPA_EXTRA_PRECISION;
+        if(line_ready) {
+            col++; /*To make this line to the last one ( drawing will go to '< col')*/
+            break;
+        }
+    }
+
+    return col;
+}
+
+#if LV_SHADOW_CACHE_SIZE > 0
+/**
+ * Get the pre-calculated corner of a full shadow from the cache.
+ * If it's not cached yet calculate it and replace the least recently used entry with it.
+ * @param radius radius of the shadow's corner
+ * @param swidth width of the shadow
+ * @param opa opacity of the shadow
+ * @return pointer to the cache entry or NULL if the corner can't be cached
+ */
+static lv_shadow_cache_entry_t * shadow_cache_get(lv_coord_t radius, lv_coord_t swidth, lv_opa_t opa)
+{
+    uint32_t line_num     = radius + swidth + 1;
+    uint32_t curve_x_size = ((line_num * sizeof(lv_coord_t)) + 3) & ~0x3; /*Round to 4*/
+    uint32_t col_cnt_size = ((line_num * sizeof(uint16_t)) + 3) & ~0x3;   /*Round to 4*/
+    uint32_t blur_size    = line_num * line_num * sizeof(lv_opa_t);
+    if(curve_x_size + col_cnt_size + blur_size > SHADOW_CACHE_ENTRY_MAX_SIZE) return NULL;
+
+    if(LV_GC_ROOT(_lv_shadow_cache_array) == NULL) {
+        LV_GC_ROOT(_lv_shadow_cache_array) = lv_mem_alloc(sizeof(lv_shadow_cache_entry_t) * LV_SHADOW_CACHE_SIZE);
+        if(LV_GC_ROOT(_lv_shadow_cache_array) == NULL) return NULL;
+        memset(LV_GC_ROOT(_lv_shadow_cache_array), 0, sizeof(lv_shadow_cache_entry_t) * LV_SHADOW_CACHE_SIZE);
+    }
+
+    lv_shadow_cache_entry_t * cache = LV_GC_ROOT(_lv_shadow_cache_array);
+    shadow_cache_stamp++;
+
+    /*Is the corner cached? Else find the least recently used entry*/
+    lv_shadow_cache_entry_t * entry = &cache[0];
+    uint16_t i;
+    for(i = 0; i < LV_SHADOW_CACHE_SIZE; i++) {
+        if(cache[i].curve_x && cache[i].radius == radius && cache[i].swidth == swidth && cache[i].opa == opa) {
+            cache[i].last_use = shadow_cache_stamp;
+            return &cache[i];
+        }
+
+        if(cache[i].last_use < entry->last_use) entry = &cache[i];
+    }
+
+    if(entry->curve_x) lv_mem_free(entry->curve_x);
+    memset(entry, 0, sizeof(lv_shadow_cache_entry_t));
+
+    /*Don't assert here: if there is no memory for the cache the shadow is simply calculated on the fly*/
+    uint8_t * data = lv_mem_alloc(curve_x_size + col_cnt_size + blur_size);
+    if(data == NULL) return NULL;
+
+    entry->curve_x  = (lv_coord_t *)&data[0];
+    entry->col_cnt  = (uint16_t *)&data[curve_x_size];
+    entry->blur     = (lv_opa_t *)&data[curve_x_size + col_cnt_size];
+    entry->radius   = radius;
+    entry->swidth   = swidth;
+    entry->opa      = opa;
+    entry->last_use = shadow_cache_stamp;
+
+    uint32_t * line_1d_blur = lv_draw_get_buf(((2 * swidth + 1) + 3) * sizeof(uint32_t));
+    shadow_full_calc_curve(radius, swidth, opa, entry->curve_x, line_1d_blur);
+
+    int16_t line;
+    for(line = 0; line < (int16_t)line_num; line++) {
+        entry->col_cnt[line] = shadow_full_calc_line(line, radius, swidth, entry->curve_x, line_1d_blur,
+                                                     &entry->blur[line * line_num]);
+    }
+
+    return entry;
+}
+#endif
+
 static void lv_draw_shadow_bottom(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style,
                                   lv_opa_t opa_scale)
 {
@@ -1443,6 +1580,26 @@ static uint16_t lv_draw_cont_radius_corr(uint16_t r, lv_coord_t w, lv_coord_t h)
 
 #if LV_ANTIALIAS
 
+/**
+ * Draw an anti-aliasing pixel on the corner of a rectangle's body
+ * @param coords the coordinates of the original rectangle
+ * @param style pointer to a rectangle style
+ * @param x x coordinate of the pixel
+ * @param y y coordinate of the pixel
+ * @param mask the pixel will be drawn only on this area
+ * @param color color of the pixel. Replaced by the gradient's color in `x` with horizontal gradient.
+ * @param opa opacity of the pixel
+ */
+static void lv_draw_rect_corner_px(const lv_area_t * coords, const lv_style_t * style, lv_coord_t x, lv_coord_t y,
+                                   const lv_area_t * mask, lv_color_t color, lv_opa_t opa)
+{
+    if(style->body.grad_dir == LV_GRAD_DIR_HOR) {
+        color = lv_draw_grad_get_color(coords, style->body.main_color, style->body.grad_color, LV_GRAD_DIR_HOR, x, y);
+    }
+
+    lv_draw_px(x, y, mask, color, opa);
+}
+
 /**
  * Approximate the opacity for anti-aliasing.
  * Used  the first segment of a circle which is the longest and have the most non-linearity (cos)
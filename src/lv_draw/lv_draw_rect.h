@@ -36,6 +36,12 @@ extern "C" {
  */
 void lv_draw_rect(const lv_area_t * coords, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa_scale);
 
+/**
+ * Free the cached shadow corners.
+ * They will be calculated and cached again when they are drawn.
+ */
+void lv_draw_shadow_cache_clean(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_draw_triangle.h"
 #include "../lv_misc/lv_math.h"
+#include "../lv_core/lv_refr.h"
 
 /*********************
  *      DEFINES
@@ -20,9 +21,14 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_USE_DRAW_RASTER
+static void raster_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                           const lv_style_t * style, lv_opa_t opa_scale);
+#else
 void tri_draw_flat(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa);
 void tri_draw_tall(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa);
 static void point_swap(lv_point_t * p1, lv_point_t * p2);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -53,6 +59,9 @@ void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask, const l
     if(points[0].x == points[1].x && points[1].x == points[2].x) return;
     if(points[0].y == points[1].y && points[1].y == points[2].y) return;
 
+#if LV_USE_DRAW_RASTER
+    raster_polygon(points, 3, mask, style, opa_scale);
+#else
     lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
 
     /*Is the triangle flat or tall?*/
@@ -75,10 +84,12 @@ void lv_draw_triangle(const lv_point_t * points, const lv_area_t * mask, const l
     else {
         tri_draw_flat(points, mask, style, opa);
     }
+#endif
 }
 
 /**
- * Draw a polygon from triangles. Only convex polygons are supported
+ * Draw a polygon. With `LV_USE_DRAW_RASTER` any (even concave or self-intersecting) polygon can be drawn,
+ * else it's drawn from triangles and only convex polygons are supported
  * @param points an array of points
  * @param point_cnt number of points
  * @param mask polygon will be drawn only in this mask
@@ -91,6 +102,9 @@ void lv_draw_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_are
     if(point_cnt < 3) return;
     if(points == NULL) return;
 
+#if LV_USE_DRAW_RASTER
+    raster_polygon(points, point_cnt, mask, style, opa_scale);
+#else
     uint32_t i;
     lv_point_t tri[3];
     tri[0].x = points[0].x;
@@ -102,12 +116,42 @@ void lv_draw_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_are
         tri[2].y = points[i + 1].y;
         lv_draw_triangle(tri, mask, style, opa_scale);
     }
+#endif
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_USE_DRAW_RASTER
+/**
+ * Fill a polygon with the rasterizer. The edges go through the middle of the points' pixels.
+ * @param points an array of points
+ * @param point_cnt number of points
+ * @param mask polygon will be drawn only in this mask
+ * @param style style of the polygon
+ * @param opa_scale scale down all opacities by the factor (0..255)
+ */
+static void raster_polygon(const lv_point_t * points, uint32_t point_cnt, const lv_area_t * mask,
+                           const lv_style_t * style, lv_opa_t opa_scale)
+{
+    lv_opa_t opa = opa_scale == LV_OPA_COVER ? style->body.opa : (uint16_t)((uint16_t)style->body.opa * opa_scale) >> 8;
+    bool aa      = lv_disp_get_antialiasing(lv_refr_get_disp_refreshing());
+
+    lv_raster_path_t path;
+    lv_raster_path_init(&path);
+
+    lv_raster_move_to(&path, LV_RASTER_PX(points[0].x), LV_RASTER_PX(points[0].y));
+    uint32_t i;
+    for(i = 1; i < point_cnt; i++) {
+        lv_raster_line_to(&path, LV_RASTER_PX(points[i].x), LV_RASTER_PX(points[i].y));
+    }
+
+    lv_raster_fill(&path, mask, style->body.main_color, opa, aa);
+}
+
+#else
+
 void tri_draw_flat(const lv_point_t * points, const lv_area_t * mask, const lv_style_t * style, lv_opa_t opa)
 {
     /*Return if the points are out of the mask*/
@@ -341,3 +385,4 @@ static void point_swap(lv_point_t * p1, lv_point_t * p2)
     p2->x = tmp.x;
     p2->y = tmp.y;
 }
+#endif
@@ -30,6 +30,7 @@ typedef struct
 {
 #if LV_USE_FILESYSTEM
     lv_fs_file_t * f;
+    const uint8_t * map; /*Content of the file if the driver can map it*/
 #endif
     lv_color_t * palette;
     lv_opa_t * opa;
@@ -349,6 +350,17 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
 
         memcpy(user_data->f, &f, sizeof(f));
 
+        /*If the driver can map the file its content can be used without reading*/
+        const void * map;
+        uint32_t map_size;
+        if(lv_fs_map(user_data->f, &map, &map_size) == LV_FS_RES_OK) {
+            if(map_size >= 4 + lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf)) {
+                user_data->map = map;
+            } else {
+                lv_fs_unmap(user_data->f, map);
+            }
+        }
+
 #else
         LV_LOG_WARN("Image built-in decoder cannot read file because LV_USE_FILESYSTEM = 0");
         return LV_RES_INV;
@@ -364,8 +376,13 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
             dsc->img_data = ((lv_img_dsc_t *)dsc->src)->data;
             return LV_RES_OK;
         } else {
-            /*If it's a file it need to be read line by line later*/
+#if LV_USE_FILESYSTEM
+            /*Point to the mapped file (skip the header) else it need to be read line by line later*/
+            lv_img_decoder_built_in_data_t * user_data = dsc->user_data;
+            dsc->img_data = user_data->map ? user_data->map + 4 : NULL;
+#else
             dsc->img_data = NULL;
+#endif
             return LV_RES_OK;
         }
     }
@@ -400,11 +417,12 @@ lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t * decoder, lv_img_decoder
         if(dsc->src_type == LV_IMG_SRC_FILE) {
             /*Read the palette from file*/
 #if LV_USE_FILESYSTEM
-            lv_fs_seek(user_data->f, 4); /*Skip the header*/
+            if(user_data->map == NULL) lv_fs_seek(user_data->f, 4); /*Skip the header*/
             lv_color32_t cur_color;
             uint32_t i;
             for(i = 0; i < palette_size; i++) {
-                lv_fs_read(user_data->f, &cur_color, sizeof(lv_color32_t), NULL);
+                if(user_data->map) cur_color = ((const lv_color32_t *)(user_data->map + 4))[i];
+                else lv_fs_read(user_data->f, &cur_color, sizeof(lv_color32_t), NULL);
                 user_data->palette[i] = lv_color_make(cur_color.ch.red, cur_color.ch.green, cur_color.ch.blue);
                 user_data->opa[i]     = cur_color.ch.alpha;
             }
@@ -504,6 +522,7 @@ void lv_img_decoder_built_in_close(lv_img_decoder_t * decoder, lv_img_decoder_ds
     if(user_data) {
 #if LV_USE_FILESYSTEM
         if(user_data->f) {
+            if(user_data->map) lv_fs_unmap(user_data->f, user_data->map);
             lv_fs_close(user_data->f);
             lv_mem_free(user_data->f);
         }
@@ -627,9 +646,13 @@ static lv_res_t lv_img_decoder_built_in_line_alpha(lv_img_decoder_dsc_t * dsc, l
         data_tmp = img_dsc->data + ofs;
     } else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+        if(user_data->map) {
+            data_tmp = user_data->map + ofs + 4; /*+4 to skip the header*/
+        } else {
+            lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
+            lv_fs_read(user_data->f, fs_buf, w, NULL);
+            data_tmp = fs_buf;
+        }
 #else
         LV_LOG_WARN("Image built-in alpha line reader can't read file because LV_USE_FILESYSTEM = 0");
         data_tmp = NULL; /*To avoid warnings*/
@@ -712,9 +735,13 @@ static lv_res_t lv_img_decoder_built_in_line_indexed(lv_img_decoder_dsc_t * dsc,
         data_tmp                     = img_dsc->data + ofs;
     } else {
 #if LV_USE_FILESYSTEM
-        lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
-        lv_fs_read(user_data->f, fs_buf, w, NULL);
-        data_tmp = fs_buf;
+        if(user_data->map) {
+            data_tmp = user_data->map + ofs + 4; /*+4 to skip the header*/
+        } else {
+            lv_fs_seek(user_data->f, ofs + 4); /*+4 to skip the header*/
+            lv_fs_read(user_data->f, fs_buf, w, NULL);
+            data_tmp = fs_buf;
+        }
 #else
         LV_LOG_WARN("Image built-in indexed line reader can't read file because LV_USE_FILESYSTEM = 0");
         data_tmp = NULL; /*To avoid warnings*/
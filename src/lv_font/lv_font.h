@@ -148,6 +148,14 @@ LV_FONT_DECLARE(lv_font_roboto_22)
 LV_FONT_DECLARE(lv_font_roboto_28)
 #endif
 
+#if LV_FONT_ROBOTO_12_SUBPX
+LV_FONT_DECLARE(lv_font_roboto_12_subpx)
+#endif
+
+#if LV_FONT_ROBOTO_28_COMPRESSED
+LV_FONT_DECLARE(lv_font_roboto_28_compressed)
+#endif
+
 #if LV_FONT_UNSCII_8
 LV_FONT_DECLARE(lv_font_unscii_8)
 #endif
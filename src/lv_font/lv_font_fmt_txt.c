@@ -49,12 +49,12 @@ static uint8_t rle_next(void);
  *  STATIC VARIABLES
  **********************/
 
-static uint32_t rle_rdp;
-static const uint8_t * rle_in;
-static uint8_t rle_bpp;
-static uint8_t rle_prev_v;
-static uint8_t rle_cnt;
-static rle_state_t rle_state;
+static LV_REFR_LOCAL uint32_t rle_rdp;
+static LV_REFR_LOCAL const uint8_t * rle_in;
+static LV_REFR_LOCAL uint8_t rle_bpp;
+static LV_REFR_LOCAL uint8_t rle_prev_v;
+static LV_REFR_LOCAL uint8_t rle_cnt;
+static LV_REFR_LOCAL rle_state_t rle_state;
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -88,7 +88,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     /*Handle compressed bitmap*/
     else
     {
-        static uint8_t * buf = NULL;
+        static LV_REFR_LOCAL uint8_t * buf = NULL;
 
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
         if(gsize == 0) return NULL;
@@ -82,6 +82,14 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
 #endif
 
     driver->set_px_cb = NULL;
+
+#if LV_USE_FLUSH_BATCH
+    driver->flush_batch_cb = NULL;
+#endif
+
+#if LV_USE_SCROLL_BLIT
+    driver->copy_area_cb = NULL;
+#endif
 }
 
 /**
@@ -136,6 +144,15 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
                                         new display*/
 
     disp->inv_p = 0;
+#if LV_USE_SCROLL_BLIT
+    disp->scroll_p = 0;
+#endif
+#if LV_USE_FRAME_SYNC
+    disp->vsync_time    = 0;
+    disp->vsync_period  = 0;
+    disp->render_time   = 0;
+    disp->vsync_pending = 0;
+#endif
 
     disp->act_scr   = lv_obj_create(NULL, NULL); /*Create a default screen on the display*/
     disp->top_layer = lv_obj_create(NULL, NULL); /*Create top layer on the display*/
@@ -279,6 +296,27 @@ LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
     disp_drv->buffer->flushing = 0;
 }
 
+#if LV_USE_FRAME_SYNC
+/**
+ * Call on the vertical sync of the display (e.g. from an interrupt).
+ * If `vsync` is set in the driver the display is refreshed only after this call.
+ * The time of the vertical syncs is used to predict when the next frame will be visible.
+ * @param disp pointer to a display
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_vsync(lv_disp_t * disp)
+{
+    uint32_t t = lv_tick_get();
+
+    if(disp->vsync_time != 0) {
+        uint32_t period    = t - disp->vsync_time;
+        disp->vsync_period = period > UINT16_MAX ? 0 : period; /*Ignore if the syncs were stopped*/
+    }
+
+    disp->vsync_time    = t;
+    disp->vsync_pending = 1;
+}
+#endif
+
 /**
  * Get the next display.
  * @param disp pointer to the current display. NULL to initialize.
@@ -30,6 +30,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas */
 #endif
 
+#ifndef LV_FLUSH_BATCH_MAX
+#define LV_FLUSH_BATCH_MAX LV_INV_BUF_SIZE /*Max. number of areas flushed together*/
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -56,6 +60,17 @@ typedef struct
     volatile uint32_t flushing : 1;
 } lv_disp_buf_t;
 
+#if LV_USE_FLUSH_BATCH
+/**
+ * A rendered area passed to `flush_batch_cb`
+ */
+typedef struct
+{
+    lv_area_t area;       /**< Coordinates of the area on the display*/
+    lv_color_t * color_p; /**< The pixels of the area (`lv_area_get_size(&area)` pixels) in the display buffer*/
+} lv_disp_flush_rect_t;
+#endif
+
 /**
  * Display Driver structure to be registered by HAL
  */
@@ -74,6 +89,12 @@ typedef struct _disp_drv_t
 #endif
     uint32_t rotated : 1; /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you!*/
 
+#if LV_USE_FRAME_SYNC
+    /**1: refresh only after the display signaled the vertical sync with `lv_disp_vsync()`.
+     * The period of the refresh task should be shorter than the frame time to start rendering soon.*/
+    uint32_t vsync : 1;
+#endif
+
 #if LV_COLOR_SCREEN_TRANSP
     /**Handle if the the screen doesn't have a solid (opa == LV_OPA_COVER) background.
      * Use only if required because it's slower.*/
@@ -98,6 +119,22 @@ typedef struct _disp_drv_t
      * number of flushed pixels */
     void (*monitor_cb)(struct _disp_drv_t * disp_drv, uint32_t time, uint32_t px);
 
+#if LV_USE_FLUSH_BATCH
+    /** OPTIONAL: Write several areas to the display at once. Used instead of `flush_cb` if set.
+     * The areas are rendered next to each other into the display buffer until it's full.
+     * 'lv_disp_flush_ready()' has to be called when all the areas are written.
+     * Not used with true double buffering. */
+    void (*flush_batch_cb)(struct _disp_drv_t * disp_drv, const lv_disp_flush_rect_t * rects, uint16_t rect_cnt);
+#endif
+
+#if LV_USE_SCROLL_BLIT
+    /** OPTIONAL: Move an area of the pixels already sent to the display by `x_ofs` and `y_ofs`
+     * (e.g. with the display controller or DMA). It has to be ready when the function returns.
+     * Used to scroll without redrawing. Not required with true double buffering. */
+    void (*copy_area_cb)(struct _disp_drv_t * disp_drv, const lv_area_t * area, lv_coord_t x_ofs,
+                         lv_coord_t y_ofs);
+#endif
+
 #if LV_USE_GPU
     /** OPTIONAL: Blend two memories using opacity (GPU only)*/
     void (*gpu_blend_cb)(struct _disp_drv_t * disp_drv, lv_color_t * dest, const lv_color_t * src, uint32_t length,
@@ -143,6 +180,21 @@ typedef struct _disp_t
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint32_t inv_p : 10;
 
+#if LV_USE_SCROLL_BLIT
+    /** The rendered content of `scroll_area` is moved by `scroll_x` and `scroll_y` in the next refresh*/
+    lv_area_t scroll_area;
+    lv_coord_t scroll_x;
+    lv_coord_t scroll_y;
+    uint32_t scroll_p : 1;
+#endif
+
+#if LV_USE_FRAME_SYNC
+    volatile uint32_t vsync_time;   /**< Time of the last vertical sync*/
+    volatile uint16_t vsync_period; /**< Measured time between the last two vertical syncs [ms]*/
+    uint16_t render_time;           /**< Time of the last refresh to estimate the time of the next [ms]*/
+    volatile uint8_t vsync_pending; /**< Set by `lv_disp_vsync()`, cleared when the refresh starts*/
+#endif
+
     /*Miscellaneous data*/
     uint32_t last_activity_time; /**< Last time there was activity on this display */
 } lv_disp_t;
@@ -238,6 +290,16 @@ bool lv_disp_get_antialiasing(lv_disp_t * disp);
  */
 LV_ATTRIBUTE_FLUSH_READY void lv_disp_flush_ready(lv_disp_drv_t * disp_drv);
 
+#if LV_USE_FRAME_SYNC
+/**
+ * Call on the vertical sync of the display (e.g. from an interrupt).
+ * If `vsync` is set in the driver the display is refreshed only after this call.
+ * The time of the vertical syncs is used to predict when the next frame will be visible.
+ * @param disp pointer to a display
+ */
+LV_ATTRIBUTE_FLUSH_READY void lv_disp_vsync(lv_disp_t * disp);
+#endif
+
 //! @endcond
 
 /**
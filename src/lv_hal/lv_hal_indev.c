@@ -14,6 +14,7 @@
 #include "../lv_misc/lv_mem.h"
 #include "../lv_misc/lv_gc.h"
 #include "lv_hal_disp.h"
+#include "lv_hal_tick.h"
 
 #if defined(LV_GC_INCLUDE)
 #include LV_GC_INCLUDE
@@ -22,6 +23,17 @@
 /*********************
  *      DEFINES
  *********************/
+#if LV_INDEV_QUEUE_SIZE > 0
+#if !defined(__GNUC__)
+#error "LV_INDEV_QUEUE_SIZE requires GCC compatible atomic builtins"
+#endif
+
+#if (LV_INDEV_QUEUE_SIZE & (LV_INDEV_QUEUE_SIZE - 1)) != 0
+#error "LV_INDEV_QUEUE_SIZE should be a power of 2"
+#endif
+
+#define QUEUE_MASK (LV_INDEV_QUEUE_SIZE - 1)
+#endif
 
 /**********************
  *      TYPEDEFS
@@ -30,6 +42,9 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+#if LV_INDEV_QUEUE_SIZE > 0
+static bool indev_queue_read(lv_indev_t * indev, lv_indev_data_t * data);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -122,7 +137,8 @@ lv_indev_t * lv_indev_get_next(lv_indev_t * indev)
 /**
  * Read data from an input device.
  * @param indev pointer to an input device
- * @param data input device will write its data here
+ * @param data input device will write its data here.
+ *             `timestamp` is 0 if the input device has no `read_cb` and no sample was pushed.
  * @return false: no more data; true: there more data to read (buffered)
  */
 bool lv_indev_read(lv_indev_t * indev, lv_indev_data_t * data)
@@ -146,13 +162,96 @@ bool lv_indev_read(lv_indev_t * indev, lv_indev_data_t * data)
         LV_LOG_TRACE("idnev read started");
         cont = indev->driver.read_cb(&indev->driver, data);
         LV_LOG_TRACE("idnev read finished");
-    } else {
+#if LV_INDEV_QUEUE_SIZE > 0
+        if(data->timestamp == 0) data->timestamp = lv_tick_get();
+#endif
+    }
+#if LV_INDEV_QUEUE_SIZE > 0
+    else {
+        /*Keep the last state if no new samples were pushed. Such reads have no time stamp.*/
+        data->state = indev->proc.state;
+        cont        = indev_queue_read(indev, data);
+    }
+#else
+    else {
         LV_LOG_WARN("indev function registered");
     }
+#endif
 
     return cont;
 }
 
+#if LV_INDEV_QUEUE_SIZE > 0
+/**
+ * Add a sample to the queue of an input device. It can be called from an interrupt or an other thread
+ * but only from one place per input device. The samples are processed by the read task of the input
+ * device in one batch. Set `read_cb` to NULL to use only the queue.
+ * @param indev pointer to an input device
+ * @param data the sample to add. If `data->timestamp` is 0 the current time is used.
+ * @return true: the sample is added; false: the queue is full
+ */
+bool lv_indev_push(lv_indev_t * indev, const lv_indev_data_t * data)
+{
+    /*Only this function writes `queue_wr` so it can be read simply*/
+    uint32_t wr = indev->queue_wr;
+    uint32_t rd = __atomic_load_n(&indev->queue_rd, __ATOMIC_ACQUIRE);
+    if(wr - rd >= LV_INDEV_QUEUE_SIZE) return false;
+
+    lv_indev_data_t * sample = &indev->queue[wr & QUEUE_MASK];
+    memcpy(sample, data, sizeof(lv_indev_data_t));
+    if(sample->timestamp == 0) sample->timestamp = lv_tick_get();
+
+    /*Make the sample visible for the read task only after it's written*/
+    __atomic_store_n(&indev->queue_wr, wr + 1, __ATOMIC_RELEASE);
+
+    return true;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
+
+#if LV_INDEV_QUEUE_SIZE > 0
+/**
+ * Read the next sample from the queue of an input device.
+ * The samples which needn't be processed one by one are merged into one.
+ * @param indev pointer to an input device
+ * @param data store the sample here. Not changed if the queue is empty.
+ * @return true: there are more samples in the queue
+ */
+static bool indev_queue_read(lv_indev_t * indev, lv_indev_data_t * data)
+{
+    uint32_t rd = indev->queue_rd;
+    uint32_t wr = __atomic_load_n(&indev->queue_wr, __ATOMIC_ACQUIRE);
+    if(rd == wr) return false;
+
+    memcpy(data, &indev->queue[rd & QUEUE_MASK], sizeof(lv_indev_data_t));
+    rd++;
+
+    while(rd != wr) {
+        const lv_indev_data_t * next = &indev->queue[rd & QUEUE_MASK];
+        if(next->state != data->state) break;
+
+        if(indev->driver.type == LV_INDEV_TYPE_POINTER) {
+            /*While dragging only the last point matters: the distance is the same
+             *and the speed of the drag throw is calculated from the time stamps.
+             *From the released samples only the last point is used too.*/
+            if(data->state == LV_INDEV_STATE_PR && indev->proc.types.pointer.drag_in_prog == 0) break;
+            memcpy(data, next, sizeof(lv_indev_data_t));
+        } else if(indev->driver.type == LV_INDEV_TYPE_ENCODER) {
+            /*Sum the steps of the samples with the same button state*/
+            data->enc_diff += next->enc_diff;
+            data->timestamp = next->timestamp;
+        } else {
+            break;
+        }
+
+        rd++;
+    }
+
+    __atomic_store_n(&indev->queue_rd, rd, __ATOMIC_RELEASE);
+
+    return rd != wr;
+}
+#endif
@@ -63,6 +63,10 @@ typedef struct
     int16_t enc_diff; /**< For LV_INDEV_TYPE_ENCODER number of steps since the previous read*/
 
     lv_indev_state_t state; /**< LV_INDEV_STATE_REL or LV_INDEV_STATE_PR*/
+
+#if LV_INDEV_QUEUE_SIZE > 0
+    uint32_t timestamp; /**< Time of the sample in `lv_tick_get()` time. 0: the time of reading/pushing*/
+#endif
 } lv_indev_data_t;
 
 /** Initialized by the user and registered by 'lv_indev_add()'*/
@@ -74,7 +78,8 @@ typedef struct _lv_indev_drv_t
 
     /**< Function pointer to read input device data.
      * Return 'true' if there is more data to be read (buffered).
-     * Most drivers can safely return 'false' */
+     * Most drivers can safely return 'false'.
+     * Can be NULL if the driver pushes the samples with `lv_indev_push()` (see `LV_INDEV_QUEUE_SIZE`) */
     bool (*read_cb)(struct _lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
 
     /** Called when an action happened on the input device.
@@ -124,6 +129,10 @@ typedef struct _lv_indev_proc_t
                                                 other post-release event)*/
             struct _lv_obj_t * last_pressed; /*The lastly pressed object*/
 
+#if LV_INDEV_QUEUE_SIZE > 0
+            uint32_t last_timestamp; /*Time of `last_point` to calculate the speed of drag throw*/
+#endif
+
             /*Flags*/
             uint8_t drag_limit_out : 1;
             uint8_t drag_in_prog : 1;
@@ -158,6 +167,11 @@ typedef struct _lv_indev_t
     struct _lv_group_t * group;    /**< Keypad destination group*/
     const lv_point_t * btn_points; /**< Array points assigned to the button ()screen will be pressed
                                       here by the buttons*/
+#if LV_INDEV_QUEUE_SIZE > 0
+    lv_indev_data_t queue[LV_INDEV_QUEUE_SIZE]; /**< Samples pushed by `lv_indev_push()`*/
+    uint32_t queue_wr;                          /**< Position of the next sample to push. Written only by the driver.*/
+    uint32_t queue_rd;                          /**< Position of the next sample to read. Written only by the library.*/
+#endif
 } lv_indev_t;
 
 /**********************
@@ -197,11 +211,24 @@ lv_indev_t * lv_indev_get_next(lv_indev_t * indev);
 /**
  * Read data from an input device.
  * @param indev pointer to an input device
- * @param data input device will write its data here
+ * @param data input device will write its data here.
+ *             `timestamp` is 0 if the input device has no `read_cb` and no sample was pushed.
  * @return false: no more data; true: there more data to read (buffered)
  */
 bool lv_indev_read(lv_indev_t * indev, lv_indev_data_t * data);
 
+#if LV_INDEV_QUEUE_SIZE > 0
+/**
+ * Add a sample to the queue of an input device. It can be called from an interrupt or an other thread
+ * but only from one place per input device. The samples are processed by the read task of the input
+ * device in one batch. Set `read_cb` to NULL to use only the queue.
+ * @param indev pointer to an input device
+ * @param data the sample to add. If `data->timestamp` is 0 the current time is used.
+ * @return true: the sample is added; false: the queue is full
+ */
+bool lv_indev_push(lv_indev_t * indev, const lv_indev_data_t * data);
+#endif
+
 /**********************
  *      MACROS
  **********************/
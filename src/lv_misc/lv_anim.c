@@ -27,25 +27,67 @@
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
 
+#define ANIM_POOL_MIN 8        /*Initial number of animations in the pool*/
+#define ANIM_POOL_MAX 0x4000   /*The hash table has 2 x pool size `uint16_t` slots*/
+#define ANIM_HASH_EMPTY 0xFFFF /*Unused slot in the hash table*/
+#define ANIM_BATCH_MAX 4       /*Max number of `lv_anim_add_batch()` pairs*/
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*Two animator functions which can be applied at once by a third one*/
+typedef struct
+{
+    lv_anim_exec_xcb_t exec1_cb;
+    lv_anim_exec_xcb_t exec2_cb;
+    lv_anim_exec2_xcb_t exec_both_cb;
+} lv_anim_batch_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static void anim_task(lv_task_t * param);
-static bool anim_ready_handler(lv_anim_t * a);
+#if LV_USE_FRAME_SYNC
+static void anim_step_to(uint32_t time);
+#endif
+static void anim_step(uint32_t elaps);
+static void anim_exec(uint16_t idx);
+static void anim_ready_handler(uint16_t idx);
+static bool anim_reserve(void);
+static void anim_remove(uint16_t idx);
+static void anim_compact(void);
+static int32_t anim_find(const void * var, lv_anim_exec_xcb_t exec_cb);
+static uint32_t anim_hash(const void * var);
+static void anim_hash_insert(uint16_t idx);
+static void anim_hash_remove(uint16_t idx);
+static void anim_hash_rebuild(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-static uint32_t last_task_run;
-static bool anim_list_changed;
+static uint32_t last_task_run; /*The time until the animations are stepped*/
+#if LV_USE_FRAME_SYNC
+static uint32_t last_refr_step; /*When a display stepped the animations last time*/
+#endif
+static uint16_t anim_cnt;      /*Number of used slots in the pool (the deleted animations too)*/
+static uint16_t anim_dead_cnt; /*Number of deleted animations in the pool*/
+static uint16_t anim_cap;      /*Number of slots in the pool*/
+static bool anim_task_running; /*The pool can't be compacted while the animations are stepped*/
+static lv_anim_batch_t anim_batch[ANIM_BATCH_MAX];
+static uint8_t anim_batch_cnt;
 
 /**********************
  *      MACROS
  **********************/
+/*The animations are stored in arrays:
+ * - `_lv_anim_pool`: the descriptors of the animations
+ * - `_lv_anim_values`: the values calculated in the current round for each animation
+ * - `_lv_anim_hash`: open addressing hash table of the pool indexes, hashed by `var`*/
+#define ANIM_POOL ((lv_anim_t *)LV_GC_ROOT(_lv_anim_pool))
+#define ANIM_VALUES ((lv_anim_value_t *)LV_GC_ROOT(_lv_anim_values))
+#define ANIM_HASH ((uint16_t *)LV_GC_ROOT(_lv_anim_hash))
+#define ANIM_HASH_MASK ((uint32_t)anim_cap * 2 - 1)
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -56,8 +98,18 @@ static bool anim_list_changed;
  */
 void lv_anim_core_init(void)
 {
-    lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    LV_GC_ROOT(_lv_anim_pool)   = NULL;
+    LV_GC_ROOT(_lv_anim_values) = NULL;
+    LV_GC_ROOT(_lv_anim_hash)   = NULL;
+    anim_cnt                    = 0;
+    anim_dead_cnt               = 0;
+    anim_cap                    = 0;
+    anim_batch_cnt              = 0;
+
     last_task_run = lv_tick_get();
+#if LV_USE_FRAME_SYNC
+    last_refr_step = last_task_run;
+#endif
     lv_task_create(anim_task, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, NULL);
 }
 
@@ -88,22 +140,25 @@ void lv_anim_create(lv_anim_t * a)
     /* Do not let two animations for the  same 'var' with the same 'fp'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*fp == NULL would delete all animations of var*/
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
-    LV_ASSERT_MEM(new_anim);
-    if(new_anim == NULL) return;
+    /*Add the new animation to the end of the pool*/
+    if(anim_reserve() == false) return;
+
+    uint16_t idx         = anim_cnt;
+    lv_anim_t * new_anim = &ANIM_POOL[idx];
+    anim_cnt++;
 
     /*Initialize the animation descriptor*/
     a->playback_now = 0;
     memcpy(new_anim, a, sizeof(lv_anim_t));
+    new_anim->has_run = 0;
+    new_anim->deleted = 0;
+    new_anim->paused  = new_anim->timeline != 0 ? 1 : 0; /*Wait for `lv_anim_timeline_start()`*/
+
+    anim_hash_insert(idx);
 
     /*Set the start value*/
     if(new_anim->exec_cb) new_anim->exec_cb(new_anim->var, new_anim->start);
 
-    /* Creating an animation changed the linked list.
-     * It's important if it happens in a ready callback. (see `anim_task`)*/
-    anim_list_changed = true;
-
     LV_LOG_TRACE("animation created")
 }
 
@@ -116,39 +171,107 @@ void lv_anim_create(lv_anim_t * a)
  */
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
     bool del = false;
-    a        = lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-    while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
-
-        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            lv_ll_rem(&LV_GC_ROOT(_lv_anim_ll), a);
-            lv_mem_free(a);
-            anim_list_changed = true; /*Read by `anim_task`. It need to know if a delete occurred in
-                                         the linked list*/
+    int32_t idx;
+    while((idx = anim_find(var, exec_cb)) >= 0) {
+        anim_remove(idx);
+        del = true;
+    }
+
+    return del;
+}
+
+/**
+ * Start or resume the animations of a timeline together.
+ * The delays of the animations are counted from this moment.
+ * @param timeline ID of the timeline (see `lv_anim_set_timeline()`)
+ */
+void lv_anim_timeline_start(uint16_t timeline)
+{
+    if(timeline == 0) return;
+
+    uint16_t i;
+    for(i = 0; i < anim_cnt; i++) {
+        if(ANIM_POOL[i].timeline == timeline) ANIM_POOL[i].paused = 0;
+    }
+}
+
+/**
+ * Pause the animations of a timeline. `lv_anim_timeline_start()` resumes them.
+ * @param timeline ID of the timeline (see `lv_anim_set_timeline()`)
+ */
+void lv_anim_timeline_pause(uint16_t timeline)
+{
+    if(timeline == 0) return;
+
+    uint16_t i;
+    for(i = 0; i < anim_cnt; i++) {
+        if(ANIM_POOL[i].timeline == timeline) ANIM_POOL[i].paused = 1;
+    }
+}
+
+/**
+ * Delete all animations of a timeline
+ * @param timeline ID of the timeline (see `lv_anim_set_timeline()`)
+ * @return true: at least 1 animation is deleted, false: no animation is deleted
+ */
+bool lv_anim_timeline_del(uint16_t timeline)
+{
+    if(timeline == 0) return false;
+
+    bool del = false;
+    uint16_t i;
+    for(i = 0; i < anim_cnt; i++) {
+        if(ANIM_POOL[i].deleted == 0 && ANIM_POOL[i].timeline == timeline) {
+            anim_remove(i);
             del = true;
         }
-
-        a = a_next;
     }
 
     return del;
 }
 
+/**
+ * Register two animator functions which can be applied at once with a third function.
+ * If both animations of a variable run in the same round only `exec_both_cb` is called.
+ * E.g. `lv_obj_set_x` and `lv_obj_set_y` with `lv_obj_set_pos` to invalidate the object only once.
+ * @param exec1_cb an animator function
+ * @param exec2_cb an other animator function
+ * @param exec_both_cb a function which sets the values of `exec1_cb` and `exec2_cb` (in this order)
+ */
+void lv_anim_add_batch(lv_anim_exec_xcb_t exec1_cb, lv_anim_exec_xcb_t exec2_cb, lv_anim_exec2_xcb_t exec_both_cb)
+{
+    if(anim_batch_cnt >= ANIM_BATCH_MAX) {
+        LV_LOG_WARN("lv_anim_add_batch: too many batches");
+        return;
+    }
+
+    anim_batch[anim_batch_cnt].exec1_cb     = exec1_cb;
+    anim_batch[anim_batch_cnt].exec2_cb     = exec2_cb;
+    anim_batch[anim_batch_cnt].exec_both_cb = exec_both_cb;
+    anim_batch_cnt++;
+}
+
+#if LV_USE_FRAME_SYNC
+/**
+ * Step the animations to a given time. Called by the display refresh right before rendering.
+ * @param time the time when the rendered frame will be visible (in `lv_tick_get()` time).
+ *             Nothing happens if the animations are already stepped to this time (e.g. for an other display).
+ */
+void lv_anim_refr_now(uint32_t time)
+{
+    last_refr_step = lv_tick_get();
+    anim_step_to(time);
+}
+#endif
+
 /**
  * Get the number of currently running animations
  * @return the number of running animations
  */
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt++;
+    return anim_cnt - anim_dead_cnt;
 }
 
 /**
@@ -379,74 +502,124 @@ static void anim_task(lv_task_t * param)
 {
     (void)param;
 
-    lv_anim_t * a;
-    LV_LL_READ(LV_GC_ROOT(_lv_anim_ll), a)
-    {
-        a->has_run = 0;
-    }
+#if LV_USE_FRAME_SYNC
+    /*Normally the displays step the animations before rendering. Step them here only if no display
+     *did it recently (e.g. there is no display or it's waiting for a vertical sync) to not to stall them*/
+    if(lv_tick_elaps(last_refr_step) <= LV_DISP_DEF_REFR_PERIOD) return;
 
-    uint32_t elaps = lv_tick_elaps(last_task_run);
+    anim_step_to(lv_tick_get());
+#else
+    anim_step(lv_tick_elaps(last_task_run));
 
-    a = lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
+    last_task_run = lv_tick_get();
+#endif
+}
 
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
+#if LV_USE_FRAME_SYNC
+/**
+ * Step the animations to a given time if they are not there yet
+ * @param time the new time of the animations (in `lv_tick_get()` time)
+ */
+static void anim_step_to(uint32_t time)
+{
+    int32_t elaps = (int32_t)(time - last_task_run);
+    if(elaps <= 0) return;
 
-        if(!a->has_run) {
-            a->has_run = 1; /*The list readying might be reseted so need to know which anim has run already*/
-            a->act_time += elaps;
-            if(a->act_time >= 0) {
-                if(a->act_time > a->time) a->act_time = a->time;
+    last_task_run = time;
+    anim_step(elaps);
+}
+#endif
 
-                int32_t new_value;
-                new_value = a->path_cb(a);
+/**
+ * Step all animations
+ * @param elaps the elapsed time since the last step [ms]
+ */
+static void anim_step(uint32_t elaps)
+{
+    anim_task_running = true;
+
+    /* The callbacks can create and delete animations and the pool can be reallocated meanwhile.
+     * So always use indexes. The deleted animations remain in the pool until the end of the step
+     * and the created ones are added after `cnt`, so they start in the next round.
+     * The newest animations are handled first.*/
+    uint16_t cnt = anim_cnt;
+    uint16_t i;
+
+    /*Calculate the new values first*/
+    for(i = cnt; i-- > 0;) {
+        lv_anim_t * a = &ANIM_POOL[i];
+        a->has_run    = 0;
+        if(a->deleted || a->paused) continue;
+
+        a->act_time += elaps;
+        if(a->act_time < 0) continue;
+        if(a->act_time > a->time) a->act_time = a->time;
+
+        ANIM_VALUES[i] = a->path_cb(a);
+        a->has_run     = 1;
+    }
+
+    /*Apply the calculated values*/
+    for(i = cnt; i-- > 0;) {
+        if(ANIM_POOL[i].deleted == 0 && ANIM_POOL[i].has_run) anim_exec(i);
+    }
+
+    /*If the time is elapsed the animation is ready*/
+    for(i = cnt; i-- > 0;) {
+        lv_anim_t * a = &ANIM_POOL[i];
+        if(a->deleted == 0 && a->has_run && a->act_time >= a->time) anim_ready_handler(i);
+    }
 
-                /*Apply the calculated value*/
-                if(a->exec_cb) a->exec_cb(a->var, new_value);
+    anim_task_running = false;
+    if(anim_dead_cnt > 0) anim_compact();
+}
 
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
-                    anim_ready_handler(a);
-                }
+/**
+ * Apply the calculated value of an animation.
+ * If a batch pair of it has run too they are applied together.
+ * @param idx index of the animation in the pool
+ */
+static void anim_exec(uint16_t idx)
+{
+    lv_anim_t * a = &ANIM_POOL[idx];
+    if(a->exec_cb == NULL) return;
+
+    uint8_t b;
+    for(b = 0; b < anim_batch_cnt; b++) {
+        if(a->exec_cb == anim_batch[b].exec1_cb) {
+            int32_t pair = anim_find(a->var, anim_batch[b].exec2_cb);
+            if(pair >= 0 && ANIM_POOL[pair].has_run) {
+                anim_batch[b].exec_both_cb(a->var, ANIM_VALUES[idx], ANIM_VALUES[pair]);
+                return;
             }
+        } else if(a->exec_cb == anim_batch[b].exec2_cb) {
+            int32_t pair = anim_find(a->var, anim_batch[b].exec1_cb);
+            if(pair >= 0 && ANIM_POOL[pair].has_run) return; /*Applied with the pair*/
         }
-
-        /* If the linked list changed due to anim. delete then it's not safe to continue
-         * the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
     }
 
-    last_task_run = lv_tick_get();
+    a->exec_cb(a->var, ANIM_VALUES[idx]);
 }
 
 /**
  * Called when an animation is ready to do the necessary thinks
  * e.g. repeat, play back, delete etc.
- * @param a pointer to an animation descriptor
- * @return true: animation delete occurred nnd the `LV_GC_ROOT(_lv_anim_ll)` has changed
+ * @param idx index of the animation in the pool
  * */
-static bool anim_ready_handler(lv_anim_t * a)
+static void anim_ready_handler(uint16_t idx)
 {
+    lv_anim_t * a = &ANIM_POOL[idx];
 
     /*Delete the animation if
      * - no repeat and no play back (simple one shot animation)
      * - no repeat, play back is enabled and play back is ready */
     if((a->repeat == 0 && a->playback == 0) || (a->repeat == 0 && a->playback == 1 && a->playback_now == 1)) {
 
-        /*Create copy from the animation and delete the animation from the list.
+        /*Create copy from the animation and delete the animation from the pool.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
         lv_anim_t a_tmp;
         memcpy(&a_tmp, a, sizeof(lv_anim_t));
-        lv_ll_rem(&LV_GC_ROOT(_lv_anim_ll), a);
-        lv_mem_free(a);
-        anim_list_changed = true;
+        anim_remove(idx);
 
         /* Call the callback function at the end*/
         if(a_tmp.ready_cb != NULL) a_tmp.ready_cb(&a_tmp);
@@ -468,7 +641,173 @@ static bool anim_ready_handler(lv_anim_t * a)
             a->end   = tmp;
         }
     }
+}
+
+/**
+ * Be sure there is a free slot at the end of the pool
+ * @return true: there is a free slot; false: out of memory
+ */
+static bool anim_reserve(void)
+{
+    if(anim_cnt < anim_cap) return true;
+
+    /*Reuse the slots of the deleted animations if possible*/
+    if(anim_dead_cnt > 0 && anim_task_running == false) {
+        anim_compact();
+        return true;
+    }
+
+    if(anim_cap >= ANIM_POOL_MAX) {
+        LV_LOG_WARN("lv_anim_create: too many animations");
+        return false;
+    }
+
+    uint16_t new_cap = anim_cap == 0 ? ANIM_POOL_MIN : anim_cap * 2;
+
+    lv_anim_t * pool = lv_mem_realloc(ANIM_POOL, new_cap * sizeof(lv_anim_t));
+    LV_ASSERT_MEM(pool);
+    if(pool == NULL) return false;
+    LV_GC_ROOT(_lv_anim_pool) = pool;
+
+    lv_anim_value_t * values = lv_mem_realloc(ANIM_VALUES, new_cap * sizeof(lv_anim_value_t));
+    LV_ASSERT_MEM(values);
+    if(values == NULL) return false;
+    LV_GC_ROOT(_lv_anim_values) = values;
+
+    uint16_t * hash = lv_mem_realloc(ANIM_HASH, new_cap * 2 * sizeof(uint16_t));
+    LV_ASSERT_MEM(hash);
+    if(hash == NULL) return false;
+    LV_GC_ROOT(_lv_anim_hash) = hash;
+
+    anim_cap = new_cap;
+    anim_hash_rebuild();
+
+    return true;
+}
+
+/**
+ * Delete an animation. Its slot is freed later by `anim_compact()`.
+ * @param idx index of the animation in the pool
+ */
+static void anim_remove(uint16_t idx)
+{
+    anim_hash_remove(idx);
+    ANIM_POOL[idx].deleted = 1;
+    ANIM_POOL[idx].has_run = 0;
+    anim_dead_cnt++;
+}
+
+/**
+ * Remove the deleted animations from the pool keeping the order of the others
+ */
+static void anim_compact(void)
+{
+    uint16_t i;
+    uint16_t j = 0;
+    for(i = 0; i < anim_cnt; i++) {
+        if(ANIM_POOL[i].deleted) continue;
+
+        if(i != j) memcpy(&ANIM_POOL[j], &ANIM_POOL[i], sizeof(lv_anim_t));
+        j++;
+    }
+
+    anim_cnt      = j;
+    anim_dead_cnt = 0;
+    anim_hash_rebuild();
+}
+
+/**
+ * Find an animation by its variable and animator function
+ * @param var pointer to the animated variable
+ * @param exec_cb the animator function or NULL to find any animation of `var`
+ * @return index of the animation in the pool or -1 if not found
+ */
+static int32_t anim_find(const void * var, lv_anim_exec_xcb_t exec_cb)
+{
+    if(anim_cap == 0) return -1;
+
+    uint32_t mask = ANIM_HASH_MASK;
+    uint32_t h    = anim_hash(var) & mask;
+    while(ANIM_HASH[h] != ANIM_HASH_EMPTY) {
+        const lv_anim_t * a = &ANIM_POOL[ANIM_HASH[h]];
+        if(a->var == var && (exec_cb == NULL || a->exec_cb == exec_cb)) return ANIM_HASH[h];
+
+        h = (h + 1) & mask;
+    }
+
+    return -1;
+}
+
+/**
+ * Get the hash of an animated variable. All animations of a variable are in the same probe sequence.
+ * @param var pointer to the animated variable
+ * @return the hash value
+ */
+static uint32_t anim_hash(const void * var)
+{
+    /*Drop the always 0 alignment bits and mix the others (Fibonacci hashing)*/
+    uint32_t h = (uint32_t)((uintptr_t)var >> 2);
+    h *= 2654435761u;
+
+    return h ^ (h >> 16);
+}
+
+/**
+ * Add an animation to the hash table
+ * @param idx index of the animation in the pool
+ */
+static void anim_hash_insert(uint16_t idx)
+{
+    uint32_t mask = ANIM_HASH_MASK;
+    uint32_t h    = anim_hash(ANIM_POOL[idx].var) & mask;
+    while(ANIM_HASH[h] != ANIM_HASH_EMPTY) {
+        h = (h + 1) & mask;
+    }
+
+    ANIM_HASH[h] = idx;
+}
+
+/**
+ * Remove an animation from the hash table
+ * @param idx index of the animation in the pool
+ */
+static void anim_hash_remove(uint16_t idx)
+{
+    uint32_t mask = ANIM_HASH_MASK;
+    uint32_t hole = anim_hash(ANIM_POOL[idx].var) & mask;
+    while(ANIM_HASH[hole] != idx) {
+        hole = (hole + 1) & mask;
+    }
+
+    /*Move back the next items of the probe sequence which wouldn't be found after the hole*/
+    uint32_t i = hole;
+    while(1) {
+        i = (i + 1) & mask;
+        if(ANIM_HASH[i] == ANIM_HASH_EMPTY) break;
+
+        /*The item can be moved only if the hole is between its home slot and its current slot*/
+        uint32_t home = anim_hash(ANIM_POOL[ANIM_HASH[i]].var) & mask;
+        if(((i - home) & mask) >= ((i - hole) & mask)) {
+            ANIM_HASH[hole] = ANIM_HASH[i];
+            hole            = i;
+        }
+    }
 
-    return anim_list_changed;
+    ANIM_HASH[hole] = ANIM_HASH_EMPTY;
+}
+
+/**
+ * Add all living animations to an empty hash table
+ */
+static void anim_hash_rebuild(void)
+{
+    if(anim_cap == 0) return;
+
+    memset(ANIM_HASH, 0xFF, (uint32_t)anim_cap * 2 * sizeof(uint16_t));
+
+    uint16_t i;
+    for(i = 0; i < anim_cnt; i++) {
+        if(ANIM_POOL[i].deleted == 0) anim_hash_insert(i);
+    }
 }
 #endif
@@ -58,6 +58,10 @@ typedef void (*lv_anim_exec_xcb_t)(void *, lv_anim_value_t);
  * It's more consistent but less convenient. Might be used by binding generator functions.*/
 typedef void (*lv_anim_custom_exec_cb_t)(struct _lv_anim_t *, lv_anim_value_t);
 
+/** Apply two animated values at once. E.g. `lv_obj_set_pos` for `lv_obj_set_x` and `lv_obj_set_y`
+ * (see `lv_anim_add_batch()`)*/
+typedef void (*lv_anim_exec2_xcb_t)(void *, lv_anim_value_t, lv_anim_value_t);
+
 /** Get the current value during an animation*/
 typedef lv_anim_value_t (*lv_anim_path_cb_t)(const struct _lv_anim_t *);
 
@@ -77,6 +81,7 @@ typedef struct _lv_anim_t
     int16_t act_time;            /**< Current time in animation. Set to negative to make delay.*/
     uint16_t playback_pause;     /**< Wait before play back*/
     uint16_t repeat_pause;       /**< Wait before repeat*/
+    uint16_t timeline;           /**< ID of the timeline to start the animation with. 0: start immediately*/
 #if LV_USE_USER_DATA
     lv_anim_user_data_t user_data; /**< Custom user data*/
 #endif
@@ -85,6 +90,8 @@ typedef struct _lv_anim_t
     uint8_t repeat : 1;   /**< Repeat the animation infinitely*/
     /*Animation system use these - user shouldn't set*/
     uint8_t playback_now : 1; /**< Play back is in progress*/
+    uint8_t paused : 1;       /**< Waits for `lv_anim_timeline_start()`*/
+    uint8_t deleted : 1;      /**< Deleted but still in the pool*/
     uint32_t has_run : 1;     /**< Indicates the animation has run in this round*/
 } lv_anim_t;
 
@@ -222,6 +229,17 @@ static inline void lv_anim_clear_repeat(lv_anim_t * a)
     a->repeat = 0;
 }
 
+/**
+ * Add the animation to a timeline. The animations of a timeline wait until `lv_anim_timeline_start()`
+ * and start together. Their delays are counted from the start of the timeline.
+ * @param a pointer to an initialized `lv_anim_t` variable
+ * @param timeline an ID chosen by the application. 0: not in a timeline (start immediately)
+ */
+static inline void lv_anim_set_timeline(lv_anim_t * a, uint16_t timeline)
+{
+    a->timeline = timeline;
+}
+
 /**
  * Create an animation
  * @param a an initialized 'anim_t' variable. Not required after call.
@@ -253,6 +271,45 @@ static inline bool lv_anim_custom_del(lv_anim_t * a, lv_anim_custom_exec_cb_t ex
     return lv_anim_del(a->var, (lv_anim_exec_xcb_t)exec_cb);
 }
 
+/**
+ * Start or resume the animations of a timeline together.
+ * The delays of the animations are counted from this moment.
+ * @param timeline ID of the timeline (see `lv_anim_set_timeline()`)
+ */
+void lv_anim_timeline_start(uint16_t timeline);
+
+/**
+ * Pause the animations of a timeline. `lv_anim_timeline_start()` resumes them.
+ * @param timeline ID of the timeline (see `lv_anim_set_timeline()`)
+ */
+void lv_anim_timeline_pause(uint16_t timeline);
+
+/**
+ * Delete all animations of a timeline
+ * @param timeline ID of the timeline (see `lv_anim_set_timeline()`)
+ * @return true: at least 1 animation is deleted, false: no animation is deleted
+ */
+bool lv_anim_timeline_del(uint16_t timeline);
+
+/**
+ * Register two animator functions which can be applied at once with a third function.
+ * If both animations of a variable run in the same round only `exec_both_cb` is called.
+ * E.g. `lv_obj_set_x` and `lv_obj_set_y` with `lv_obj_set_pos` to invalidate the object only once.
+ * @param exec1_cb an animator function
+ * @param exec2_cb an other animator function
+ * @param exec_both_cb a function which sets the values of `exec1_cb` and `exec2_cb` (in this order)
+ */
+void lv_anim_add_batch(lv_anim_exec_xcb_t exec1_cb, lv_anim_exec_xcb_t exec2_cb, lv_anim_exec2_xcb_t exec_both_cb);
+
+#if LV_USE_FRAME_SYNC
+/**
+ * Step the animations to a given time. Called by the display refresh right before rendering.
+ * @param time the time when the rendered frame will be visible (in `lv_tick_get()` time).
+ *             Nothing happens if the animations are already stepped to this time (e.g. for an other display).
+ */
+void lv_anim_refr_now(uint32_t time);
+#endif
+
 /**
  * Get the number of currently running animations
  * @return the number of running animations
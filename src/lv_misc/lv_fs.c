@@ -11,6 +11,7 @@
 
 #include "../lv_core/lv_debug.h"
 #include "lv_ll.h"
+#include "lv_math.h"
 #include <string.h>
 #include "lv_gc.h"
 
@@ -30,18 +31,76 @@
 #undef free
 #endif
 
+#if LV_USE_FS_CACHE
+#define CACHE_POS_UNKNOWN UINT32_MAX
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_USE_FS_CACHE
+/*State of the read caching of an opened file*/
+typedef struct _lv_fs_file_cache_t
+{
+    uint32_t pos;     /*Position of the reads*/
+    uint32_t drv_pos; /*Position of the driver*/
+    uint32_t ra_pos;  /*Position of the first byte in the read-ahead buffer*/
+    uint32_t ra_len;  /*Number of valid bytes in the read-ahead buffer*/
+    int16_t file_id;  /*Index in `cache_files` or -1 if the file doesn't use the shared cache*/
+    uint8_t wr : 1;   /*1: opened for writing so the reads are not cached*/
+    /*The read-ahead buffer of `drv->read_ahead` bytes follows*/
+} lv_fs_file_cache_t;
+
+/*A file in the shared cache*/
+typedef struct
+{
+    lv_fs_drv_t * drv;              /*NULL: unused*/
+    char path[LV_FS_MAX_FN_LENGTH]; /*Real path of the file*/
+    uint32_t last_use;              /*Time stamp of the last use of a block of the file*/
+    uint16_t open_cnt;              /*Number of opened files using this entry*/
+    uint16_t block_cnt;             /*Number of blocks cached from the file*/
+} lv_fs_cache_file_t;
+
+/*A block in the shared cache*/
+typedef struct
+{
+    uint32_t index;    /*Index of the block in the file*/
+    uint32_t size;     /*Number of valid bytes (less at the end of the file)*/
+    uint32_t last_use; /*Time stamp of the last use*/
+    int16_t file_id;   /*Index in `cache_files` or -1 if unused*/
+} lv_fs_cache_block_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static const char * lv_fs_get_real_path(const char * path);
+#if LV_USE_FS_CACHE
+static void cache_open(lv_fs_file_t * file_p, const char * real_path, lv_fs_mode_t mode);
+static void cache_close(lv_fs_file_t * file_p);
+static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t cache_load(lv_fs_file_t * file_p, uint32_t index, lv_fs_cache_block_t ** block_p);
+static lv_fs_res_t cache_drv_read(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br);
+static int16_t cache_file_find(const lv_fs_drv_t * drv, const char * real_path);
+static void cache_written(lv_fs_file_t * file_p);
+static int16_t cache_file_open(lv_fs_drv_t * drv, const char * real_path);
+static void cache_file_drop(int16_t file_id);
+static lv_fs_cache_block_t * cache_block_find(int16_t file_id, uint32_t index);
+static lv_fs_cache_block_t * cache_block_add(int16_t file_id, uint32_t index);
+static void cache_block_free(lv_fs_cache_block_t * block);
+static inline bool is_cached(const lv_fs_file_t * file_p);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_USE_FS_CACHE
+static lv_fs_cache_file_t cache_files[LV_FS_CACHE_BLOCK_CNT];
+static lv_fs_cache_block_t cache_blocks[LV_FS_CACHE_BLOCK_CNT];
+static uint8_t cache_data[LV_FS_CACHE_BLOCK_CNT][LV_FS_CACHE_BLOCK_SIZE];
+static uint32_t cache_stamp;
+static lv_fs_cache_stat_t cache_stat;
+#endif
 
 /**********************
  *      MACROS
@@ -57,6 +116,14 @@ static const char * lv_fs_get_real_path(const char * path);
 void lv_fs_init(void)
 {
     lv_ll_init(&LV_GC_ROOT(_lv_drv_ll), sizeof(lv_fs_drv_t));
+
+#if LV_USE_FS_CACHE
+    memset(cache_files, 0, sizeof(cache_files));
+    uint16_t i;
+    for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) cache_blocks[i].file_id = -1;
+    cache_stamp = 0;
+    memset(&cache_stat, 0, sizeof(cache_stat));
+#endif
 }
 
 /**
@@ -87,6 +154,9 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 {
     file_p->drv    = NULL;
     file_p->file_d = NULL;
+#if LV_USE_FS_CACHE
+    file_p->cache = NULL;
+#endif
 
     if(path == NULL) return LV_FS_RES_INV_PARAM;
 
@@ -126,6 +196,11 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
         file_p->file_d = NULL;
         file_p->drv    = NULL;
     }
+#if LV_USE_FS_CACHE
+    else {
+        cache_open(file_p, real_path, mode);
+    }
+#endif
 
     return res;
 }
@@ -147,6 +222,10 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
+#if LV_USE_FS_CACHE
+    cache_close(file_p);
+#endif
+
     lv_mem_free(file_p->file_d); /*Clean up*/
     file_p->file_d = NULL;
     file_p->drv    = NULL;
@@ -178,6 +257,10 @@ lv_fs_res_t lv_fs_remove(const char * path)
     const char * real_path = lv_fs_get_real_path(path);
     lv_fs_res_t res        = drv->remove_cb(drv, real_path);
 
+#if LV_USE_FS_CACHE
+    cache_file_drop(cache_file_find(drv, real_path));
+#endif
+
     return res;
 }
 
@@ -196,7 +279,15 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     if(file_p->drv->read_cb == NULL) return LV_FS_RES_NOT_IMP;
 
     uint32_t br_tmp = 0;
-    lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
+    lv_fs_res_t res;
+#if LV_USE_FS_CACHE
+    if(is_cached(file_p)) {
+        res = cache_read(file_p, buf, btr, &br_tmp);
+    } else
+#endif
+    {
+        res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, &br_tmp);
+    }
     if(br != NULL) *br = br_tmp;
 
     return res;
@@ -226,6 +317,10 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
     if(bw != NULL) *bw = bw_tmp;
 
+#if LV_USE_FS_CACHE
+    cache_written(file_p);
+#endif
+
     return res;
 }
 
@@ -245,6 +340,14 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos)
         return LV_FS_RES_NOT_IMP;
     }
 
+#if LV_USE_FS_CACHE
+    /*The driver is moved only when it's read*/
+    if(is_cached(file_p)) {
+        file_p->cache->pos = pos;
+        return LV_FS_RES_OK;
+    }
+#endif
+
     lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos);
 
     return res;
@@ -268,6 +371,13 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
         return LV_FS_RES_NOT_IMP;
     }
 
+#if LV_USE_FS_CACHE
+    if(is_cached(file_p)) {
+        *pos = file_p->cache->pos;
+        return LV_FS_RES_OK;
+    }
+#endif
+
     lv_fs_res_t res = file_p->drv->tell_cb(file_p->drv, file_p->file_d, pos);
 
     return res;
@@ -291,6 +401,10 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p)
 
     lv_fs_res_t res = file_p->drv->trunc_cb(file_p->drv, file_p->file_d);
 
+#if LV_USE_FS_CACHE
+    cache_written(file_p);
+#endif
+
     return res;
 }
 /**
@@ -314,6 +428,59 @@ lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size)
     return res;
 }
 
+/**
+ * Get a pointer to the whole content of a file to access it without copying.
+ * Works only if the driver has `map_cb`. The file should be unmapped before it's closed.
+ * @param file_p pointer to a lv_fs_file_t variable opened for reading
+ * @param buf_p pointer to a variable to store the pointer to the content of the file
+ * @param size_p pointer to a variable to store the size of the file. NULL if unused.
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum (LV_FS_RES_NOT_IMP: the driver can't map files)
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf_p, uint32_t * size_p)
+{
+    if(buf_p == NULL) return LV_FS_RES_INV_PARAM;
+
+    *buf_p = NULL;
+    if(size_p != NULL) *size_p = 0;
+
+    if(file_p->drv == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    if(file_p->drv->map_cb == NULL) return LV_FS_RES_NOT_IMP;
+
+    uint32_t size_tmp = 0;
+    lv_fs_res_t res   = file_p->drv->map_cb(file_p->drv, file_p->file_d, buf_p, &size_tmp);
+    if(res != LV_FS_RES_OK) {
+        *buf_p   = NULL;
+        size_tmp = 0;
+    }
+
+    if(size_p != NULL) *size_p = size_tmp;
+
+    return res;
+}
+
+/**
+ * Release the content of a file got with `lv_fs_map`
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf the pointer given by `lv_fs_map`
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_unmap(lv_fs_file_t * file_p, const void * buf)
+{
+    if(file_p->drv == NULL || buf == NULL) {
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    /*Nothing to release if the file is always accessible (e.g. in ROM)*/
+    if(file_p->drv->unmap_cb == NULL) return LV_FS_RES_OK;
+
+    lv_fs_res_t res = file_p->drv->unmap_cb(file_p->drv, file_p->file_d, buf);
+
+    return res;
+}
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -345,6 +512,11 @@ lv_fs_res_t lv_fs_rename(const char * oldname, const char * newname)
 
     lv_fs_res_t res = drv->rename_cb(drv, old_real, new_real);
 
+#if LV_USE_FS_CACHE
+    cache_file_drop(cache_file_find(drv, old_real));
+    cache_file_drop(cache_file_find(drv, new_real));
+#endif
+
     return res;
 }
 
@@ -612,6 +784,47 @@ const char * lv_fs_get_last(const char * path)
 
     return &path[i + 1];
 }
+
+#if LV_USE_FS_CACHE
+/**
+ * Drop the cached blocks of a file. Required only if the file was modified not via `lv_fs`.
+ * (`lv_fs_write`, `lv_fs_trunc`, `lv_fs_remove` and `lv_fs_rename` drop the blocks automatically)
+ * @param path path to the file beginning with the driver letter. NULL to drop every block.
+ */
+void lv_fs_cache_invalidate(const char * path)
+{
+    if(path == NULL) {
+        uint16_t i;
+        for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+            if(cache_files[i].drv) cache_file_drop(i);
+        }
+        return;
+    }
+
+    lv_fs_drv_t * drv = lv_fs_get_drv(path[0]);
+    if(drv == NULL) return;
+
+    cache_file_drop(cache_file_find(drv, lv_fs_get_real_path(path)));
+}
+
+/**
+ * Get the statistics of the read caching
+ * @param stat pointer to a variable to store the statistics
+ */
+void lv_fs_cache_get_stat(lv_fs_cache_stat_t * stat)
+{
+    memcpy(stat, &cache_stat, sizeof(lv_fs_cache_stat_t));
+}
+
+/**
+ * Clear the statistics of the read caching
+ */
+void lv_fs_cache_reset_stat(void)
+{
+    memset(&cache_stat, 0, sizeof(lv_fs_cache_stat_t));
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -639,4 +852,389 @@ static const char * lv_fs_get_real_path(const char * path)
     return path;
 }
 
+#if LV_USE_FS_CACHE
+
+/**
+ * Create the caching state of a newly opened file
+ * @param file_p pointer to an opened file
+ * @param real_path path of the file without the driver letter
+ * @param mode the mode the file is opened with
+ */
+static void cache_open(lv_fs_file_t * file_p, const char * real_path, lv_fs_mode_t mode)
+{
+    lv_fs_drv_t * drv = file_p->drv;
+    bool wr           = (mode & LV_FS_MODE_WR) ? true : false;
+
+    /*Only the writes needs to be followed to drop the modified blocks*/
+    if(wr) {
+        if(drv->cache == 0) return;
+        cache_file_drop(cache_file_find(drv, real_path));
+    } else if(drv->cache == 0 && drv->read_ahead == 0) {
+        return;
+    }
+
+    uint32_t ra_size = wr ? 0 : drv->read_ahead;
+
+    /*Without memory the file simply works without caching*/
+    lv_fs_file_cache_t * cache = lv_mem_alloc(sizeof(lv_fs_file_cache_t) + ra_size);
+    LV_ASSERT_MEM(cache);
+    if(cache == NULL) return;
+
+    cache->pos     = 0;
+    cache->drv_pos = 0;
+    cache->ra_pos  = 0;
+    cache->ra_len  = 0;
+    cache->wr      = wr ? 1 : 0;
+    cache->file_id = drv->cache ? cache_file_open(drv, real_path) : -1;
+
+    file_p->cache = cache;
+}
+
+/**
+ * Free the caching state of a file. Its blocks remain in the shared cache.
+ * @param file_p pointer to a file being closed
+ */
+static void cache_close(lv_fs_file_t * file_p)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    if(cache == NULL) return;
+
+    if(cache->file_id >= 0) {
+        lv_fs_cache_file_t * file = &cache_files[cache->file_id];
+        file->open_cnt--;
+        if(file->open_cnt == 0 && file->block_cnt == 0) file->drv = NULL;
+    }
+
+    lv_mem_free(cache);
+    file_p->cache = NULL;
+}
+
+/**
+ * Read from a file via its read-ahead buffer and the shared block cache
+ * @param file_p pointer to a file with caching state
+ * @param buf pointer to a buffer where the read bytes are stored
+ * @param btr Bytes To Read
+ * @param br the number of real read bytes (Bytes Read)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t cache_read(lv_fs_file_t * file_p, uint8_t * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    uint8_t * ra_buf           = (uint8_t *)(cache + 1);
+    uint32_t ra_size           = file_p->drv->read_ahead;
+    lv_fs_res_t res            = LV_FS_RES_OK;
+    bool hit                   = true;
+
+    *br = 0;
+    while(btr > 0) {
+        uint32_t n;
+        if(cache->pos >= cache->ra_pos && cache->pos < cache->ra_pos + cache->ra_len) {
+            /*In the read-ahead buffer*/
+            n = LV_MATH_MIN(btr, cache->ra_pos + cache->ra_len - cache->pos);
+            memcpy(buf, &ra_buf[cache->pos - cache->ra_pos], n);
+        } else if(cache->file_id >= 0) {
+            /*In the shared cache*/
+            uint32_t index = cache->pos / LV_FS_CACHE_BLOCK_SIZE;
+            uint32_t ofs   = cache->pos % LV_FS_CACHE_BLOCK_SIZE;
+
+            lv_fs_cache_block_t * block = cache_block_find(cache->file_id, index);
+            if(block == NULL) {
+                hit = false;
+                res = cache_load(file_p, index, &block);
+                if(res != LV_FS_RES_OK) break;
+            }
+
+            if(ofs >= block->size) break; /*End of the file*/
+
+            n = LV_MATH_MIN(btr, block->size - ofs);
+            memcpy(buf, &cache_data[block - cache_blocks][ofs], n);
+        } else if(btr < ra_size) {
+            /*Fill the read-ahead buffer from the current position*/
+            hit            = false;
+            cache->ra_pos  = cache->pos;
+            cache->ra_len  = 0;
+            res            = cache_drv_read(file_p, cache->pos, ra_buf, ra_size, &cache->ra_len);
+            if(res != LV_FS_RES_OK || cache->ra_len == 0) break;
+            continue;
+        } else {
+            /*Too large for the read-ahead buffer so read it directly*/
+            hit = false;
+            res = cache_drv_read(file_p, cache->pos, buf, btr, &n);
+            if(res != LV_FS_RES_OK) break;
+            cache->pos += n;
+            *br += n;
+            break;
+        }
+
+        buf += n;
+        btr -= n;
+        cache->pos += n;
+        *br += n;
+    }
+
+    if(hit) cache_stat.hit++;
+    else cache_stat.miss++;
+
+    return res;
+}
+
+/**
+ * Read a block of a file into the shared cache.
+ * If the read-ahead buffer can hold more blocks the next blocks are read too in the same `read_cb` call.
+ * @param file_p pointer to a file using the shared cache
+ * @param index index of the block in the file
+ * @param block_p store the loaded block here
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t cache_load(lv_fs_file_t * file_p, uint32_t index, lv_fs_cache_block_t ** block_p)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    lv_fs_cache_block_t * block = NULL;
+    lv_fs_res_t res;
+
+    /*Don't read ahead more blocks than half of the cache to not to push out the useful blocks*/
+    uint32_t cnt = file_p->drv->read_ahead / LV_FS_CACHE_BLOCK_SIZE;
+    if(cnt > LV_FS_CACHE_BLOCK_CNT / 2) cnt = LV_FS_CACHE_BLOCK_CNT / 2;
+
+    if(cnt <= 1) {
+        block = cache_block_add(cache->file_id, index);
+        res   = cache_drv_read(file_p, index * LV_FS_CACHE_BLOCK_SIZE, cache_data[block - cache_blocks],
+                             LV_FS_CACHE_BLOCK_SIZE, &block->size);
+        if(res != LV_FS_RES_OK) {
+            cache_block_free(block);
+            return res;
+        }
+
+        *block_p = block;
+        return LV_FS_RES_OK;
+    }
+
+    uint8_t * ra_buf = (uint8_t *)(cache + 1);
+    cache->ra_pos    = index * LV_FS_CACHE_BLOCK_SIZE;
+    cache->ra_len    = 0;
+    res              = cache_drv_read(file_p, cache->ra_pos, ra_buf, cnt * LV_FS_CACHE_BLOCK_SIZE, &cache->ra_len);
+    if(res != LV_FS_RES_OK) {
+        cache->ra_len = 0;
+        return res;
+    }
+
+    /*Add the requested block last to be the most recently used*/
+    uint32_t i = cnt;
+    while(i > 0) {
+        i--;
+        uint32_t ofs = i * LV_FS_CACHE_BLOCK_SIZE;
+        if(i > 0 && (ofs >= cache->ra_len || cache_block_find(cache->file_id, index + i))) continue;
+
+        block       = cache_block_add(cache->file_id, index + i);
+        block->size = ofs < cache->ra_len ? LV_MATH_MIN(cache->ra_len - ofs, LV_FS_CACHE_BLOCK_SIZE) : 0;
+        memcpy(cache_data[block - cache_blocks], &ra_buf[ofs], block->size);
+    }
+
+    *block_p = block;
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read from the driver from a given position. The driver is seeked only if it's not there yet.
+ * @param file_p pointer to a file with caching state
+ * @param pos read from this position
+ * @param buf pointer to a buffer where the read bytes are stored
+ * @param btr Bytes To Read
+ * @param br the number of real read bytes (Bytes Read)
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t cache_drv_read(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_file_cache_t * cache = file_p->cache;
+    lv_fs_drv_t * drv          = file_p->drv;
+    lv_fs_res_t res;
+
+    *br = 0;
+    if(cache->drv_pos != pos) {
+        if(drv->seek_cb == NULL) return LV_FS_RES_NOT_IMP;
+        res = drv->seek_cb(drv, file_p->file_d, pos);
+        cache_stat.drv_seek++;
+        if(res != LV_FS_RES_OK) {
+            cache->drv_pos = CACHE_POS_UNKNOWN;
+            return res;
+        }
+        cache->drv_pos = pos;
+    }
+
+    res = drv->read_cb(drv, file_p->file_d, buf, btr, br);
+    cache_stat.drv_read++;
+    if(res != LV_FS_RES_OK) cache->drv_pos = CACHE_POS_UNKNOWN;
+    else cache->drv_pos += *br;
+
+    return res;
+}
+
+/**
+ * Drop the cached blocks of a file after it was written
+ * @param file_p pointer to a file opened for writing
+ */
+static void cache_written(lv_fs_file_t * file_p)
+{
+    if(file_p->cache == NULL) return;
+
+    /*Not known which file was written so drop everything*/
+    if(file_p->cache->file_id < 0) lv_fs_cache_invalidate(NULL);
+    else cache_file_drop(file_p->cache->file_id);
+}
+
+/**
+ * Find a file in the shared cache
+ * @param drv pointer to the driver of the file
+ * @param real_path path of the file without the driver letter
+ * @return index of the file in `cache_files` or -1 if not found
+ */
+static int16_t cache_file_find(const lv_fs_drv_t * drv, const char * real_path)
+{
+    uint16_t i;
+    for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+        if(cache_files[i].drv == drv && strcmp(cache_files[i].path, real_path) == 0) return i;
+    }
+
+    return -1;
+}
+
+/**
+ * Get the entry of file in the shared cache for an opened file.
+ * If the file is not added yet, a free entry is used or the least recently used closed file is dropped.
+ * @param drv pointer to the driver of the file
+ * @param real_path path of the file without the driver letter
+ * @return index of the file in `cache_files` or -1 if the file can't be cached
+ */
+static int16_t cache_file_open(lv_fs_drv_t * drv, const char * real_path)
+{
+    if(strlen(real_path) >= LV_FS_MAX_FN_LENGTH) return -1;
+
+    int16_t file_id = cache_file_find(drv, real_path);
+    if(file_id < 0) {
+        uint16_t i;
+        for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+            if(cache_files[i].drv == NULL) {
+                file_id = i;
+                break;
+            }
+
+            /*A closed file has blocks else its entry would be free*/
+            if(cache_files[i].open_cnt == 0) {
+                if(file_id < 0 || cache_files[i].last_use < cache_files[file_id].last_use) file_id = i;
+            }
+        }
+
+        /*Every entry is used by an opened file*/
+        if(file_id < 0) return -1;
+
+        if(cache_files[file_id].drv) cache_file_drop(file_id);
+
+        lv_fs_cache_file_t * file = &cache_files[file_id];
+        file->drv                 = drv;
+        file->last_use            = cache_stamp;
+        file->block_cnt           = 0;
+        file->open_cnt            = 0;
+        strcpy(file->path, real_path);
+    }
+
+    cache_files[file_id].open_cnt++;
+
+    return file_id;
+}
+
+/**
+ * Drop the blocks of a file from the shared cache. Its entry is freed if no opened file uses it.
+ * @param file_id index of the file in `cache_files`. Nothing happens if -1.
+ */
+static void cache_file_drop(int16_t file_id)
+{
+    if(file_id < 0) return;
+
+    uint16_t i;
+    for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+        if(cache_blocks[i].file_id == file_id) cache_blocks[i].file_id = -1;
+    }
+
+    cache_files[file_id].block_cnt = 0;
+    if(cache_files[file_id].open_cnt == 0) cache_files[file_id].drv = NULL;
+}
+
+/**
+ * Find a block in the shared cache and mark it as used
+ * @param file_id index of the file in `cache_files`
+ * @param index index of the block in the file
+ * @return pointer to the block or NULL if not cached
+ */
+static lv_fs_cache_block_t * cache_block_find(int16_t file_id, uint32_t index)
+{
+    uint16_t i;
+    for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+        lv_fs_cache_block_t * block = &cache_blocks[i];
+        if(block->file_id == file_id && block->index == index) {
+            cache_stamp++;
+            block->last_use             = cache_stamp;
+            cache_files[file_id].last_use = cache_stamp;
+            return block;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * Add a new block to the shared cache in place of a free or the least recently used block
+ * @param file_id index of the file in `cache_files`
+ * @param index index of the block in the file
+ * @return pointer to the block. Its data and size should be set.
+ */
+static lv_fs_cache_block_t * cache_block_add(int16_t file_id, uint32_t index)
+{
+    lv_fs_cache_block_t * block = &cache_blocks[0];
+    uint16_t i;
+    for(i = 0; i < LV_FS_CACHE_BLOCK_CNT; i++) {
+        if(cache_blocks[i].file_id < 0) {
+            block = &cache_blocks[i];
+            break;
+        }
+        if(cache_blocks[i].last_use < block->last_use) block = &cache_blocks[i];
+    }
+
+    if(block->file_id >= 0) cache_block_free(block);
+
+    cache_stamp++;
+    block->file_id                = file_id;
+    block->index                  = index;
+    block->size                   = 0;
+    block->last_use               = cache_stamp;
+    cache_files[file_id].last_use = cache_stamp;
+    cache_files[file_id].block_cnt++;
+
+    return block;
+}
+
+/**
+ * Remove a block from the shared cache
+ * @param block pointer to a used block
+ */
+static void cache_block_free(lv_fs_cache_block_t * block)
+{
+    lv_fs_cache_file_t * file = &cache_files[block->file_id];
+    file->block_cnt--;
+    if(file->block_cnt == 0 && file->open_cnt == 0) file->drv = NULL;
+
+    block->file_id = -1;
+}
+
+/**
+ * Tell whether the reads of a file go through the caching layer
+ * @param file_p pointer to an opened file
+ * @return true: the reads, seeks and tells are handled by the cache
+ */
+static inline bool is_cached(const lv_fs_file_t * file_p)
+{
+    return file_p->cache != NULL && file_p->cache->wr == 0;
+}
+
+#endif /*LV_USE_FS_CACHE*/
+
 #endif /*LV_USE_FILESYSTEM*/
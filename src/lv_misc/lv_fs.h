@@ -79,6 +79,11 @@ typedef struct _lv_fs_drv_t
     lv_fs_res_t (*tell_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
     lv_fs_res_t (*trunc_cb)(struct _lv_fs_drv_t * drv, void * file_p);
     lv_fs_res_t (*size_cb)(struct _lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+
+    /*Optional: give a pointer to the whole content of an opened file (e.g. with `mmap()` or from an XIP flash).
+     *The content should remain accessible until `unmap_cb` is called.*/
+    lv_fs_res_t (*map_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
+    lv_fs_res_t (*unmap_cb)(struct _lv_fs_drv_t * drv, void * file_p, const void * buf);
     lv_fs_res_t (*rename_cb)(struct _lv_fs_drv_t * drv, const char * oldname, const char * newname);
     lv_fs_res_t (*free_space_cb)(struct _lv_fs_drv_t * drv, uint32_t * total_p, uint32_t * free_p);
 
@@ -86,6 +91,17 @@ typedef struct _lv_fs_drv_t
     lv_fs_res_t (*dir_read_cb)(struct _lv_fs_drv_t * drv, void * rddir_p, char * fn);
     lv_fs_res_t (*dir_close_cb)(struct _lv_fs_drv_t * drv, void * rddir_p);
 
+#if LV_USE_FS_CACHE
+    uint32_t read_ahead; /**< Size of the read-ahead buffer of the files opened for reading [bytes]. 0: not used.
+                              With `cache` the missing blocks are read ahead in one `read_cb` call.*/
+    uint8_t cache : 1;   /**< 1: keep the data read from the files in the shared LRU block cache*/
+#endif
+
+#if LV_USE_FS_MEM
+    const struct _lv_fs_mem_file_t * mem_files; /**< Files of the drivers initialized by `lv_fs_mem_drv_init`*/
+    uint16_t mem_file_cnt;
+#endif
+
 #if LV_USE_USER_DATA
     lv_fs_drv_user_data_t user_data; /**< Custom file user data */
 #endif
@@ -95,6 +111,9 @@ typedef struct
 {
     void * file_d;
     lv_fs_drv_t * drv;
+#if LV_USE_FS_CACHE
+    struct _lv_fs_file_cache_t * cache; /**< State of the read caching. NULL if not used*/
+#endif
 } lv_fs_file_t;
 
 typedef struct
@@ -103,6 +122,17 @@ typedef struct
     lv_fs_drv_t * drv;
 } lv_fs_dir_t;
 
+#if LV_USE_FS_CACHE
+/** Statistics of the read caching*/
+typedef struct
+{
+    uint32_t hit;      /**< Number of `lv_fs_read` calls served without the driver*/
+    uint32_t miss;     /**< Number of `lv_fs_read` calls which needed the driver*/
+    uint32_t drv_read; /**< Number of `read_cb` calls*/
+    uint32_t drv_seek; /**< Number of `seek_cb` calls*/
+} lv_fs_cache_stat_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -217,6 +247,24 @@ lv_fs_res_t lv_fs_trunc(lv_fs_file_t * file_p);
  */
 lv_fs_res_t lv_fs_size(lv_fs_file_t * file_p, uint32_t * size);
 
+/**
+ * Get a pointer to the whole content of a file to access it without copying.
+ * Works only if the driver has `map_cb`. The file should be unmapped before it's closed.
+ * @param file_p pointer to a lv_fs_file_t variable opened for reading
+ * @param buf_p pointer to a variable to store the pointer to the content of the file
+ * @param size_p pointer to a variable to store the size of the file. NULL if unused.
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum (LV_FS_RES_NOT_IMP: the driver can't map files)
+ */
+lv_fs_res_t lv_fs_map(lv_fs_file_t * file_p, const void ** buf_p, uint32_t * size_p);
+
+/**
+ * Release the content of a file got with `lv_fs_map`
+ * @param file_p pointer to a lv_fs_file_t variable
+ * @param buf the pointer given by `lv_fs_map`
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+lv_fs_res_t lv_fs_unmap(lv_fs_file_t * file_p, const void * buf);
+
 /**
  * Rename a file
  * @param oldname path to the file
@@ -258,6 +306,26 @@ lv_fs_res_t lv_fs_dir_close(lv_fs_dir_t * rddir_p);
  */
 lv_fs_res_t lv_fs_free_space(char letter, uint32_t * total_p, uint32_t * free_p);
 
+#if LV_USE_FS_CACHE
+/**
+ * Drop the cached blocks of a file. Required only if the file was modified not via `lv_fs`.
+ * (`lv_fs_write`, `lv_fs_trunc`, `lv_fs_remove` and `lv_fs_rename` drop the blocks automatically)
+ * @param path path to the file beginning with the driver letter. NULL to drop every block.
+ */
+void lv_fs_cache_invalidate(const char * path);
+
+/**
+ * Get the statistics of the read caching
+ * @param stat pointer to a variable to store the statistics
+ */
+void lv_fs_cache_get_stat(lv_fs_cache_stat_t * stat);
+
+/**
+ * Clear the statistics of the read caching
+ */
+void lv_fs_cache_reset_stat(void);
+#endif
+
 /**
  * Fill a buffer with the letters of existing drivers
  * @param buf buffer to store the letters ('\0' added after the last letter)
@@ -0,0 +1,285 @@
+/**
+ * @file lv_fs_mem.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <string.h>
+#include "lv_fs_mem.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_MEM
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*State of an opened file*/
+typedef struct
+{
+    const lv_fs_mem_file_t * file;
+    uint32_t pos;
+} lv_fs_mem_file_dsc_t;
+
+/*State of an opened directory*/
+typedef struct
+{
+    uint16_t next; /*Index of the next file to list*/
+} lv_fs_mem_dir_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_fs_res_t fs_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode);
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p);
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br);
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos);
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p);
+static lv_fs_res_t fs_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p);
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p);
+static lv_fs_res_t fs_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path);
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn);
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * rddir_p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize a file system driver to read files from the memory.
+ * The content of the files can be mapped with `lv_fs_map` (no copy) or read with `lv_fs_read`.
+ * Register the driver with `lv_fs_drv_register()` after it.
+ * @param drv pointer to a driver variable to initialize
+ * @param letter the driver letter (e.g. 'M')
+ * @param files array of the files. Only the pointer is saved so it should remain accessible.
+ * @param file_cnt number of files in `files`
+ */
+void lv_fs_mem_drv_init(lv_fs_drv_t * drv, char letter, const lv_fs_mem_file_t * files, uint16_t file_cnt)
+{
+    lv_fs_drv_init(drv);
+
+    drv->letter       = letter;
+    drv->file_size    = sizeof(lv_fs_mem_file_dsc_t);
+    drv->rddir_size   = sizeof(lv_fs_mem_dir_dsc_t);
+    drv->mem_files    = files;
+    drv->mem_file_cnt = file_cnt;
+
+    drv->open_cb      = fs_open;
+    drv->close_cb     = fs_close;
+    drv->read_cb      = fs_read;
+    drv->seek_cb      = fs_seek;
+    drv->tell_cb      = fs_tell;
+    drv->size_cb      = fs_size;
+    drv->map_cb       = fs_map;
+    drv->dir_open_cb  = fs_dir_open;
+    drv->dir_read_cb  = fs_dir_read;
+    drv->dir_close_cb = fs_dir_close;
+
+    /*The files are always in the memory so nothing to release on unmap*/
+    drv->unmap_cb = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Open a file of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `lv_fs_mem_file_dsc_t` variable
+ * @param path path of the file without the driver letter
+ * @param mode only `LV_FS_MODE_RD` is supported
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_open(lv_fs_drv_t * drv, void * file_p, const char * path, lv_fs_mode_t mode)
+{
+    if(mode & LV_FS_MODE_WR) return LV_FS_RES_DENIED;
+
+    lv_fs_mem_file_dsc_t * dsc = file_p;
+    uint16_t i;
+    for(i = 0; i < drv->mem_file_cnt; i++) {
+        if(strcmp(drv->mem_files[i].name, path) == 0) {
+            dsc->file = &drv->mem_files[i];
+            dsc->pos  = 0;
+            return LV_FS_RES_OK;
+        }
+    }
+
+    return LV_FS_RES_NOT_EX;
+}
+
+/**
+ * Close a file of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `lv_fs_mem_file_dsc_t` variable
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_close(lv_fs_drv_t * drv, void * file_p)
+{
+    (void)drv;    /*Unused*/
+    (void)file_p; /*Unused*/
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read data from a file of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `lv_fs_mem_file_dsc_t` variable
+ * @param buf pointer to a memory block where to store the read data
+ * @param btr number of Bytes To Read
+ * @param br the real number of read bytes (Byte Read)
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    (void)drv; /*Unused*/
+
+    lv_fs_mem_file_dsc_t * dsc = file_p;
+    uint32_t rest              = dsc->file->size - dsc->pos;
+    if(btr > rest) btr = rest;
+
+    memcpy(buf, (const uint8_t *)dsc->file->data + dsc->pos, btr);
+    dsc->pos += btr;
+    *br = btr;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Set the read pointer of a file of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `lv_fs_mem_file_dsc_t` variable
+ * @param pos the new position of the read pointer. Limited to the size of the file.
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos)
+{
+    (void)drv; /*Unused*/
+
+    lv_fs_mem_file_dsc_t * dsc = file_p;
+    dsc->pos                   = pos < dsc->file->size ? pos : dsc->file->size;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the position of the read pointer of a file of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `lv_fs_mem_file_dsc_t` variable
+ * @param pos_p pointer to store the result
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    (void)drv; /*Unused*/
+
+    lv_fs_mem_file_dsc_t * dsc = file_p;
+    *pos_p                     = dsc->pos;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the size of a file of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `lv_fs_mem_file_dsc_t` variable
+ * @param size_p pointer to store the size
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_size(lv_fs_drv_t * drv, void * file_p, uint32_t * size_p)
+{
+    (void)drv; /*Unused*/
+
+    lv_fs_mem_file_dsc_t * dsc = file_p;
+    *size_p                    = dsc->file->size;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Give the content of a file of the memory drive. It's simply the data of the file.
+ * @param drv pointer to a driver where this function belongs
+ * @param file_p pointer to a `lv_fs_mem_file_dsc_t` variable
+ * @param buf_p pointer to store the pointer to the content of the file
+ * @param size_p pointer to store the size of the file
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_map(lv_fs_drv_t * drv, void * file_p, const void ** buf_p, uint32_t * size_p)
+{
+    (void)drv; /*Unused*/
+
+    lv_fs_mem_file_dsc_t * dsc = file_p;
+    *buf_p                     = dsc->file->data;
+    *size_p                    = dsc->file->size;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Open the memory drive to list its files. The drive has no directories.
+ * @param drv pointer to a driver where this function belongs
+ * @param rddir_p pointer to a `lv_fs_mem_dir_dsc_t` variable
+ * @param path only the root ("") can be opened
+ * @return LV_FS_RES_OK or any error from lv_fs_res_t enum
+ */
+static lv_fs_res_t fs_dir_open(lv_fs_drv_t * drv, void * rddir_p, const char * path)
+{
+    (void)drv; /*Unused*/
+
+    if(path[0] != '\0') return LV_FS_RES_NOT_EX;
+
+    lv_fs_mem_dir_dsc_t * dsc = rddir_p;
+    dsc->next                 = 0;
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Read the name of the next file of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param rddir_p pointer to a `lv_fs_mem_dir_dsc_t` variable
+ * @param fn pointer to a buffer to store the file name. Empty string if there are no more files.
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_dir_read(lv_fs_drv_t * drv, void * rddir_p, char * fn)
+{
+    lv_fs_mem_dir_dsc_t * dsc = rddir_p;
+
+    fn[0] = '\0';
+    if(dsc->next < drv->mem_file_cnt) {
+        strncpy(fn, drv->mem_files[dsc->next].name, LV_FS_MAX_FN_LENGTH - 1);
+        fn[LV_FS_MAX_FN_LENGTH - 1] = '\0';
+        dsc->next++;
+    }
+
+    return LV_FS_RES_OK;
+}
+
+/**
+ * Close the listing of the memory drive
+ * @param drv pointer to a driver where this function belongs
+ * @param rddir_p pointer to a `lv_fs_mem_dir_dsc_t` variable
+ * @return LV_FS_RES_OK
+ */
+static lv_fs_res_t fs_dir_close(lv_fs_drv_t * drv, void * rddir_p)
+{
+    (void)drv;     /*Unused*/
+    (void)rddir_p; /*Unused*/
+
+    return LV_FS_RES_OK;
+}
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_MEM*/
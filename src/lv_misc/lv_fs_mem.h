@@ -0,0 +1,60 @@
+/**
+ * @file lv_fs_mem.h
+ * File system driver for read-only files in the memory (e.g. in ROM or in an XIP flash)
+ */
+
+#ifndef LV_FS_MEM_H
+#define LV_FS_MEM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs.h"
+
+#if LV_USE_FILESYSTEM && LV_USE_FS_MEM
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/** A file of a memory drive*/
+typedef struct _lv_fs_mem_file_t
+{
+    const char * name; /**< Path of the file without the driver letter (e.g. "img/logo.bin")*/
+    const void * data; /**< Content of the file. Should remain accessible while the driver is registered.*/
+    uint32_t size;     /**< Size of `data` in bytes*/
+} lv_fs_mem_file_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a file system driver to read files from the memory.
+ * The content of the files can be mapped with `lv_fs_map` (no copy) or read with `lv_fs_read`.
+ * Register the driver with `lv_fs_drv_register()` after it.
+ * @param drv pointer to a driver variable to initialize
+ * @param letter the driver letter (e.g. 'M')
+ * @param files array of the files. Only the pointer is saved so it should remain accessible.
+ * @param file_cnt number of files in `files`
+ */
+void lv_fs_mem_drv_init(lv_fs_drv_t * drv, char letter, const lv_fs_mem_file_t * files, uint16_t file_cnt);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_FILESYSTEM && LV_USE_FS_MEM*/
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif /*LV_FS_MEM_H*/
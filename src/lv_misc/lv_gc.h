@@ -36,12 +36,23 @@ extern "C" {
     f(lv_ll_t, _lv_indev_ll) /*Linked list of screens*/            \
     f(lv_ll_t, _lv_drv_ll)                                         \
     f(lv_ll_t, _lv_file_ll)                                        \
-    f(lv_ll_t, _lv_anim_ll)                                        \
     f(lv_ll_t, _lv_group_ll)                                       \
     f(lv_ll_t, _lv_img_defoder_ll)                                 \
+    f(lv_ll_t, _lv_cont_layout_ll)                                 \
+    f(lv_ll_t, _lv_layer_cache_ll)                                 \
     f(lv_img_cache_entry_t*, _lv_img_cache_array)                  \
+    f(void*, _lv_shadow_cache_array)                               \
+    f(void*, _lv_grad_cache_array)                                 \
+    f(void*, _lv_anim_pool)                                        \
+    f(void*, _lv_anim_values)                                      \
+    f(void*, _lv_anim_hash)                                        \
+    f(void*, _lv_indev_hit_index)                                  \
     f(void*, _lv_task_act)                                         \
-    f(void*, _lv_draw_buf)
+    f(void*, _lv_cont_layout_task)                                 \
+    f(void*, _lv_obj_style_index)                                  \
+    f(void*, _lv_prof_trace)                                       \
+    f(void*, _lv_draw_buf)                                         \
+    f(void*, _lv_draw_mask_buf)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
 #define LV_ROOTS LV_ITERATE_ROOTS(LV_DEFINE_ROOT)
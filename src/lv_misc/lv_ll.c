@@ -13,6 +13,13 @@
 #include "lv_ll.h"
 #include "lv_mem.h"
 
+#if LV_MEM_TRACE
+/*The call sites are saved by the callers' macros. Here the real functions are used.*/
+#undef lv_ll_ins_head
+#undef lv_ll_ins_prev
+#undef lv_ll_ins_tail
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -107,7 +114,12 @@ void * lv_ll_ins_prev(lv_ll_t * ll_p, void * n_act)
     lv_ll_node_t * n_new;
     lv_ll_node_t * n_prev;
 
-    if(NULL == ll_p || NULL == n_act) return NULL;
+    if(NULL == ll_p || NULL == n_act) {
+#if LV_MEM_TRACE
+        lv_mem_trace_site_clear(); /*Don't charge the caller's site to the next allocation*/
+#endif
+        return NULL;
+    }
 
     if(lv_ll_get_head(ll_p) == n_act) {
         n_new = lv_ll_ins_head(ll_p);
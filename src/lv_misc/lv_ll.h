@@ -153,6 +153,13 @@ bool lv_ll_is_empty(lv_ll_t * ll_p);
 
 #define LV_LL_READ_BACK(list, i) for(i = lv_ll_get_tail(&list); i != NULL; i = lv_ll_get_prev(&list, i))
 
+#if LV_MEM_TRACE
+/*Trace the new nodes at the caller of the insert functions instead of in `lv_ll.c`*/
+#define lv_ll_ins_head(ll_p) (lv_mem_trace_site(__FILE__, __LINE__), lv_ll_ins_head(ll_p))
+#define lv_ll_ins_prev(ll_p, n_act) (lv_mem_trace_site(__FILE__, __LINE__), lv_ll_ins_prev(ll_p, n_act))
+#define lv_ll_ins_tail(ll_p) (lv_mem_trace_site(__FILE__, __LINE__), lv_ll_ins_tail(ll_p))
+#endif
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
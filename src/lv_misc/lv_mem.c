@@ -9,12 +9,37 @@
  *********************/
 #include "lv_mem.h"
 #include "lv_math.h"
+#include "lv_printf.h"
+#include "../lv_core/lv_debug.h"
+#include <stdbool.h>
 #include <string.h>
 
 #if LV_MEM_CUSTOM != 0
 #include LV_MEM_CUSTOM_INCLUDE
 #endif
 
+#if LV_MEM_TRACE
+/*The call sites are saved by the callers' macros. Here the real functions are used.*/
+#undef lv_mem_alloc
+#undef lv_mem_realloc
+
+#if LV_ENABLE_GC
+#error "LV_MEM_TRACE is not supported with LV_ENABLE_GC"
+#endif
+
+#if LV_MEM_CUSTOM == 0 && LV_MEM_SIZE >= (1UL << 24)
+#error "LV_MEM_TRACE supports at most 16 MB LV_MEM_SIZE"
+#endif
+
+#if LV_MEM_TRACE_SITE_MAX > 128
+#error "LV_MEM_TRACE_SITE_MAX must be <= 128"
+#endif
+#endif
+
+#if LV_USE_PARALLEL_REFR && LV_ENABLE_GC == 0 && !defined(__GNUC__)
+#error "LV_USE_PARALLEL_REFR requires GCC compatible atomic builtins"
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -41,7 +66,12 @@ typedef union
     struct
     {
         MEM_UNIT used : 1;    /* 1: if the entry is used*/
+#if LV_MEM_TRACE
+        MEM_UNIT site : 7;    /* Index of the call site in the trace*/
+        MEM_UNIT d_size : 24; /* Size off the data (1 means 4 bytes)*/
+#else
         MEM_UNIT d_size : 31; /* Size off the data (1 means 4 bytes)*/
+#endif
     } s;
     MEM_UNIT header; /* The header (used + d_size)*/
 } lv_mem_header_t;
@@ -62,6 +92,15 @@ static lv_mem_ent_t * ent_get_next(lv_mem_ent_t * act_e);
 static void * ent_alloc(lv_mem_ent_t * e, size_t size);
 static void ent_trunc(lv_mem_ent_t * e, size_t size);
 #endif
+#if LV_MEM_TRACE
+static uint8_t trace_site_take(void);
+static void trace_add(lv_mem_ent_t * e, size_t size);
+static void trace_rem(lv_mem_ent_t * e, uint32_t size, bool whole);
+#endif
+#if LV_ENABLE_GC == 0
+static inline void mem_used_add(uint32_t size);
+static inline void mem_used_sub(uint32_t size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -72,6 +111,20 @@ static uint8_t * work_mem;
 
 static uint32_t zero_mem; /*Give the address of this variable if 0 byte should be allocated*/
 
+#if LV_ENABLE_GC == 0
+/*With `LV_USE_PARALLEL_REFR` the render threads allocate too so they are updated atomically*/
+static uint32_t mem_used;     /*Size of the allocated memories*/
+static uint32_t mem_max_used; /*Max. of `mem_used`*/
+#endif
+
+#if LV_MEM_TRACE
+static lv_mem_trace_site_t trace_sites[LV_MEM_TRACE_SITE_MAX];
+static uint16_t trace_site_cnt;
+static uint32_t trace_hist[LV_MEM_TRACE_HIST_NUM];
+static const char * trace_file; /*Call site of the next allocation*/
+static uint16_t trace_line;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -100,6 +153,18 @@ void lv_mem_init(void)
     /*The total mem size id reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+
+#if LV_ENABLE_GC == 0
+    mem_used     = 0;
+    mem_max_used = 0;
+#endif
+
+#if LV_MEM_TRACE
+    memset(trace_sites, 0, sizeof(trace_sites));
+    memset(trace_hist, 0, sizeof(trace_hist));
+    trace_site_cnt = 1; /*The 0th site is for the unknown sites*/
+    trace_file     = NULL;
+#endif
 }
 
 /**
@@ -115,6 +180,11 @@ void lv_mem_deinit(void)
     /*The total mem size id reduced by the first header and the close patterns */
     full->header.s.d_size = LV_MEM_SIZE - sizeof(lv_mem_header_t);
 #endif
+
+#if LV_ENABLE_GC == 0
+    mem_used     = 0;
+    mem_max_used = 0;
+#endif
 }
 
 /**
@@ -124,10 +194,18 @@ void lv_mem_deinit(void)
  */
 void * lv_mem_alloc(size_t size)
 {
+#if LV_MEM_TRACE
+    uint8_t site = trace_site_take();
+#endif
+
     if(size == 0) {
         return &zero_mem;
     }
 
+#if LV_MEM_TRACE
+    size_t req_size = size;
+#endif
+
 #ifdef LV_ARCH_64
     /*Round the size up to 8*/
     if(size & 0x7) {
@@ -164,6 +242,15 @@ void * lv_mem_alloc(size_t size)
 #if LV_ENABLE_GC == 1 /*gc must not include header*/
     alloc = LV_MEM_CUSTOM_ALLOC(size);
 #else                 /* LV_ENABLE_GC */
+#if LV_MEM_TRACE
+    /*The size is stored on 24 bits next to the call site*/
+    if(size >= (1UL << 24)) {
+        LV_DEBUG_ASSERT(false, "LV_MEM_TRACE supports at most 16 MB allocations", size);
+        LV_LOG_WARN("Couldn't allocate memory: too large for LV_MEM_TRACE");
+        return NULL;
+    }
+#endif
+
     /*Allocate a header too to store the size*/
     alloc = LV_MEM_CUSTOM_ALLOC(size + sizeof(lv_mem_header_t));
     if(alloc != NULL) {
@@ -179,6 +266,20 @@ void * lv_mem_alloc(size_t size)
     if(alloc != NULL) memset(alloc, 0xaa, size);
 #endif
 
+#if LV_ENABLE_GC == 0
+    if(alloc != NULL) {
+        mem_used_add(lv_mem_get_size(alloc));
+    }
+#endif
+
+#if LV_MEM_TRACE
+    if(alloc != NULL) {
+        lv_mem_ent_t * alloc_e = (lv_mem_ent_t *)((uint8_t *)alloc - sizeof(lv_mem_header_t));
+        alloc_e->header.s.site = site;
+        trace_add(alloc_e, req_size);
+    }
+#endif
+
     if(alloc == NULL) LV_LOG_WARN("Couldn't allocate memory");
 
     return alloc;
@@ -201,6 +302,10 @@ void lv_mem_free(const void * data)
     /*e points to the header*/
     lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data - sizeof(lv_mem_header_t));
     e->header.s.used = 0;
+    mem_used_sub(e->header.s.d_size);
+#if LV_MEM_TRACE
+    trace_rem(e, e->header.s.d_size, true);
+#endif
 #endif
 
 #if LV_MEM_CUSTOM == 0
@@ -248,13 +353,23 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     }
 
     uint32_t old_size = lv_mem_get_size(data_p);
-    if(old_size == new_size) return data_p; /*Also avoid reallocating the same memory*/
+    if(old_size == new_size) {
+#if LV_MEM_TRACE
+        trace_site_take(); /*Nothing is allocated for this site*/
+#endif
+        return data_p; /*Also avoid reallocating the same memory*/
+    }
 
 #if LV_MEM_CUSTOM == 0
     /* Truncate the memory if the new size is smaller. */
     if(new_size < old_size) {
         lv_mem_ent_t * e = (lv_mem_ent_t *)((uint8_t *)data_p - sizeof(lv_mem_header_t));
         ent_trunc(e, new_size);
+        mem_used_sub(old_size - e->header.s.d_size);
+#if LV_MEM_TRACE
+        trace_site_take(); /*The memory remains at its original site*/
+        trace_rem(e, old_size - e->header.s.d_size, false);
+#endif
         return &e->first_data;
     }
 #endif
@@ -365,8 +480,129 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
         mon_p->frag_pct   = 0; /*no fragmentation if all the RAM is used*/
     }
 #endif
+
+#if LV_ENABLE_GC == 0
+    mon_p->used_size = mem_used;
+    mon_p->max_used  = mem_max_used;
+#endif
+}
+
+/**
+ * Restart measuring the max. size of the allocated memories from the current usage.
+ * Useful to get the memory peak of a specific operation.
+ */
+void lv_mem_reset_max_used(void)
+{
+#if LV_ENABLE_GC == 0
+#if LV_USE_PARALLEL_REFR
+    __atomic_store_n(&mem_max_used, __atomic_load_n(&mem_used, __ATOMIC_RELAXED), __ATOMIC_RELAXED);
+#else
+    mem_max_used = mem_used;
+#endif
+#endif
+}
+
+#if LV_MEM_TRACE
+
+/**
+ * Set the call site of the next allocation. Used by the `lv_mem_alloc/realloc` and similar macros.
+ * If the site is already set the outermost call site is kept until the allocation.
+ * @param file name of the file
+ * @param line line in the file
+ */
+void lv_mem_trace_site(const char * file, uint16_t line)
+{
+    if(trace_file) return;
+
+    trace_file = file;
+    trace_line = line;
+}
+
+/**
+ * Forget the call site set by `lv_mem_trace_site()`.
+ * Used when the function called after `lv_mem_trace_site()` returns without allocating.
+ */
+void lv_mem_trace_site_clear(void)
+{
+    trace_file = NULL;
+}
+
+/**
+ * Get the number of the traced call sites
+ * @return number of sites
+ */
+uint16_t lv_mem_trace_get_site_cnt(void)
+{
+    return trace_site_cnt;
+}
+
+/**
+ * Get the statistics of a call site
+ * @param id index of the site [0..`lv_mem_trace_get_site_cnt()`-1].
+ *           0 collects the allocations whose site is unknown or didn't fit into the table.
+ * @return pointer to the statistics
+ */
+const lv_mem_trace_site_t * lv_mem_trace_get_site(uint16_t id)
+{
+    if(id >= trace_site_cnt) return NULL;
+
+    return &trace_sites[id];
+}
+
+/**
+ * Get the number of allocations in a size class
+ * @param id index of the size class [0..`LV_MEM_TRACE_HIST_NUM`-1].
+ *           The `id`th class contains the sizes in (2^(id + 2), 2^(id + 3)], the last class all the larger sizes too.
+ * @return number of allocations with this size
+ */
+uint32_t lv_mem_trace_get_hist(uint8_t id)
+{
+    if(id >= LV_MEM_TRACE_HIST_NUM) return 0;
+
+    return trace_hist[id];
+}
+
+/**
+ * Log the live allocations per call site and the histogram of the allocation sizes with `lv_log`.
+ * The file and line of the log messages are the call sites.
+ * @param level the log level to use
+ */
+void lv_mem_trace_dump(lv_log_level_t level)
+{
+#if LV_USE_LOG
+    char buf[128];
+    uint16_t i;
+    uint32_t cnt = 0;
+    for(i = 0; i < trace_site_cnt; i++) cnt += trace_sites[i].cnt;
+    lv_snprintf(buf, sizeof(buf), "Heap: %lu bytes in %lu blocks are used, the max. was %lu bytes",
+                (unsigned long)mem_used, (unsigned long)cnt, (unsigned long)mem_max_used);
+    lv_log_add(level, __FILE__, __LINE__, buf);
+
+    for(i = 0; i < trace_site_cnt; i++) {
+        const lv_mem_trace_site_t * site = &trace_sites[i];
+        if(site->alloc_cnt == 0) continue;
+
+        lv_snprintf(buf, sizeof(buf), "%lu bytes in %lu blocks, max. %lu bytes, %lu allocations",
+                    (unsigned long)site->size, (unsigned long)site->cnt, (unsigned long)site->max_size,
+                    (unsigned long)site->alloc_cnt);
+        lv_log_add(level, site->file ? site->file : "unknown", site->line, buf);
+    }
+
+    for(i = 0; i < LV_MEM_TRACE_HIST_NUM; i++) {
+        if(trace_hist[i] == 0) continue;
+
+        lv_snprintf(buf, sizeof(buf), "%lu allocations of %s%lu bytes", (unsigned long)trace_hist[i],
+                    i == LV_MEM_TRACE_HIST_NUM - 1 ? "more than " : "<= ",
+                    (unsigned long)(i == LV_MEM_TRACE_HIST_NUM - 1 ? 1UL << (i + 2) : 1UL << (i + 3)));
+        lv_log_add(level, __FILE__, __LINE__, buf);
+    }
+#else
+    (void)level; /*Unused*/
+#endif
 }
 
+#endif /*LV_MEM_TRACE*/
+
 /**
  * Give the size of an allocated memory
  * @param data pointer to an allocated memory
@@ -483,3 +719,96 @@ static void ent_trunc(lv_mem_ent_t * e, size_t size)
 }
 
 #endif
+
+#if LV_MEM_TRACE
+/**
+ * Get the index of the call site set by `lv_mem_trace_site()` and clear it for the next allocation.
+ * Add the site to the table if it's not there yet.
+ * @return index of the site. 0 if it's unknown or the table is full.
+ */
+static uint8_t trace_site_take(void)
+{
+    const char * file = trace_file;
+    trace_file        = NULL;
+    if(file == NULL) return 0;
+
+    uint16_t i;
+    for(i = 1; i < trace_site_cnt; i++) {
+        lv_mem_trace_site_t * site = &trace_sites[i];
+        if(site->line == trace_line && (site->file == file || strcmp(site->file, file) == 0)) return i;
+    }
+
+    if(trace_site_cnt >= LV_MEM_TRACE_SITE_MAX) return 0;
+
+    lv_mem_trace_site_t * site = &trace_sites[trace_site_cnt];
+    site->file                 = file;
+    site->line                 = trace_line;
+    trace_site_cnt++;
+
+    return trace_site_cnt - 1;
+}
+
+/**
+ * Add a new allocation to the statistics of its site and to the histogram
+ * @param e pointer to the allocated entry. Its site is already set.
+ * @param size the requested size
+ */
+static void trace_add(lv_mem_ent_t * e, size_t size)
+{
+    lv_mem_trace_site_t * site = &trace_sites[e->header.s.site];
+    site->cnt++;
+    site->alloc_cnt++;
+    site->size += e->header.s.d_size;
+    if(site->size > site->max_size) site->max_size = site->size;
+
+    uint8_t h = 0;
+    while(h < LV_MEM_TRACE_HIST_NUM - 1 && size > (1UL << (h + 3))) h++;
+    trace_hist[h]++;
+}
+
+/**
+ * Remove memory from the statistics of its site
+ * @param e pointer to an entry which is freed or truncated
+ * @param size the size to remove
+ * @param whole true: the entry is freed; false: only truncated
+ */
+static void trace_rem(lv_mem_ent_t * e, uint32_t size, bool whole)
+{
+    lv_mem_trace_site_t * site = &trace_sites[e->header.s.site];
+    site->size -= size;
+    if(whole) site->cnt--;
+}
+#endif
+
+#if LV_ENABLE_GC == 0
+/**
+ * Add an allocation to the used memory and update its maximum
+ * @param size size of the allocated memory
+ */
+static inline void mem_used_add(uint32_t size)
+{
+#if LV_USE_PARALLEL_REFR
+    uint32_t used = __atomic_add_fetch(&mem_used, size, __ATOMIC_RELAXED);
+    uint32_t max  = __atomic_load_n(&mem_max_used, __ATOMIC_RELAXED);
+    while(used > max) {
+        if(__atomic_compare_exchange_n(&mem_max_used, &max, used, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) break;
+    }
+#else
+    mem_used += size;
+    if(mem_used > mem_max_used) mem_max_used = mem_used;
+#endif
+}
+
+/**
+ * Remove a freed or truncated memory from the used memory
+ * @param size the size to remove
+ */
+static inline void mem_used_sub(uint32_t size)
+{
+#if LV_USE_PARALLEL_REFR
+    __atomic_sub_fetch(&mem_used, size, __ATOMIC_RELAXED);
+#else
+    mem_used -= size;
+#endif
+}
+#endif
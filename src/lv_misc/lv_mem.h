@@ -27,6 +27,8 @@ extern "C" {
 /*********************
  *      DEFINES
  *********************/
+/*Number of allocation size classes in the trace: <= 8, <= 16, ... <= 128 k and larger*/
+#define LV_MEM_TRACE_HIST_NUM 16
 
 /**********************
  *      TYPEDEFS
@@ -44,8 +46,25 @@ typedef struct
     uint32_t used_cnt;
     uint8_t used_pct; /**< Percentage used */
     uint8_t frag_pct; /**< Amount of fragmentation */
+    uint32_t used_size; /**< Size of the allocated memories (without the headers) */
+    uint32_t max_used;  /**< Max. of `used_size` since `lv_mem_init()` or `lv_mem_reset_max_used()` */
 } lv_mem_monitor_t;
 
+#if LV_MEM_TRACE
+/**
+ * Statistics of an allocation call site
+ */
+typedef struct
+{
+    const char * file;  /**< File of the call site. NULL for the sites which didn't fit into the table */
+    uint16_t line;      /**< Line of the call site */
+    uint32_t cnt;       /**< Number of the live allocations */
+    uint32_t size;      /**< Size of the live allocations */
+    uint32_t max_size;  /**< Max. of `size` */
+    uint32_t alloc_cnt; /**< Number of all allocations */
+} lv_mem_trace_site_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -95,6 +114,57 @@ void lv_mem_defrag(void);
  */
 void lv_mem_monitor(lv_mem_monitor_t * mon_p);
 
+/**
+ * Restart measuring the max. size of the allocated memories from the current usage.
+ * Useful to get the memory peak of a specific operation.
+ */
+void lv_mem_reset_max_used(void);
+
+#if LV_MEM_TRACE
+/**
+ * Set the call site of the next allocation. Used by the `lv_mem_alloc/realloc` and similar macros.
+ * If the site is already set the outermost call site is kept until the allocation.
+ * @param file name of the file
+ * @param line line in the file
+ */
+void lv_mem_trace_site(const char * file, uint16_t line);
+
+/**
+ * Forget the call site set by `lv_mem_trace_site()`.
+ * Used when the function called after `lv_mem_trace_site()` returns without allocating.
+ */
+void lv_mem_trace_site_clear(void);
+
+/**
+ * Get the number of the traced call sites
+ * @return number of sites
+ */
+uint16_t lv_mem_trace_get_site_cnt(void);
+
+/**
+ * Get the statistics of a call site
+ * @param id index of the site [0..`lv_mem_trace_get_site_cnt()`-1].
+ *           0 collects the allocations whose site is unknown or didn't fit into the table.
+ * @return pointer to the statistics
+ */
+const lv_mem_trace_site_t * lv_mem_trace_get_site(uint16_t id);
+
+/**
+ * Get the number of allocations in a size class
+ * @param id index of the size class [0..`LV_MEM_TRACE_HIST_NUM`-1].
+ *           The `id`th class contains the sizes in (2^(id + 2), 2^(id + 3)], the last class all the larger sizes too.
+ * @return number of allocations with this size
+ */
+uint32_t lv_mem_trace_get_hist(uint8_t id);
+
+/**
+ * Log the live allocations per call site and the histogram of the allocation sizes with `lv_log`.
+ * The file and line of the log messages are the call sites.
+ * @param level the log level to use
+ */
+void lv_mem_trace_dump(lv_log_level_t level);
+#endif
+
 /**
  * Give the size of an allocated memory
  * @param data pointer to an allocated memory
@@ -106,6 +176,11 @@ uint32_t lv_mem_get_size(const void * data);
  *      MACROS
  **********************/
 
+#if LV_MEM_TRACE
+#define lv_mem_alloc(size) (lv_mem_trace_site(__FILE__, __LINE__), lv_mem_alloc(size))
+#define lv_mem_realloc(data_p, new_size) (lv_mem_trace_site(__FILE__, __LINE__), lv_mem_realloc(data_p, new_size))
+#endif
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -2,6 +2,7 @@ CSRCS += lv_circ.c
 CSRCS += lv_area.c
 CSRCS += lv_task.c
 CSRCS += lv_fs.c
+CSRCS += lv_fs_mem.c
 CSRCS += lv_anim.c
 CSRCS += lv_mem.c
 CSRCS += lv_ll.c
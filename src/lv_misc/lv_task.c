@@ -10,6 +10,7 @@
 #include <stddef.h>
 #include "lv_task.h"
 #include "../lv_core/lv_debug.h"
+#include "../lv_core/lv_cmdq.h"
 #include "../lv_hal/lv_hal_tick.h"
 #include "lv_gc.h"
 
@@ -83,6 +84,11 @@ LV_ATTRIBUTE_TASK_HANDLER void lv_task_handler(void)
 
     handler_start = lv_tick_get();
 
+#if LV_USE_CMDQ
+    /*Execute the commands sent from the other threads*/
+    lv_cmdq_handler();
+#endif
+
     /* Run all task from the highest to the lowest priority
      * If a lower priority task is executed check task again from the highest priority
      * but on the priority of executed tasks don't run tasks before the executed*/
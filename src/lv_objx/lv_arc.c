@@ -240,7 +240,8 @@ static bool lv_arc_design(lv_obj_t * arc, const lv_area_t * mask, lv_design_mode
         lv_opa_t opa_scale = lv_obj_get_opa_scale(arc);
         lv_draw_arc(x, y, r, mask, ext->angle_start, ext->angle_end, style, opa_scale);
 
-        /*Draw circle on the ends if enabled */
+#if LV_USE_DRAW_RASTER == 0
+        /*Draw circle on the ends if enabled. (The rasterizer draws the round ends with the arc.)*/
         if(style->line.rounded) {
             lv_coord_t thick_half = style->line.width / 2;
             lv_coord_t cir_x      = ((r - thick_half) * lv_trigo_sin(ext->angle_start) >> LV_TRIGO_SHIFT);
@@ -269,7 +270,7 @@ static bool lv_arc_design(lv_obj_t * arc, const lv_area_t * mask, lv_design_mode
 
             lv_draw_rect(&cir_area, mask, &cir_style, opa_scale);
         }
-
+#endif
     }
     /*Post draw when the children are drawn*/
     else if(mode == LV_DESIGN_DRAW_POST) {
@@ -547,6 +547,7 @@ static lv_res_t lv_btn_signal(lv_obj_t * btn, lv_signal_t sign, void * param)
             lv_indev_get_point(lv_indev_get_act(), &ink_point);
 
             lv_anim_t a;
+            lv_anim_init(&a);
             a.var            = btn;
             a.start          = 0;
             a.end            = LV_BTN_INK_VALUE_MAX;
@@ -621,6 +622,7 @@ static lv_res_t lv_btn_signal(lv_obj_t * btn, lv_signal_t sign, void * param)
             lv_indev_get_point(lv_indev_get_act(), &ink_point);
 
             lv_anim_t a;
+            lv_anim_init(&a);
             a.var            = ink_obj;
             a.start          = LV_BTN_INK_VALUE_MAX;
             a.end            = 0;
@@ -699,6 +701,7 @@ static void lv_btn_ink_effect_anim_ready(lv_anim_t * a)
 
     if((state == LV_BTN_STATE_REL || state == LV_BTN_STATE_TGL_REL) && ext->toggle == 0 && ink_playback == false) {
         lv_anim_t new_a;
+        lv_anim_init(&new_a);
         new_a.var            = ink_obj;
         new_a.start          = LV_BTN_INK_VALUE_MAX;
         new_a.end            = 0;
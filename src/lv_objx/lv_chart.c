@@ -31,6 +31,7 @@
 #define LV_CHART_AXIS_SECONDARY_Y 0
 #define LV_CHART_LABEL_ITERATOR_FORWARD 1
 #define LV_CHART_LABEL_ITERATOR_REVERSE 0
+#define LV_CHART_LINE_CHUNK_SIZE 32 /*Number of points drawn at once as a polyline*/
 
 /**********************
  *      TYPEDEFS
@@ -50,6 +51,7 @@ static bool lv_chart_design(lv_obj_t * chart, const lv_area_t * mask, lv_design_
 static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param);
 static void lv_chart_draw_div(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask);
+static void lv_chart_draw_envelope(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * mask);
 static void lv_chart_draw_points(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_cols(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_draw_vertical_lines(lv_obj_t * chart, const lv_area_t * mask);
@@ -58,6 +60,9 @@ static void lv_chart_draw_axes(lv_obj_t * chart, const lv_area_t * mask);
 static void lv_chart_inv_lines(lv_obj_t * chart, uint16_t i);
 static void lv_chart_inv_points(lv_obj_t * chart, uint16_t i);
 static void lv_chart_inv_cols(lv_obj_t * chart, uint16_t i);
+static void lv_chart_inv_point_range(lv_obj_t * chart, uint16_t first, uint16_t last);
+static lv_coord_t * lv_chart_realloc_points(lv_coord_t * points, uint16_t start_point, uint16_t point_cnt_old,
+                                            uint16_t point_cnt);
 static void lv_chart_get_next_label(lv_chart_label_iterator_t * iterator, char * buf);
 static inline bool lv_chart_is_tick_with_label(uint8_t tick_num, lv_chart_axis_cfg_t * axis);
 static lv_chart_label_iterator_t lv_chart_create_label_iter(const char * list, uint8_t iterator_dir);
@@ -111,6 +116,7 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, const lv_obj_t * copy)
     ext->series.dark           = LV_OPA_50;
     ext->series.width          = 2;
     ext->margin                = 0;
+    ext->decimation            = 0;
     memset(&ext->x_axis, 0, sizeof(ext->x_axis));
     memset(&ext->y_axis, 0, sizeof(ext->y_axis));
     memset(&ext->secondary_y_axis, 0, sizeof(ext->secondary_y_axis));
@@ -150,6 +156,7 @@ lv_obj_t * lv_chart_create(lv_obj_t * par, const lv_obj_t * copy)
         ext->point_cnt  = ext_copy->point_cnt;
         ext->series.opa = ext_copy->series.opa;
         ext->margin     = ext_copy->margin;
+        ext->decimation = ext_copy->decimation;
         memcpy(&ext->x_axis, &ext_copy->x_axis, sizeof(lv_chart_axis_cfg_t));
         memcpy(&ext->y_axis, &ext_copy->y_axis, sizeof(lv_chart_axis_cfg_t));
         memcpy(&ext->secondary_y_axis, &ext_copy->secondary_y_axis, sizeof(lv_chart_axis_cfg_t));
@@ -195,7 +202,22 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * chart, lv_color_t color)
         return NULL;
     }
 
+    ser->points_min = NULL;
+    if(ext->decimation != 0) {
+        ser->points_min = lv_mem_alloc(sizeof(lv_coord_t) * ext->point_cnt);
+        LV_ASSERT_MEM(ser->points_min);
+        if(ser->points_min == NULL) {
+            lv_mem_free(ser->points);
+            lv_ll_rem(&ext->series_ll, ser);
+            lv_mem_free(ser);
+            return NULL;
+        }
+    }
+
     ser->start_point = 0;
+    ser->acc_cnt     = 0;
+    ser->acc_min     = def;
+    ser->acc_max     = def;
 
     uint16_t i;
     lv_coord_t * p_tmp = ser->points;
@@ -204,6 +226,12 @@ lv_chart_series_t * lv_chart_add_series(lv_obj_t * chart, lv_color_t color)
         p_tmp++;
     }
 
+    if(ser->points_min) {
+        for(i = 0; i < ext->point_cnt; i++) {
+            ser->points_min[i] = def;
+        }
+    }
+
     ext->series.num++;
 
     return ser;
@@ -226,9 +254,11 @@ void lv_chart_clear_serie(lv_obj_t * chart, lv_chart_series_t * serie)
     uint32_t i;
     for(i = 0; i < ext->point_cnt; i++) {
         serie->points[i] = LV_CHART_POINT_DEF;
+        if(serie->points_min) serie->points_min[i] = LV_CHART_POINT_DEF;
     }
 
     serie->start_point = 0;
+    serie->acc_cnt     = 0;
 }
 
 /*=====================
@@ -304,46 +334,19 @@ void lv_chart_set_point_count(lv_obj_t * chart, uint16_t point_cnt)
 
     lv_chart_series_t * ser;
     uint16_t point_cnt_old = ext->point_cnt;
-    uint16_t i;
-    lv_coord_t def = LV_CHART_POINT_DEF;
 
     if(point_cnt < 1) point_cnt = 1;
 
     LV_LL_READ_BACK(ext->series_ll, ser)
     {
-        if(ser->start_point != 0) {
-            lv_coord_t * new_points = lv_mem_alloc(sizeof(lv_coord_t) * point_cnt);
-            LV_ASSERT_MEM(new_points);
-            if(new_points == NULL) return;
+        lv_coord_t * new_points = lv_chart_realloc_points(ser->points, ser->start_point, point_cnt_old, point_cnt);
+        if(new_points == NULL) return;
+        ser->points = new_points;
 
-            if(point_cnt >= point_cnt_old) {
-                for(i = 0; i < point_cnt_old; i++) {
-                    new_points[i] =
-                        ser->points[(i + ser->start_point) % point_cnt_old]; /*Copy old contents to new array*/
-                }
-                for(i = point_cnt_old; i < point_cnt; i++) {
-                    new_points[i] = def; /*Fill up the rest with default value*/
-                }
-            } else {
-                for(i = 0; i < point_cnt; i++) {
-                    new_points[i] =
-                        ser->points[(i + ser->start_point) % point_cnt_old]; /*Copy old contents to new array*/
-                }
-            }
-
-            /*Switch over pointer from old to new*/
-            lv_mem_free(ser->points);
-            ser->points = new_points;
-        } else {
-            ser->points = lv_mem_realloc(ser->points, sizeof(lv_coord_t) * point_cnt);
-            LV_ASSERT_MEM(ser->points);
-            if(ser->points == NULL) return;
-            /*Initialize the new points*/
-            if(point_cnt > point_cnt_old) {
-                for(i = point_cnt_old - 1; i < point_cnt; i++) {
-                    ser->points[i] = def;
-                }
-            }
+        if(ser->points_min) {
+            new_points = lv_chart_realloc_points(ser->points_min, ser->start_point, point_cnt_old, point_cnt);
+            if(new_points == NULL) return;
+            ser->points_min = new_points;
         }
 
         ser->start_point = 0;
@@ -416,8 +419,10 @@ void lv_chart_init_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t
     uint16_t i;
     for(i = 0; i < ext->point_cnt; i++) {
         ser->points[i] = y;
+        if(ser->points_min) ser->points_min[i] = y;
     }
     ser->start_point = 0;
+    ser->acc_cnt     = 0;
     lv_chart_refresh(chart);
 }
 
@@ -434,7 +439,9 @@ void lv_chart_set_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y
 
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
     memcpy(ser->points, y_array, ext->point_cnt * (sizeof(lv_coord_t)));
+    if(ser->points_min) memcpy(ser->points_min, y_array, ext->point_cnt * (sizeof(lv_coord_t)));
     ser->start_point = 0;
+    ser->acc_cnt     = 0;
     lv_chart_refresh(chart);
 }
 
@@ -450,6 +457,8 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
     LV_ASSERT_NULL(ser);
 
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ser->points_min) ser->points_min[ser->start_point] = y;
+
     if(ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT) {
         ser->points[ser->start_point] =
             y; /*This was the place of the former left most value, after shifting it is the rightmost*/
@@ -468,6 +477,103 @@ void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y)
     }
 }
 
+/**
+ * Add a batch of new samples to a data series.
+ * The samples are stored the same way as with `lv_chart_set_next` but the chart is invalidated only once.
+ * If decimation is enabled every `decimation` samples are reduced to a min/max pair stored in one point.
+ * In `LV_CHART_UPDATE_MODE_CIRCULAR` only the area of the updated points is invalidated.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y_array array of new samples
+ * @param cnt number of elements in `y_array`
+ */
+void lv_chart_set_next_array(lv_obj_t * chart, lv_chart_series_t * ser, const lv_coord_t y_array[], uint32_t cnt)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+    LV_ASSERT_NULL(ser);
+    LV_ASSERT_NULL(y_array);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    uint16_t first       = ser->start_point;
+    uint32_t stored_cnt  = 0;
+    uint32_t i;
+
+    for(i = 0; i < cnt; i++) {
+        lv_coord_t y = y_array[i];
+        if(ser->points_min == NULL) {
+            ser->points[ser->start_point] = y;
+        } else {
+            /*Accumulate the min/max of the samples. Skip the "no data" samples if there is real data*/
+            if(ser->acc_cnt == 0 || ser->acc_max == LV_CHART_POINT_DEF) {
+                ser->acc_min = y;
+                ser->acc_max = y;
+            } else if(y != LV_CHART_POINT_DEF) {
+                if(y < ser->acc_min) ser->acc_min = y;
+                if(y > ser->acc_max) ser->acc_max = y;
+            }
+
+            ser->acc_cnt++;
+            if(ser->acc_cnt < ext->decimation) continue;
+
+            ser->points[ser->start_point]     = ser->acc_max;
+            ser->points_min[ser->start_point] = ser->acc_min;
+            ser->acc_cnt                      = 0;
+        }
+
+        ser->start_point = (ser->start_point + 1) % ext->point_cnt;
+        stored_cnt++;
+    }
+
+    if(stored_cnt == 0) return;
+
+    /*In shift mode every point moves so the whole chart needs to be redrawn*/
+    if(ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT || stored_cnt >= ext->point_cnt) {
+        lv_chart_refresh(chart);
+        return;
+    }
+
+    uint32_t last = first + stored_cnt - 1;
+    if(last < ext->point_cnt) {
+        lv_chart_inv_point_range(chart, first, last);
+    } else {
+        lv_chart_inv_point_range(chart, first, ext->point_cnt - 1);
+        lv_chart_inv_point_range(chart, 0, last - ext->point_cnt);
+    }
+}
+
+/**
+ * Set the number of samples decimated into one point by `lv_chart_set_next_array`.
+ * If enabled the minimum and maximum of the samples are stored for every point
+ * and the line charts draw the min/max envelope of the series.
+ * @param chart pointer to a chart object
+ * @param decimation number of samples per point (0: disable decimation)
+ */
+void lv_chart_set_decimation(lv_obj_t * chart, uint16_t decimation)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->decimation == decimation) return;
+
+    lv_chart_series_t * ser;
+    LV_LL_READ(ext->series_ll, ser)
+    {
+        ser->acc_cnt = 0;
+        if(decimation == 0) {
+            lv_mem_free(ser->points_min);
+            ser->points_min = NULL;
+        } else if(ser->points_min == NULL) {
+            ser->points_min = lv_mem_alloc(sizeof(lv_coord_t) * ext->point_cnt);
+            LV_ASSERT_MEM(ser->points_min);
+            if(ser->points_min == NULL) return;
+            memcpy(ser->points_min, ser->points, sizeof(lv_coord_t) * ext->point_cnt);
+        }
+    }
+
+    ext->decimation = decimation;
+    lv_chart_refresh(chart);
+}
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
@@ -639,6 +745,19 @@ uint16_t lv_chart_get_point_cnt(const lv_obj_t * chart)
     return ext->point_cnt;
 }
 
+/**
+ * Get the number of samples decimated into one point
+ * @param chart pointer to chart object
+ * @return number of samples per point (0: decimation is disabled)
+ */
+uint16_t lv_chart_get_decimation(const lv_obj_t * chart)
+{
+    LV_ASSERT_OBJ(chart, LV_OBJX_NAME);
+
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    return ext->decimation;
+}
+
 /**
  * Get the opacity of the data series
  * @param chart pointer to chart object
@@ -770,10 +889,11 @@ static lv_res_t lv_chart_signal(lv_obj_t * chart, lv_signal_t sign, void * param
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
 
     if(sign == LV_SIGNAL_CLEANUP) {
-        lv_coord_t ** datal;
-        LV_LL_READ(ext->series_ll, datal)
+        lv_chart_series_t * ser;
+        LV_LL_READ(ext->series_ll, ser)
         {
-            lv_mem_free(*datal);
+            lv_mem_free(ser->points);
+            if(ser->points_min) lv_mem_free(ser->points_min);
         }
         lv_ll_clear(&ext->series_ll);
     } else if(sign == LV_SIGNAL_REFR_EXT_DRAW_PAD) {
@@ -853,16 +973,14 @@ static void lv_chart_draw_div(lv_obj_t * chart, const lv_area_t * mask)
 static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
 {
     lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->point_cnt < 2) return;
 
-    uint16_t i;
-    lv_point_t p1;
-    lv_point_t p2;
+    int32_t i;
     lv_coord_t w     = lv_obj_get_width(chart);
     lv_coord_t h     = lv_obj_get_height(chart);
     lv_coord_t x_ofs = chart->coords.x1;
     lv_coord_t y_ofs = chart->coords.y1;
     int32_t y_tmp;
-    lv_coord_t p_prev;
     lv_coord_t p_act;
     lv_chart_series_t * ser;
     lv_opa_t opa_scale = lv_obj_get_opa_scale(chart);
@@ -871,38 +989,117 @@ static void lv_chart_draw_lines(lv_obj_t * chart, const lv_area_t * mask)
     style.line.opa   = ext->series.opa;
     style.line.width = ext->series.width;
 
+    lv_point_t points[LV_CHART_LINE_CHUNK_SIZE];
+    uint16_t point_num;
+    uint16_t pdiv = ext->point_cnt - 1;
+
+    if(w <= 0) return; /*The points can't be mapped to the mask*/
+
+    /*Get the points whose segments can be on the mask*/
+    int32_t i_start = ((int32_t)(mask->x1 - x_ofs - ext->series.width) * pdiv) / w - 1;
+    int32_t i_end   = ((int32_t)(mask->x2 - x_ofs + ext->series.width) * pdiv) / w + 1;
+    if(i_start < 0) i_start = 0;
+    if(i_end > pdiv) i_end = pdiv;
+
     /*Go through all data lines*/
     LV_LL_READ_BACK(ext->series_ll, ser)
     {
+        if(ser->points_min) {
+            lv_chart_draw_envelope(chart, ser, mask);
+            continue;
+        }
+
         style.line.color = ser->color;
 
         lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
 
-        p1.x = 0 + x_ofs;
-        p2.x = 0 + x_ofs;
+        /*Collect the points into chunks and draw them as polylines. Break the line at missing points.*/
+        point_num = 0;
+        for(i = i_start; i <= i_end; i++) {
+            p_act = (start_point + i) % ext->point_cnt;
+            if(ser->points[p_act] == LV_CHART_POINT_DEF) {
+                lv_draw_polyline(points, point_num, true, mask, &style, opa_scale);
+                point_num = 0;
+                continue;
+            }
 
-        p_prev = start_point;
-        y_tmp  = (int32_t)((int32_t)ser->points[p_prev] - ext->ymin) * h;
-        y_tmp  = y_tmp / (ext->ymax - ext->ymin);
-        p2.y   = h - y_tmp + y_ofs;
+            y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin) * h;
+            y_tmp = y_tmp / (ext->ymax - ext->ymin);
 
-        for(i = 1; i < ext->point_cnt; i++) {
-            p1.x = p2.x;
-            p1.y = p2.y;
+            points[point_num].x = ((w * i) / pdiv) + x_ofs;
+            points[point_num].y = h - y_tmp + y_ofs;
+            point_num++;
 
-            p2.x = ((w * i) / (ext->point_cnt - 1)) + x_ofs;
+            if(point_num == LV_CHART_LINE_CHUNK_SIZE) {
+                lv_draw_polyline(points, point_num, true, mask, &style, opa_scale);
+                /*Continue the next chunk from the last point*/
+                points[0] = points[point_num - 1];
+                point_num = 1;
+            }
+        }
 
-            p_act = (start_point + i) % ext->point_cnt;
+        lv_draw_polyline(points, point_num, true, mask, &style, opa_scale);
+    }
+}
 
-            y_tmp = (int32_t)((int32_t)ser->points[p_act] - ext->ymin) * h;
-            y_tmp = y_tmp / (ext->ymax - ext->ymin);
-            p2.y  = h - y_tmp + y_ofs;
+/**
+ * Draw the min/max envelope of a decimated series as vertical spans.
+ * Only the points in the mask are processed.
+ * @param chart pointer to chart object
+ * @param ser pointer to a series of the chart with `points_min`
+ * @param mask mask, inherited from the design function
+ */
+static void lv_chart_draw_envelope(lv_obj_t * chart, lv_chart_series_t * ser, const lv_area_t * mask)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+    if(ext->point_cnt < 2 || ext->ymax == ext->ymin) return;
 
-            if(ser->points[p_prev] != LV_CHART_POINT_DEF && ser->points[p_act] != LV_CHART_POINT_DEF)
-                lv_draw_line(&p1, &p2, mask, &style, opa_scale);
+    lv_coord_t w       = lv_obj_get_width(chart);
+    lv_coord_t h       = lv_obj_get_height(chart);
+    lv_coord_t x_ofs   = chart->coords.x1;
+    lv_coord_t y_ofs   = chart->coords.y1;
+    lv_opa_t opa_scale = lv_obj_get_opa_scale(chart);
+    lv_opa_t opa = opa_scale == LV_OPA_COVER ? ext->series.opa : (uint16_t)((uint16_t)ext->series.opa * opa_scale) >> 8;
+    int32_t y_range    = ext->ymax - ext->ymin;
+    uint16_t pdiv      = ext->point_cnt - 1;
+
+    if(w <= 0) return; /*The points can't be mapped to the mask*/
+
+    /*Get the points whose span can be in the mask (start one earlier to connect to it)*/
+    int32_t i_start = ((int32_t)(mask->x1 - x_ofs - ext->series.width) * pdiv) / w - 1;
+    int32_t i_end   = ((int32_t)(mask->x2 - x_ofs) * pdiv) / w + 1;
+    if(i_start < 0) i_start = 0;
+    if(i_end > pdiv) i_end = pdiv;
+
+    lv_coord_t start_point = ext->update_mode == LV_CHART_UPDATE_MODE_SHIFT ? ser->start_point : 0;
+    lv_area_t span;
+    lv_area_t prev_span;
+    bool prev_valid = false;
+    int32_t i;
+    for(i = i_start; i <= i_end; i++) {
+        uint16_t p_act = (start_point + i) % ext->point_cnt;
+        if(ser->points[p_act] == LV_CHART_POINT_DEF) {
+            prev_valid = false;
+            continue;
+        }
 
-            p_prev = p_act;
+        span.x1 = (int32_t)((int32_t)w * i) / pdiv + x_ofs;
+        span.x2 = (int32_t)((int32_t)w * (i + 1)) / pdiv + x_ofs - 1;
+        if(span.x2 < span.x1 + ext->series.width - 1) span.x2 = span.x1 + ext->series.width - 1;
+        span.y1 = h - ((int32_t)(ser->points[p_act] - ext->ymin) * h) / y_range + y_ofs;
+        span.y2 = h - ((int32_t)(ser->points_min[p_act] - ext->ymin) * h) / y_range + y_ofs;
+
+        /*Extend the span to reach the previous one to get a continuous envelope*/
+        lv_area_t draw_span = span;
+        if(prev_valid) {
+            if(prev_span.y2 < draw_span.y1) draw_span.y1 = prev_span.y2;
+            if(prev_span.y1 > draw_span.y2) draw_span.y2 = prev_span.y1;
         }
+
+        lv_draw_fill(&draw_span, mask, ser->color, opa);
+
+        prev_span  = span;
+        prev_valid = true;
     }
 }
 
@@ -1507,6 +1704,80 @@ static void lv_chart_inv_lines(lv_obj_t * chart, uint16_t i)
     }
 }
 
+/**
+ * Invalidate the area of a range of points (including the line segments connecting them)
+ * @param chart pointer to chart object
+ * @param first index of the first updated point
+ * @param last index of the last updated point
+ */
+static void lv_chart_inv_point_range(lv_obj_t * chart, uint16_t first, uint16_t last)
+{
+    lv_chart_ext_t * ext = lv_obj_get_ext_attr(chart);
+
+    lv_coord_t w     = lv_obj_get_width(chart);
+    lv_coord_t x_ofs = chart->coords.x1;
+    uint16_t pdiv    = ext->point_cnt > 1 ? ext->point_cnt - 1 : 1;
+
+    if(first > 0) first--;
+    if(last < pdiv) last++;
+
+    lv_area_t coords;
+    lv_obj_get_coords(chart, &coords);
+    coords.x1 = ((int32_t)((int32_t)w * first) / pdiv) + x_ofs - ext->series.width;
+    coords.x2 = ((int32_t)((int32_t)w * last) / pdiv) + x_ofs + ext->series.width;
+    lv_obj_invalidate_area(chart, &coords);
+}
+
+/**
+ * Reallocate a point array to a new point count and make it start from the first point
+ * @param points the current point array
+ * @param start_point index of the first (oldest) point in `points`
+ * @param point_cnt_old current number of points in `points`
+ * @param point_cnt new number of points
+ * @return the new point array or NULL on error (`points` is freed if a new array is allocated)
+ */
+static lv_coord_t * lv_chart_realloc_points(lv_coord_t * points, uint16_t start_point, uint16_t point_cnt_old,
+                                            uint16_t point_cnt)
+{
+    uint16_t i;
+    lv_coord_t def = LV_CHART_POINT_DEF;
+
+    if(start_point != 0) {
+        lv_coord_t * new_points = lv_mem_alloc(sizeof(lv_coord_t) * point_cnt);
+        LV_ASSERT_MEM(new_points);
+        if(new_points == NULL) return NULL;
+
+        if(point_cnt >= point_cnt_old) {
+            for(i = 0; i < point_cnt_old; i++) {
+                new_points[i] = points[(i + start_point) % point_cnt_old]; /*Copy old contents to new array*/
+            }
+            for(i = point_cnt_old; i < point_cnt; i++) {
+                new_points[i] = def; /*Fill up the rest with default value*/
+            }
+        } else {
+            for(i = 0; i < point_cnt; i++) {
+                new_points[i] = points[(i + start_point) % point_cnt_old]; /*Copy old contents to new array*/
+            }
+        }
+
+        /*Switch over pointer from old to new*/
+        lv_mem_free(points);
+        return new_points;
+    }
+
+    points = lv_mem_realloc(points, sizeof(lv_coord_t) * point_cnt);
+    LV_ASSERT_MEM(points);
+    if(points == NULL) return NULL;
+    /*Initialize the new points*/
+    if(point_cnt > point_cnt_old) {
+        for(i = point_cnt_old - 1; i < point_cnt; i++) {
+            points[i] = def;
+        }
+    }
+
+    return points;
+}
+
 /**
  * invalid area of the new point data lines on a chart
  * @param chart pointer to chart object
@@ -1525,7 +1796,7 @@ static void lv_chart_inv_points(lv_obj_t * chart, uint16_t i)
     cir_a.x2 = cir_a.x1 + ext->series.width;
     cir_a.x1 -= ext->series.width;
 
-    lv_inv_area(lv_obj_get_disp(chart), &cir_a);
+    lv_obj_invalidate_area(chart, &cir_a);
 }
 
 /**
@@ -1551,7 +1822,7 @@ static void lv_chart_inv_cols(lv_obj_t * chart, uint16_t i)
     col_a.x1 = x_act;
     col_a.x2 = col_a.x1 + col_w;
 
-    lv_inv_area(lv_obj_get_disp(chart), &col_a);
+    lv_obj_invalidate_area(chart, &col_a);
 }
 
 #endif
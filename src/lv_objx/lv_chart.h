@@ -62,8 +62,12 @@ typedef uint8_t lv_chart_update_mode_t;
 typedef struct
 {
     lv_coord_t * points;
+    lv_coord_t * points_min; /*Minimum of the decimated samples per point (NULL if decimation is disabled)*/
     lv_color_t color;
     uint16_t start_point;
+    uint16_t acc_cnt;        /*Number of samples accumulated in the not yet stored point*/
+    lv_coord_t acc_min;      /*Minimum of the accumulated samples*/
+    lv_coord_t acc_max;      /*Maximum of the accumulated samples*/
 } lv_chart_series_t;
 
 /** Data of axis */
@@ -99,6 +103,7 @@ typedef struct
     lv_chart_axis_cfg_t x_axis;
     lv_chart_axis_cfg_t secondary_y_axis;
     uint16_t margin;
+    uint16_t decimation;  /*Number of samples stored in one point by `lv_chart_set_next_array` (0: disabled)*/
     uint8_t update_mode : 1;
     struct
     {
@@ -225,6 +230,27 @@ void lv_chart_set_points(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y
  */
 void lv_chart_set_next(lv_obj_t * chart, lv_chart_series_t * ser, lv_coord_t y);
 
+/**
+ * Add a batch of new samples to a data series.
+ * The samples are stored the same way as with `lv_chart_set_next` but the chart is invalidated only once.
+ * If decimation is enabled every `decimation` samples are reduced to a min/max pair stored in one point.
+ * In `LV_CHART_UPDATE_MODE_CIRCULAR` only the area of the updated points is invalidated.
+ * @param chart pointer to chart object
+ * @param ser pointer to a data series on 'chart'
+ * @param y_array array of new samples
+ * @param cnt number of elements in `y_array`
+ */
+void lv_chart_set_next_array(lv_obj_t * chart, lv_chart_series_t * ser, const lv_coord_t y_array[], uint32_t cnt);
+
+/**
+ * Set the number of samples decimated into one point by `lv_chart_set_next_array`.
+ * If enabled the minimum and maximum of the samples are stored for every point
+ * and the line charts draw the min/max envelope of the series.
+ * @param chart pointer to a chart object
+ * @param decimation number of samples per point (0: disable decimation)
+ */
+void lv_chart_set_decimation(lv_obj_t * chart, uint16_t decimation);
+
 /**
  * Set update mode of the chart object.
  * @param chart pointer to a chart object
@@ -332,6 +358,13 @@ lv_chart_type_t lv_chart_get_type(const lv_obj_t * chart);
  */
 uint16_t lv_chart_get_point_cnt(const lv_obj_t * chart);
 
+/**
+ * Get the number of samples decimated into one point
+ * @param chart pointer to chart object
+ * @return number of samples per point (0: decimation is disabled)
+ */
+uint16_t lv_chart_get_decimation(const lv_obj_t * chart);
+
 /**
  * Get the opacity of the data series
  * @param chart pointer to chart object
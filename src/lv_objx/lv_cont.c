@@ -15,6 +15,7 @@
 #include <string.h>
 
 #include "../lv_core/lv_debug.h"
+#include "../lv_core/lv_indev.h"
 #include "../lv_draw/lv_draw.h"
 #include "../lv_draw/lv_draw_basic.h"
 #include "../lv_themes/lv_theme.h"
@@ -22,6 +23,11 @@
 #include "../lv_misc/lv_color.h"
 #include "../lv_misc/lv_math.h"
 #include "../lv_misc/lv_bidi.h"
+#include "../lv_misc/lv_gc.h"
+
+#if defined(LV_GC_INCLUDE)
+#include LV_GC_INCLUDE
+#endif /* LV_ENABLE_GC */
 
 /*********************
  *      DEFINES
@@ -36,6 +42,10 @@
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t lv_cont_signal(lv_obj_t * cont, lv_signal_t sign, void * param);
+static void lv_cont_refr_layout_fit(lv_obj_t * cont);
+#if LV_CONT_DEFER_LAYOUT
+static void lv_cont_layout_task(lv_task_t * task);
+#endif
 static void lv_cont_refr_layout(lv_obj_t * cont);
 static void lv_cont_layout_col(lv_obj_t * cont);
 static void lv_cont_layout_row(lv_obj_t * cont);
@@ -80,11 +90,12 @@ lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy)
     if(ext == NULL) return NULL;
 
     LV_ASSERT_MEM(ext);
-    ext->fit_left   = LV_FIT_NONE;
-    ext->fit_right  = LV_FIT_NONE;
-    ext->fit_top    = LV_FIT_NONE;
-    ext->fit_bottom = LV_FIT_NONE;
-    ext->layout     = LV_LAYOUT_OFF;
+    ext->fit_left     = LV_FIT_NONE;
+    ext->fit_right    = LV_FIT_NONE;
+    ext->fit_top      = LV_FIT_NONE;
+    ext->fit_bottom   = LV_FIT_NONE;
+    ext->layout       = LV_LAYOUT_OFF;
+    ext->layout_dirty = 0;
 
     lv_obj_set_signal_cb(new_cont, lv_cont_signal);
 
@@ -118,6 +129,31 @@ lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy)
     return new_cont;
 }
 
+/**
+ * Refresh the layout and fit of the containers which have changed since the last refresh.
+ * Has effect only if `LV_CONT_DEFER_LAYOUT` is enabled. Else the containers are always up-to-date.
+ * It's called automatically before the screen refresh but call it to get the new coordinates immediately.
+ */
+void lv_cont_layout_flush(void)
+{
+#if LV_CONT_DEFER_LAYOUT
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_cont_layout_ll);
+
+    /*Refreshing a container can mark its parent or children, so process until the list is empty*/
+    lv_obj_t ** node;
+    while((node = lv_ll_get_head(ll)) != NULL) {
+        lv_obj_t * cont = *node;
+        lv_ll_rem(ll, node);
+        lv_mem_free(node);
+
+        lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+        ext->layout_dirty   = 0;
+        lv_cont_refr_layout(cont);
+        lv_cont_refr_autofit(cont);
+    }
+#endif
+}
+
 /*=====================
  * Setter functions
  *====================*/
@@ -258,25 +294,94 @@ static lv_res_t lv_cont_signal(lv_obj_t * cont, lv_signal_t sign, void * param)
     if(sign == LV_SIGNAL_GET_TYPE) return lv_obj_handle_get_type_signal(param, LV_OBJX_NAME);
 
     if(sign == LV_SIGNAL_STYLE_CHG) { /*Recalculate the padding if the style changed*/
-        lv_cont_refr_layout(cont);
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr_layout_fit(cont);
     } else if(sign == LV_SIGNAL_CHILD_CHG) {
-        lv_cont_refr_layout(cont);
-        lv_cont_refr_autofit(cont);
+        lv_cont_refr_layout_fit(cont);
     } else if(sign == LV_SIGNAL_CORD_CHG) {
         if(lv_obj_get_width(cont) != lv_area_get_width(param) || lv_obj_get_height(cont) != lv_area_get_height(param)) {
-            lv_cont_refr_layout(cont);
-            lv_cont_refr_autofit(cont);
+            lv_cont_refr_layout_fit(cont);
         }
     } else if(sign == LV_SIGNAL_PARENT_SIZE_CHG) {
         /*FLOOD and FILL fit needs to be refreshed if the parent size has changed*/
+#if LV_CONT_DEFER_LAYOUT
+        lv_cont_refr_layout_fit(cont);
+#else
         lv_cont_refr_autofit(cont);
-
+#endif
+    }
+#if LV_CONT_DEFER_LAYOUT
+    else if(sign == LV_SIGNAL_CLEANUP) {
+        /*Don't refresh the deleted container later*/
+        lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+        if(ext->layout_dirty) {
+            lv_ll_t * ll = &LV_GC_ROOT(_lv_cont_layout_ll);
+            lv_obj_t ** node;
+            LV_LL_READ(*ll, node)
+            {
+                if(*node == cont) {
+                    lv_ll_rem(ll, node);
+                    lv_mem_free(node);
+                    break;
+                }
+            }
+            ext->layout_dirty = 0;
+        }
     }
+#endif
 
     return res;
 }
 
+/**
+ * Refresh the layout and the fit of a container.
+ * With `LV_CONT_DEFER_LAYOUT` only mark it to be refreshed before the next screen refresh.
+ * @param cont pointer to a container object
+ */
+static void lv_cont_refr_layout_fit(lv_obj_t * cont)
+{
+#if LV_CONT_DEFER_LAYOUT
+    lv_cont_ext_t * ext = lv_obj_get_ext_attr(cont);
+    if(ext->layout_dirty) return;
+
+    lv_ll_t * ll = &LV_GC_ROOT(_lv_cont_layout_ll);
+    if(ll->n_size == 0) lv_ll_init(ll, sizeof(lv_obj_t *));
+
+    lv_obj_t ** node = lv_ll_ins_tail(ll);
+    LV_ASSERT_MEM(node);
+    if(node == NULL) {
+        /*Refresh immediately if it can't be postponed*/
+        lv_cont_refr_layout(cont);
+        lv_cont_refr_autofit(cont);
+        return;
+    }
+
+    *node             = cont;
+    ext->layout_dirty = 1;
+
+    /*Flush in every `lv_task_handler()` before the refresher task (`LV_TASK_PRIO_MID`)*/
+    if(LV_GC_ROOT(_lv_cont_layout_task) == NULL) {
+        LV_GC_ROOT(_lv_cont_layout_task) = lv_task_create(lv_cont_layout_task, 0, LV_TASK_PRIO_HIGH, NULL);
+        LV_ASSERT_MEM(LV_GC_ROOT(_lv_cont_layout_task));
+    }
+#else
+    lv_cont_refr_layout(cont);
+    lv_cont_refr_autofit(cont);
+#endif
+}
+
+#if LV_CONT_DEFER_LAYOUT
+/**
+ * Refresh the marked containers periodically
+ * @param task pointer to the task itself
+ */
+static void lv_cont_layout_task(lv_task_t * task)
+{
+    (void)task; /*Unused*/
+
+    lv_cont_layout_flush();
+}
+#endif
+
 /**
  * Refresh the layout of a container
  * @param cont pointer to an object which layout should be refreshed
@@ -341,7 +446,7 @@ static void lv_cont_layout_col(lv_obj_t * cont)
     lv_obj_set_protect(cont, LV_PROTECT_CHILD_CHG);
     /* Align the children */
     lv_coord_t last_cord = style->body.padding.top;
-    LV_LL_READ_BACK(cont->child_ll, child)
+    LV_OBJ_CHILD_READ_BACK(cont, child)
     {
         if(lv_obj_get_hidden(child) != false || lv_obj_is_protected(child, LV_PROTECT_POS) != false) continue;
 
@@ -394,7 +499,7 @@ static void lv_cont_layout_row(lv_obj_t * cont)
     if(base_dir == LV_BIDI_DIR_RTL) last_cord = style->body.padding.right;
     else last_cord = style->body.padding.left;
 
-    LV_LL_READ_BACK(cont->child_ll, child)
+    LV_OBJ_CHILD_READ_BACK(cont, child)
     {
         if(lv_obj_get_hidden(child) != false || lv_obj_is_protected(child, LV_PROTECT_POS) != false) continue;
 
@@ -420,7 +525,7 @@ static void lv_cont_layout_center(lv_obj_t * cont)
     uint32_t obj_num         = 0;
     lv_coord_t h_tot         = 0;
 
-    LV_LL_READ(cont->child_ll, child)
+    LV_OBJ_CHILD_READ(cont, child)
     {
         if(lv_obj_get_hidden(child) != false || lv_obj_is_protected(child, LV_PROTECT_POS) != false) continue;
         h_tot += lv_obj_get_height(child) + style->body.padding.inner;
@@ -437,7 +542,7 @@ static void lv_cont_layout_center(lv_obj_t * cont)
 
     /* Align the children */
     lv_coord_t last_cord = -(h_tot / 2);
-    LV_LL_READ_BACK(cont->child_ll, child)
+    LV_OBJ_CHILD_READ_BACK(cont, child)
     {
         if(lv_obj_get_hidden(child) != false || lv_obj_is_protected(child, LV_PROTECT_POS) != false) continue;
 
@@ -464,8 +569,8 @@ static void lv_cont_layout_pretty(lv_obj_t * cont)
     /* Disable child change action because the children will be moved a lot
      * an unnecessary child change signals could be sent*/
 
-    child_rs = lv_ll_get_tail(&cont->child_ll); /*Set the row starter child*/
-    if(child_rs == NULL) return;                /*Return if no child*/
+    child_rs = LV_OBJ_CHILD_BOTTOM(cont); /*Set the row starter child*/
+    if(child_rs == NULL) return;          /*Return if no child*/
 
     lv_obj_set_protect(cont, LV_PROTECT_CHILD_CHG);
 
@@ -484,7 +589,7 @@ static void lv_cont_layout_pretty(lv_obj_t * cont)
                     /*Step back one child because the last already not fit, so the previous is the
                      * closer*/
                     if(child_rc != NULL && obj_num != 0) {
-                        child_rc = lv_ll_get_next(&cont->child_ll, child_rc);
+                        child_rc = LV_OBJ_CHILD_BELOW(cont, child_rc);
                     }
                     break;
                 }
@@ -494,7 +599,7 @@ static void lv_cont_layout_pretty(lv_obj_t * cont)
                 if(lv_obj_is_protected(child_rc, LV_PROTECT_FOLLOW))
                     break; /*If can not be followed by an other object then break here*/
             }
-            child_rc = lv_ll_get_prev(&cont->child_ll, child_rc); /*Load the next object*/
+            child_rc = LV_OBJ_CHILD_ABOVE(cont, child_rc); /*Load the next object*/
             if(obj_num == 0)
                 child_rs = child_rc; /*If the first object was hidden (or too long) then set the
                                         next as first */
@@ -514,7 +619,7 @@ static void lv_cont_layout_pretty(lv_obj_t * cont)
         /*If there are two object in the row then align them proportionally*/
         else if(obj_num == 2) {
             lv_obj_t * obj1 = child_rs;
-            lv_obj_t * obj2 = lv_ll_get_prev(&cont->child_ll, child_rs);
+            lv_obj_t * obj2 = LV_OBJ_CHILD_ABOVE(cont, child_rs);
             w_row           = lv_obj_get_width(obj1) + lv_obj_get_width(obj2);
             lv_coord_t pad  = (w_obj - w_row) / 3;
             lv_obj_align(obj1, cont, LV_ALIGN_IN_TOP_LEFT, pad, act_y + (h_row - lv_obj_get_height(obj1)) / 2);
@@ -533,13 +638,13 @@ static void lv_cont_layout_pretty(lv_obj_t * cont)
                     act_x += lv_obj_get_width(child_tmp) + new_opad;
                 }
                 if(child_tmp == child_rc) break;
-                child_tmp = lv_ll_get_prev(&cont->child_ll, child_tmp);
+                child_tmp = LV_OBJ_CHILD_ABOVE(cont, child_tmp);
             }
         }
 
         if(child_rc == NULL) break;
-        act_y += style->body.padding.inner + h_row;           /*y increment*/
-        child_rs = lv_ll_get_prev(&cont->child_ll, child_rc); /*Go to the next object*/
+        act_y += style->body.padding.inner + h_row;    /*y increment*/
+        child_rs = LV_OBJ_CHILD_ABOVE(cont, child_rc); /*Go to the next object*/
         child_rc = child_rs;
     }
     lv_obj_clear_protect(cont, LV_PROTECT_CHILD_CHG);
@@ -574,7 +679,7 @@ static void lv_cont_layout_grid(lv_obj_t * cont)
     lv_coord_t act_x = style->body.padding.left;
     lv_coord_t act_y = style->body.padding.top;
     uint16_t obj_cnt = 0;
-    LV_LL_READ_BACK(cont->child_ll, child)
+    LV_OBJ_CHILD_READ_BACK(cont, child)
     {
         if(lv_obj_get_hidden(child) != false || lv_obj_is_protected(child, LV_PROTECT_POS) != false) continue;
 
@@ -627,7 +732,7 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
     lv_obj_get_coords(cont, &ori);
     lv_obj_get_coords(cont, &tight_area);
 
-    bool has_children = lv_ll_is_empty(&cont->child_ll) ? false : true;
+    bool has_children = LV_OBJ_CHILD_TOP(cont) != NULL ? true : false;
 
     if(has_children) {
         tight_area.x1 = LV_COORD_MAX;
@@ -635,7 +740,7 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
         tight_area.x2 = LV_COORD_MIN;
         tight_area.y2 = LV_COORD_MIN;
 
-        LV_LL_READ(cont->child_ll, child_i)
+        LV_OBJ_CHILD_READ(cont, child_i)
         {
             if(lv_obj_get_hidden(child_i) != false) continue;
             tight_area.x1 = LV_MATH_MIN(tight_area.x1, child_i->coords.x1);
@@ -687,6 +792,7 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
 
         lv_obj_invalidate(cont);
         lv_area_copy(&cont->coords, &new_area);
+        lv_indev_update_hit_index(cont);
         lv_obj_invalidate(cont);
 
         /*Notify the object about its new coordinates*/
@@ -700,7 +806,7 @@ static void lv_cont_refr_autofit(lv_obj_t * cont)
         }
 
         /*Tell the children the parent's size has changed*/
-        LV_LL_READ(cont->child_ll, child_i)
+        LV_OBJ_CHILD_READ(cont, child_i)
         {
             child_i->signal_cb(child_i, LV_SIGNAL_PARENT_SIZE_CHG, NULL);
         }
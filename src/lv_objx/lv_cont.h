@@ -69,6 +69,7 @@ typedef struct
     uint8_t fit_right : 2;  /*A fit type from `lv_fit_t` enum */
     uint8_t fit_top : 2;    /*A fit type from `lv_fit_t` enum */
     uint8_t fit_bottom : 2; /*A fit type from `lv_fit_t` enum */
+    uint8_t layout_dirty : 1; /*1: the layout and fit will be refreshed later (see `LV_CONT_DEFER_LAYOUT`)*/
 } lv_cont_ext_t;
 
 /*Styles*/
@@ -89,6 +90,13 @@ typedef uint8_t lv_cont_style_t;
  */
 lv_obj_t * lv_cont_create(lv_obj_t * par, const lv_obj_t * copy);
 
+/**
+ * Refresh the layout and fit of the containers which have changed since the last refresh.
+ * Has effect only if `LV_CONT_DEFER_LAYOUT` is enabled. Else the containers are always up-to-date.
+ * It's called automatically before the screen refresh but call it to get the new coordinates immediately.
+ */
+void lv_cont_layout_flush(void);
+
 /*=====================
  * Setter functions
  *====================*/
@@ -887,6 +887,8 @@ static void lv_ddlist_refr_size(lv_obj_t * ddlist, lv_anim_enable_t anim)
     const lv_style_t * style = lv_obj_get_style(ddlist);
     lv_coord_t new_height;
 
+    lv_cont_layout_flush(); /*The height of the scrollable is used*/
+
     /*Open the list*/
     if(ext->opened) {
         if(ext->fix_height == 0) {
@@ -921,6 +923,7 @@ static void lv_ddlist_refr_size(lv_obj_t * ddlist, lv_anim_enable_t anim)
         /*Run the animation only if the the size will be different*/
         if(lv_obj_get_height(ddlist) != new_height) {
             lv_anim_t a;
+            lv_anim_init(&a);
             a.var            = ddlist;
             a.start          = lv_obj_get_height(ddlist);
             a.end            = new_height;
@@ -992,6 +995,8 @@ static void lv_ddlist_pos_current_option(lv_obj_t * ddlist)
     const lv_style_t * label_style = lv_obj_get_style(ext->label);
     lv_obj_t * scrl                = lv_page_get_scrl(ddlist);
 
+    lv_cont_layout_flush(); /*The position of the label on the scrollable is used*/
+
     lv_coord_t h = lv_obj_get_height(ddlist);
     lv_coord_t line_y1 =
         ext->sel_opt_id * (font_h + label_style->text.line_space) + ext->label->coords.y1 - scrl->coords.y1;
@@ -1015,6 +1020,7 @@ static void lv_ddlist_refr_width(lv_obj_t * ddlist)
 
     /*Set the TIGHT fit horizontally the set the width to the content*/
     lv_page_set_scrl_fit2(ddlist, LV_FIT_TIGHT, lv_page_get_scrl_fit_bottom(ddlist));
+    lv_cont_layout_flush();
 
     /*Revert FILL fit to fill the parent with the options area. It allows to RIGHT/CENTER align the text*/
     lv_page_set_scrl_fit2(ddlist, LV_FIT_FILL, lv_page_get_scrl_fit_bottom(ddlist));
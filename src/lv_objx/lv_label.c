@@ -1192,6 +1192,7 @@ static void lv_label_refr_text(lv_obj_t * label)
     else if(ext->long_mode == LV_LABEL_LONG_SROLL) {
 #if LV_USE_ANIMATION
         lv_anim_t anim;
+        lv_anim_init(&anim);
         anim.var      = label;
         anim.repeat   = 1;
         anim.playback = 1;
@@ -1237,6 +1238,7 @@ static void lv_label_refr_text(lv_obj_t * label)
         lv_label_align_t align = lv_label_get_align(label);
 
         lv_anim_t anim;
+        lv_anim_init(&anim);
         anim.var      = label;
         anim.repeat   = 1;
         anim.playback = 0;
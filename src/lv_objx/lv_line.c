@@ -20,6 +20,7 @@
  *      DEFINES
  *********************/
 #define LV_OBJX_NAME "lv_line"
+#define LV_LINE_CHUNK_SIZE 32 /*Number of points drawn at once as a polyline*/
 
 /**********************
  *      TYPEDEFS
@@ -231,9 +232,10 @@ static bool lv_line_design(lv_obj_t * line, const lv_area_t * mask, lv_design_mo
         lv_obj_get_coords(line, &area);
         lv_coord_t x_ofs = area.x1;
         lv_coord_t y_ofs = area.y1;
-        lv_point_t p1;
-        lv_point_t p2;
-        lv_coord_t h = lv_obj_get_height(line);
+        lv_point_t points[LV_LINE_CHUNK_SIZE];
+        uint16_t point_num = 0;
+        bool x_sorted      = true;
+        lv_coord_t h       = lv_obj_get_height(line);
         uint16_t i;
 
         lv_style_t circle_style_tmp; /*If rounded...*/
@@ -246,38 +248,37 @@ static bool lv_line_design(lv_obj_t * line, const lv_area_t * mask, lv_design_mo
         }
         lv_area_t circle_area;
 
-        /*Read all points and draw the lines*/
-        for(i = 0; i < ext->point_num - 1; i++) {
-
-            p1.x = ext->point_array[i].x + x_ofs;
-            p2.x = ext->point_array[i + 1].x + x_ofs;
+        /*Read all points and draw them in chunks as polylines*/
+        for(i = 0; i < ext->point_num; i++) {
+            lv_point_t * p = &points[point_num];
+            p->x = ext->point_array[i].x + x_ofs;
 
             if(ext->y_inv == 0) {
-                p1.y = ext->point_array[i].y + y_ofs;
-                p2.y = ext->point_array[i + 1].y + y_ofs;
+                p->y = ext->point_array[i].y + y_ofs;
             } else {
-                p1.y = h - ext->point_array[i].y + y_ofs;
-                p2.y = h - ext->point_array[i + 1].y + y_ofs;
+                p->y = h - ext->point_array[i].y + y_ofs;
             }
-            lv_draw_line(&p1, &p2, mask, style, opa_scale);
+
+            if(point_num > 0 && p->x < points[point_num - 1].x) x_sorted = false;
+            point_num++;
 
             /*Draw circle on the joints if enabled*/
             if(style->line.rounded) {
-                circle_area.x1 = p1.x - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-                circle_area.y1 = p1.y - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-                circle_area.x2 = p1.x + ((style->line.width - 1) >> 1);
-                circle_area.y2 = p1.y + ((style->line.width - 1) >> 1);
+                circle_area.x1 = p->x - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
+                circle_area.y1 = p->y - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
+                circle_area.x2 = p->x + ((style->line.width - 1) >> 1);
+                circle_area.y2 = p->y + ((style->line.width - 1) >> 1);
                 lv_draw_rect(&circle_area, mask, &circle_style_tmp, opa_scale);
             }
-        }
 
-        /*Draw circle on the last point too if enabled*/
-        if(style->line.rounded) {
-            circle_area.x1 = p2.x - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-            circle_area.y1 = p2.y - ((style->line.width - 1) >> 1) - ((style->line.width - 1) & 0x1);
-            circle_area.x2 = p2.x + ((style->line.width - 1) >> 1);
-            circle_area.y2 = p2.y + ((style->line.width - 1) >> 1);
-            lv_draw_rect(&circle_area, mask, &circle_style_tmp, opa_scale);
+            if(point_num == LV_LINE_CHUNK_SIZE || i == ext->point_num - 1) {
+                lv_draw_polyline(points, point_num, x_sorted, mask, style, opa_scale);
+
+                /*Continue the next chunk from the last point*/
+                points[0] = points[point_num - 1];
+                point_num = 1;
+                x_sorted  = true;
+            }
         }
     }
     return true;
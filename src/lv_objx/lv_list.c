@@ -696,6 +696,7 @@ void lv_list_up(const lv_obj_t * list)
                 } else {
 #if LV_USE_ANIMATION
                     lv_anim_t a;
+                    lv_anim_init(&a);
                     a.var            = scrl;
                     a.start          = lv_obj_get_y(scrl);
                     a.end            = new_y;
@@ -740,6 +741,7 @@ void lv_list_down(const lv_obj_t * list)
             } else {
 #if LV_USE_ANIMATION
                 lv_anim_t a;
+                lv_anim_init(&a);
                 a.var            = scrl;
                 a.start          = lv_obj_get_y(scrl);
                 a.end            = new_y;
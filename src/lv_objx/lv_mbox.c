@@ -219,6 +219,7 @@ void lv_mbox_start_auto_close(lv_obj_t * mbox, uint16_t delay)
     if(lv_mbox_get_anim_time(mbox) != 0) {
         /*Add shrinking animations*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = mbox;
         a.start          = lv_obj_get_height(mbox);
         a.end            = 0;
@@ -243,6 +244,7 @@ void lv_mbox_start_auto_close(lv_obj_t * mbox, uint16_t delay)
     } else {
         /*Create an animation to delete the mbox `delay` ms later*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = mbox;
         a.start          = 0;
         a.end            = 1;
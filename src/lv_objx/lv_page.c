@@ -44,6 +44,10 @@
  *  STATIC PROTOTYPES
  **********************/
 static void lv_page_sb_refresh(lv_obj_t * page);
+#if LV_USE_SCROLL_BLIT
+static void lv_page_scrl_inv(lv_obj_t * page, lv_coord_t x_ofs, lv_coord_t y_ofs);
+static bool lv_page_scrl_covers(const lv_obj_t * scrl, const lv_area_t * area_p);
+#endif
 static bool lv_page_design(lv_obj_t * page, const lv_area_t * mask, lv_design_mode_t mode);
 static bool lv_scrl_design(lv_obj_t * scrl, const lv_area_t * mask, lv_design_mode_t mode);
 static lv_res_t lv_page_signal(lv_obj_t * page, lv_signal_t sign, void * param);
@@ -165,6 +169,11 @@ lv_obj_t * lv_page_create(lv_obj_t * par, const lv_obj_t * copy)
         lv_obj_refresh_style(new_page);
     }
 
+#if LV_USE_SCROLL_BLIT
+    /*The scrollable is invalidated in `lv_page_scrollable_signal` to move the rendered pixels if possible*/
+    ext->scrl->scroll_blit = 1;
+#endif
+
     lv_page_sb_refresh(new_page);
 
     LV_LOG_INFO("page created");
@@ -491,6 +500,9 @@ void lv_page_focus(lv_obj_t * page, const lv_obj_t * obj, lv_anim_enable_t anim_
     lv_anim_del(ext->scrl, (lv_anim_exec_xcb_t)lv_obj_set_y);
 #endif
 
+    /*The final coordinates of `obj` and the scrollable are required*/
+    lv_cont_layout_flush();
+
     const lv_style_t * style      = lv_page_get_style(page, LV_PAGE_STYLE_BG);
     const lv_style_t * style_scrl = lv_page_get_style(page, LV_PAGE_STYLE_SCRL);
 
@@ -546,6 +558,7 @@ void lv_page_focus(lv_obj_t * page, const lv_obj_t * obj, lv_anim_enable_t anim_
     } else {
 #if LV_USE_ANIMATION
         lv_anim_t a;
+        lv_anim_init(&a);
         a.act_time = 0;
         a.start    = lv_obj_get_y(ext->scrl);
         a.end      = scrlable_y;
@@ -577,6 +590,7 @@ void lv_page_scroll_hor(lv_obj_t * page, lv_coord_t dist)
 
 #if LV_USE_ANIMATION
     lv_anim_t a;
+    lv_anim_init(&a);
     a.var            = scrl;
     a.start          = lv_obj_get_x(scrl);
     a.end            = a.start + dist;
@@ -606,6 +620,7 @@ void lv_page_scroll_ver(lv_obj_t * page, lv_coord_t dist)
 
 #if LV_USE_ANIMATION
     lv_anim_t a;
+    lv_anim_init(&a);
     a.var            = scrl;
     a.start          = lv_obj_get_y(scrl);
     a.end            = a.start + dist;
@@ -635,6 +650,7 @@ void lv_page_start_edge_flash(lv_obj_t * page)
     lv_page_ext_t * ext = lv_obj_get_ext_attr(page);
     if(ext->edge_flash.enabled) {
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = page;
         a.start          = 0;
         a.end            = LV_PAGE_END_FLASH_SIZE;
@@ -952,6 +968,14 @@ static lv_res_t lv_page_scrollable_signal(lv_obj_t * scrl, lv_signal_t sign, voi
         lv_coord_t vpad        = page_style->body.padding.top + page_style->body.padding.bottom;
         lv_obj_t * page_parent = lv_obj_get_parent(page);
 
+#if LV_USE_SCROLL_BLIT
+        /*Moved by `lv_obj_set_pos` which doesn't invalidate the scrollable*/
+        if((diff_x != 0 || diff_y != 0) && lv_area_get_width(ori_coords) == lv_obj_get_width(scrl) &&
+           lv_area_get_height(ori_coords) == lv_obj_get_height(scrl)) {
+            lv_page_scrl_inv(page, diff_x, diff_y);
+        }
+#endif
+
         lv_indev_t * indev = lv_indev_get_act();
         lv_point_t drag_vect;
         lv_indev_get_vect(indev, &drag_vect);
@@ -1241,6 +1265,134 @@ static void lv_page_sb_refresh(lv_obj_t * page)
     }
 }
 
+#if LV_USE_SCROLL_BLIT
+/**
+ * Invalidate a page after its scrollable has been moved.
+ * If possible the rendered content is moved and only the uncovered parts are redrawn.
+ * @param page pointer to a page object
+ * @param x_ofs the horizontal movement of the scrollable
+ * @param y_ofs the vertical movement of the scrollable
+ */
+static void lv_page_scrl_inv(lv_obj_t * page, lv_coord_t x_ofs, lv_coord_t y_ofs)
+{
+    lv_page_ext_t * ext      = lv_obj_get_ext_attr(page);
+    const lv_style_t * style = lv_obj_get_style(page);
+    lv_obj_t * scrl          = ext->scrl;
+    bool moved               = false;
+
+    /*Only the inner part of the page can be moved where the border and the rounded corners are not drawn*/
+    lv_coord_t w     = lv_obj_get_width(page);
+    lv_coord_t h     = lv_obj_get_height(page);
+    lv_coord_t inner = LV_MATH_MIN(style->body.radius, LV_MATH_MIN(w, h) / 2);
+    if(style->body.border.part != LV_BORDER_NONE && style->body.border.opa >= LV_OPA_MIN) {
+        inner = LV_MATH_MAX(inner, style->body.border.width);
+    }
+
+    lv_area_t area;
+    lv_area_copy(&area, &page->coords);
+    area.x1 += inner;
+    area.y1 += inner;
+    area.x2 -= inner;
+    area.y2 -= inner;
+
+    /*Derived types might draw something else on the page (e.g. the selected option)*/
+    bool en = page->design_cb == lv_page_design && area.x1 <= area.x2 && area.y1 <= area.y2;
+#if LV_USE_ANIMATION
+    if(ext->edge_flash.left_ip || ext->edge_flash.right_ip || ext->edge_flash.top_ip || ext->edge_flash.bottom_ip) {
+        en = false;
+    }
+#endif
+
+    if(en) {
+        /*Everything on the area has to move with the scrollable: either it covers the whole area
+         * on its original and new position or the background looks the same everywhere*/
+        lv_area_t ori_area; /*`area` relative to the scrollable's original position*/
+        ori_area.x1 = area.x1 + x_ofs;
+        ori_area.y1 = area.y1 + y_ofs;
+        ori_area.x2 = area.x2 + x_ofs;
+        ori_area.y2 = area.y2 + y_ofs;
+        if(lv_page_scrl_covers(scrl, &area) && lv_page_scrl_covers(scrl, &ori_area)) {
+            en = true;
+        } else if(lv_obj_get_opa_scale(page) == LV_OPA_COVER && style->body.main_color.full == style->body.grad_color.full &&
+                  page->design_cb(page, &area, LV_DESIGN_COVER_CHK)) {
+            en = true;
+        } else {
+            en = false;
+        }
+    }
+
+    if(en) {
+        /*The scrollbars are moved with the content so redraw them on the new position too*/
+        lv_area_t sb_area;
+        if(ext->sb.hor_draw && (ext->sb.mode & LV_SB_MODE_HIDE) == 0) {
+            lv_area_copy(&sb_area, &ext->sb.hor_area);
+            lv_area_set_pos(&sb_area, sb_area.x1 + page->coords.x1, sb_area.y1 + page->coords.y1);
+            lv_obj_invalidate_area(page, &sb_area);
+        }
+        if(ext->sb.ver_draw && (ext->sb.mode & LV_SB_MODE_HIDE) == 0) {
+            lv_area_copy(&sb_area, &ext->sb.ver_area);
+            lv_area_set_pos(&sb_area, sb_area.x1 + page->coords.x1, sb_area.y1 + page->coords.y1);
+            lv_obj_invalidate_area(page, &sb_area);
+        }
+
+        moved = lv_refr_scroll_area(scrl, &area, x_ofs, y_ofs);
+    }
+
+    if(moved == false) {
+        lv_obj_invalidate(page);
+        return;
+    }
+
+    /*Redraw the not moved edges*/
+    if(inner > 0) {
+        lv_area_t edge;
+        lv_area_copy(&edge, &page->coords);
+        edge.y2 = area.y1 - 1;
+        lv_obj_invalidate_area(page, &edge);
+
+        lv_area_copy(&edge, &page->coords);
+        edge.y1 = area.y2 + 1;
+        lv_obj_invalidate_area(page, &edge);
+
+        lv_area_copy(&edge, &area);
+        edge.x1 = page->coords.x1;
+        edge.x2 = area.x1 - 1;
+        lv_obj_invalidate_area(page, &edge);
+
+        lv_area_copy(&edge, &area);
+        edge.x1 = area.x2 + 1;
+        edge.x2 = page->coords.x2;
+        lv_obj_invalidate_area(page, &edge);
+    }
+}
+
+/**
+ * Check whether the scrollable is opaque on an area.
+ * Unlike `LV_DESIGN_COVER_CHK` it's enough to avoid the rounded corners in one direction.
+ * @param scrl pointer to the scrollable object of a page
+ * @param area_p the area to check
+ * @return true: `area_p` is fully covered by the scrollable
+ */
+static bool lv_page_scrl_covers(const lv_obj_t * scrl, const lv_area_t * area_p)
+{
+    const lv_style_t * style = lv_obj_get_style(scrl);
+    if(style->body.opa < LV_OPA_MAX || lv_obj_get_opa_scale(scrl) != LV_OPA_COVER) return false;
+
+    lv_coord_t r = LV_MATH_MIN(style->body.radius, LV_MATH_MIN(lv_obj_get_width(scrl), lv_obj_get_height(scrl)) / 2);
+
+    lv_area_t band;
+    lv_obj_get_coords(scrl, &band);
+    band.y1 += r;
+    band.y2 -= r;
+    if(lv_area_is_in(area_p, &band)) return true;
+
+    lv_obj_get_coords(scrl, &band);
+    band.x1 += r;
+    band.x2 -= r;
+    return lv_area_is_in(area_p, &band);
+}
+#endif
+
 #if LV_USE_ANIMATION
 static void edge_flash_anim(void * page, lv_anim_value_t v)
 {
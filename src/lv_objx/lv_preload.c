@@ -189,6 +189,7 @@ void lv_preload_set_type(lv_obj_t * preload, lv_preload_type_t type)
         case LV_PRELOAD_TYPE_FILLSPIN_ARC: {
             ext->anim_type = LV_PRELOAD_TYPE_FILLSPIN_ARC;
             lv_anim_t a;
+            lv_anim_init(&a);
             a.var = preload;
             if(ext->anim_dir == LV_PRELOAD_DIR_FORWARD) {
                 /* Clockwise */
@@ -210,6 +211,7 @@ void lv_preload_set_type(lv_obj_t * preload, lv_preload_type_t type)
             lv_anim_create(&a);
 
             lv_anim_t b;
+            lv_anim_init(&b);
             b.var = preload;
             if(ext->anim_dir == LV_PRELOAD_DIR_FORWARD) {
                 /* Clockwise */
@@ -236,6 +238,7 @@ void lv_preload_set_type(lv_obj_t * preload, lv_preload_type_t type)
         default: {
             ext->anim_type = type;
             lv_anim_t a;
+            lv_anim_init(&a);
             a.var = preload;
             if(ext->anim_dir == LV_PRELOAD_DIR_FORWARD) {
                 /* Clockwise */
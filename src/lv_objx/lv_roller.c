@@ -642,6 +642,8 @@ static void refr_position(lv_obj_t * roller, lv_anim_enable_t anim_en)
         inf_normalize(roller_scrl);
     }
 
+    lv_cont_layout_flush(); /*The position of the label on the scrollable is used*/
+
     int32_t id = ext->ddlist.sel_opt_id;
     lv_coord_t line_y1 =
         id * (font_h + style_label->text.line_space) + ext->ddlist.label->coords.y1 - roller_scrl->coords.y1;
@@ -652,6 +654,7 @@ static void refr_position(lv_obj_t * roller, lv_anim_enable_t anim_en)
     } else {
 #if LV_USE_ANIMATION
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = roller_scrl;
         a.start          = lv_obj_get_y(roller_scrl);
         a.end            = new_y;
@@ -685,6 +688,7 @@ static void refr_height(lv_obj_t * roller)
             obj_align = LV_ALIGN_IN_RIGHT_MID;
     }
 
+    lv_cont_layout_flush(); /*The final height of the roller is used*/
     lv_obj_set_height(lv_page_get_scrl(roller), lv_obj_get_height(ext->ddlist.label) + lv_obj_get_height(roller));
     lv_obj_align(ext->ddlist.label, NULL, obj_align, 0, 0);
 #if LV_USE_ANIMATION
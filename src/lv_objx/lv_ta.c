@@ -193,6 +193,7 @@ lv_obj_t * lv_ta_create(lv_obj_t * par, const lv_obj_t * copy)
     if(ext->cursor.blink_time) {
         /*Create a cursor blinker animation*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = new_ta;
         a.exec_cb        = (lv_anim_exec_xcb_t)cursor_blink_anim;
         a.time           = ext->cursor.blink_time;
@@ -279,6 +280,7 @@ void lv_ta_add_char(lv_obj_t * ta, uint32_t c)
 #if LV_USE_ANIMATION
         /*Auto hide characters*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = ta;
         a.exec_cb        = (lv_anim_exec_xcb_t)pwd_char_hider_anim;
         a.time           = ext->pwd_show_time;
@@ -363,6 +365,7 @@ void lv_ta_add_text(lv_obj_t * ta, const char * txt)
 #if LV_USE_ANIMATION
         /*Auto hide characters*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = ta;
         a.exec_cb        = (lv_anim_exec_xcb_t)pwd_char_hider_anim;
         a.time           = ext->pwd_show_time;
@@ -512,6 +515,7 @@ void lv_ta_set_text(lv_obj_t * ta, const char * txt)
 #if LV_USE_ANIMATION
         /*Auto hide characters*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = ta;
         a.exec_cb        = (lv_anim_exec_xcb_t)pwd_char_hider_anim;
         a.time           = ext->pwd_show_time;
@@ -627,6 +631,7 @@ void lv_ta_set_cursor_pos(lv_obj_t * ta, int16_t pos)
     if(ext->cursor.blink_time) {
         /*Reset cursor blink animation*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = ta;
         a.exec_cb        = (lv_anim_exec_xcb_t)cursor_blink_anim;
         a.time           = ext->cursor.blink_time;
@@ -933,6 +938,7 @@ void lv_ta_set_cursor_blink_time(lv_obj_t * ta, uint16_t time)
     if(ext->cursor.blink_time) {
         /*Reset cursor blink animation*/
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = ta;
         a.exec_cb        = (lv_anim_exec_xcb_t)cursor_blink_anim;
         a.time           = ext->cursor.blink_time;
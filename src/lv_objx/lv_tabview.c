@@ -389,6 +389,7 @@ void lv_tabview_set_tab_act(lv_obj_t * tabview, uint16_t id, lv_anim_enable_t an
 #if LV_USE_ANIMATION
     else {
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = ext->content;
         a.start          = lv_obj_get_x(ext->content);
         a.end            = cont_x;
@@ -441,6 +442,7 @@ void lv_tabview_set_tab_act(lv_obj_t * tabview, uint16_t id, lv_anim_enable_t an
 #if LV_USE_ANIMATION
     else {
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var = ext->indic;
 
         switch(ext->btns_pos) {
@@ -243,6 +243,7 @@ void lv_tileview_set_tile_act(lv_obj_t * tileview, lv_coord_t x, lv_coord_t y, l
         lv_coord_t y_act = lv_obj_get_y(scrl);
 
         lv_anim_t a;
+        lv_anim_init(&a);
         a.var            = scrl;
         a.exec_cb        = (lv_anim_exec_xcb_t)lv_obj_set_x;
         a.path_cb        = lv_anim_path_linear;
@@ -93,7 +93,9 @@ void lv_theme_set_current(lv_theme_t * th)
     memcpy(&current_theme.group, &th->group, sizeof(th->group));
 #endif
 
-    /*Let the object know their style might change*/
+    /*Let the object know their style might change.
+     *Refresh all objects because the theme's styles are used by the parts of the objects too
+     *(e.g. scrollbars, knobs, indicators) which are not in the style index.*/
     lv_obj_report_style_mod(NULL);
 
 #endif